@@ -16,11 +16,32 @@
 // in your data structure.  Instead, you'll need to implement your AVL tree
 // using your own dynamically-allocated nodes, with pointers connecting them,
 // and with your own balancing algorithms used.
+//
+// Rather than allocating each node separately, the nodes are kept in one
+// contiguous array (the "arena"), which doubles in size when it fills up,
+// and they refer to their children by 32-bit index into it rather than by
+// pointer.  Nodes are never removed, so a node's index is simply the order
+// in which its element was added.  This makes each node smaller (two
+// 4-byte indices and a 1-byte height, rather than two 8-byte pointers and
+// an int), packs them together in memory, and means adding an element
+// costs an allocation only when the arena grows.
+//
+// Nothing is recursive, so that a very deep tree -- which a tree without
+// balancing easily becomes -- can't overflow the call stack.  add() walks
+// down the tree in a loop, remembering the path it took, and then walks
+// back up that path rebalancing; the traversals keep their own stacks of
+// nodes, which are never deeper than the tree is tall.
 
 #ifndef AVLSET_HPP
 #define AVLSET_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
 #include "Set.hpp"
 
 
@@ -33,6 +54,8 @@ public:
     // ElementType and returns no value.
     using VisitFunction = std::function<void(const ElementType&)>;
 
+    using ElementView = typename Set<ElementType>::ElementView;
+
 public:
     // Initializes an AVLSet to be empty, with or without balancing.
     explicit AVLSet(bool shouldBalance = true);
@@ -71,6 +94,14 @@ public:
     bool contains(const ElementType& element) const override;
 
 
+    // This contains() searches for a view of an element in the same way,
+    // comparing the view with the elements directly rather than copying it.
+    bool contains(ElementView element) const override;
+
+
+    using Set<ElementType>::contains;
+
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
@@ -98,14 +129,72 @@ public:
     void postorder(VisitFunction visit) const;
 
 
+    // memoryUsage() reports the arena of nodes, each of which holds its
+    // element, as nodeBytes.  The whole arena is counted, including the
+    // part of it not yet holding nodes.
+    SetMemoryUsage memoryUsage() const override;
+
+
+private:
+    using NodeIndex = std::uint32_t;
+
+    // The index that stands for "no node," like nullptr would.
+    static constexpr NodeIndex NONE = std::numeric_limits<NodeIndex>::max();
+
+    // The arena's capacity the first time anything is added to it.
+    static constexpr NodeIndex INITIAL_CAPACITY = 16;
+
+    // A balanced tree with fewer than 2^32 nodes is never anywhere near
+    // this tall, so add() can keep its path in a fixed-size array.  (An
+    // AVL tree of height h has at least Fibonacci(h + 3) - 1 nodes.)
+    static constexpr unsigned int MAX_BALANCED_HEIGHT = 64;
+
+    // A node's height is only kept up to date when the tree is balanced,
+    // in which case it's small enough to fit in a byte; a tree without
+    // balancing only keeps track of the height of the whole tree.
+    struct Node
+    {
+        ElementType element;
+        NodeIndex left;
+        NodeIndex right;
+        std::int8_t height;
+    };
+
 private:
-    // You'll no doubt want to add member variables and "helper" member
-    // functions here.
+    bool shouldBalance;
+
+    Node* nodes;
+    NodeIndex capacity;
+    NodeIndex size_;
+    NodeIndex root;
+
+    // The height of the whole tree, used only when it isn't balanced.
+    int unbalancedHeight;
+
+private:
+    void reserve(NodeIndex newCapacity);
+    void destroyAll() noexcept;
+    NodeIndex createNode(const ElementType& element);
+
+    int heightOf(NodeIndex index) const noexcept;
+    void updateHeight(NodeIndex index) noexcept;
+    NodeIndex rotateLeft(NodeIndex index) noexcept;
+    NodeIndex rotateRight(NodeIndex index) noexcept;
+    NodeIndex rebalance(NodeIndex index) noexcept;
+
+    void addUnbalanced(const ElementType& element);
+    void addBalanced(const ElementType& element);
+
+    template <typename Key>
+    bool search(const Key& key) const;
 };
 
 
+
 template <typename ElementType>
 AVLSet<ElementType>::AVLSet(bool shouldBalance)
+    : shouldBalance{shouldBalance}, nodes{nullptr}, capacity{0}, size_{0},
+      root{NONE}, unbalancedHeight{-1}
 {
 }
 
@@ -113,24 +202,57 @@ AVLSet<ElementType>::AVLSet(bool shouldBalance)
 template <typename ElementType>
 AVLSet<ElementType>::~AVLSet() noexcept
 {
+    destroyAll();
 }
 
 
 template <typename ElementType>
 AVLSet<ElementType>::AVLSet(const AVLSet& s)
+    : shouldBalance{s.shouldBalance}, nodes{nullptr}, capacity{0}, size_{0},
+      root{s.root}, unbalancedHeight{s.unbalancedHeight}
 {
+    // Since children are referred to by index, copying the nodes in
+    // order, one for one, copies the shape of the tree along with them.
+    reserve(s.size_);
+
+    try
+    {
+        for (NodeIndex i = 0; i < s.size_; ++i)
+        {
+            new (&nodes[i]) Node{s.nodes[i]};
+            ++size_;
+        }
+    }
+    catch (...)
+    {
+        destroyAll();
+        throw;
+    }
 }
 
 
 template <typename ElementType>
 AVLSet<ElementType>::AVLSet(AVLSet&& s) noexcept
+    : shouldBalance{s.shouldBalance}, nodes{nullptr}, capacity{0}, size_{0},
+      root{NONE}, unbalancedHeight{-1}
 {
+    std::swap(nodes, s.nodes);
+    std::swap(capacity, s.capacity);
+    std::swap(size_, s.size_);
+    std::swap(root, s.root);
+    std::swap(unbalancedHeight, s.unbalancedHeight);
 }
 
 
 template <typename ElementType>
 AVLSet<ElementType>& AVLSet<ElementType>::operator=(const AVLSet& s)
 {
+    if (this != &s)
+    {
+        AVLSet copy{s};
+        *this = std::move(copy);
+    }
+
     return *this;
 }
 
@@ -138,6 +260,12 @@ AVLSet<ElementType>& AVLSet<ElementType>::operator=(const AVLSet& s)
 template <typename ElementType>
 AVLSet<ElementType>& AVLSet<ElementType>::operator=(AVLSet&& s) noexcept
 {
+    std::swap(shouldBalance, s.shouldBalance);
+    std::swap(nodes, s.nodes);
+    std::swap(capacity, s.capacity);
+    std::swap(size_, s.size_);
+    std::swap(root, s.root);
+    std::swap(unbalancedHeight, s.unbalancedHeight);
     return *this;
 }
 
@@ -145,55 +273,481 @@ AVLSet<ElementType>& AVLSet<ElementType>::operator=(AVLSet&& s) noexcept
 template <typename ElementType>
 bool AVLSet<ElementType>::isImplemented() const noexcept
 {
-    return false;
+    return true;
 }
 
 
 template <typename ElementType>
 void AVLSet<ElementType>::add(const ElementType& element)
 {
+    if (shouldBalance)
+    {
+        addBalanced(element);
+    }
+    else
+    {
+        addUnbalanced(element);
+    }
 }
 
 
 template <typename ElementType>
 bool AVLSet<ElementType>::contains(const ElementType& element) const
 {
-    return false;
+    return search(element);
+}
+
+
+template <typename ElementType>
+bool AVLSet<ElementType>::contains(ElementView element) const
+{
+    if constexpr (Set<ElementType>::HAS_ELEMENT_VIEW)
+    {
+        return search(element);
+    }
+    else
+    {
+        return false;
+    }
 }
 
 
 template <typename ElementType>
 unsigned int AVLSet<ElementType>::size() const noexcept
 {
-    return 0;
+    return size_;
 }
 
 
 template <typename ElementType>
 int AVLSet<ElementType>::height() const noexcept
 {
-    return -1;
+    return shouldBalance ? heightOf(root) : unbalancedHeight;
 }
 
 
 template <typename ElementType>
 void AVLSet<ElementType>::preorder(VisitFunction visit) const
 {
+    // The stack holds the right children still to be visited, at most
+    // one for each level of the path to the current node.
+    std::unique_ptr<NodeIndex[]> stack{new NodeIndex[height() + 1]};
+    unsigned int stackSize = 0;
+
+    NodeIndex index = root;
+
+    while (true)
+    {
+        while (index != NONE)
+        {
+            const Node& node = nodes[index];
+            visit(node.element);
+
+            if (node.right != NONE)
+            {
+                stack[stackSize++] = node.right;
+            }
+
+            index = node.left;
+        }
+
+        if (stackSize == 0)
+        {
+            break;
+        }
+
+        index = stack[--stackSize];
+    }
 }
 
 
 template <typename ElementType>
 void AVLSet<ElementType>::inorder(VisitFunction visit) const
 {
+    // The stack holds the nodes on the path to the current one whose
+    // left subtrees are being visited.
+    std::unique_ptr<NodeIndex[]> stack{new NodeIndex[height() + 1]};
+    unsigned int stackSize = 0;
+
+    NodeIndex index = root;
+
+    while (index != NONE || stackSize > 0)
+    {
+        while (index != NONE)
+        {
+            stack[stackSize++] = index;
+            index = nodes[index].left;
+        }
+
+        index = stack[--stackSize];
+        visit(nodes[index].element);
+        index = nodes[index].right;
+    }
 }
 
 
 template <typename ElementType>
 void AVLSet<ElementType>::postorder(VisitFunction visit) const
 {
+    // The stack holds the path to the current node.  A node is visited
+    // once its right subtree is empty or has just been visited.
+    std::unique_ptr<NodeIndex[]> stack{new NodeIndex[height() + 1]};
+    unsigned int stackSize = 0;
+
+    NodeIndex index = root;
+    NodeIndex lastVisited = NONE;
+
+    while (index != NONE || stackSize > 0)
+    {
+        while (index != NONE)
+        {
+            stack[stackSize++] = index;
+            index = nodes[index].left;
+        }
+
+        const Node& top = nodes[stack[stackSize - 1]];
+
+        if (top.right != NONE && top.right != lastVisited)
+        {
+            index = top.right;
+        }
+        else
+        {
+            lastVisited = stack[--stackSize];
+            visit(top.element);
+        }
+    }
 }
 
 
+template <typename ElementType>
+SetMemoryUsage AVLSet<ElementType>::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+    usage.nodeBytes = static_cast<std::size_t>(capacity) * sizeof(Node);
+
+    for (NodeIndex i = 0; i < size_; ++i)
+    {
+        usage.keyBytes += elementHeapBytes(nodes[i].element);
+    }
+
+    return usage;
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::reserve(NodeIndex newCapacity)
+{
+    if (newCapacity <= capacity)
+    {
+        return;
+    }
+
+    Node* newNodes = static_cast<Node*>(
+        ::operator new(newCapacity * sizeof(Node), std::align_val_t{alignof(Node)}));
+
+    for (NodeIndex i = 0; i < size_; ++i)
+    {
+        new (&newNodes[i]) Node{std::move(nodes[i])};
+        nodes[i].~Node();
+    }
+
+    if (nodes != nullptr)
+    {
+        ::operator delete(nodes, std::align_val_t{alignof(Node)});
+    }
+
+    nodes = newNodes;
+    capacity = newCapacity;
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::destroyAll() noexcept
+{
+    if (nodes == nullptr)
+    {
+        return;
+    }
+
+    for (NodeIndex i = 0; i < size_; ++i)
+    {
+        nodes[i].~Node();
+    }
+
+    ::operator delete(nodes, std::align_val_t{alignof(Node)});
+
+    nodes = nullptr;
+    capacity = 0;
+    size_ = 0;
+    root = NONE;
+    unbalancedHeight = -1;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::NodeIndex AVLSet<ElementType>::createNode(const ElementType& element)
+{
+    if (size_ == capacity)
+    {
+        if (capacity == NONE)
+        {
+            throw std::bad_alloc{};
+        }
+
+        reserve(
+            capacity == 0 ? INITIAL_CAPACITY
+            : capacity > NONE / 2 ? NONE
+            : capacity * 2);
+    }
+
+    new (&nodes[size_]) Node{element, NONE, NONE, 0};
+    return size_++;
+}
+
+
+template <typename ElementType>
+int AVLSet<ElementType>::heightOf(NodeIndex index) const noexcept
+{
+    return index == NONE ? -1 : nodes[index].height;
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::updateHeight(NodeIndex index) noexcept
+{
+    Node& node = nodes[index];
+    node.height = static_cast<std::int8_t>(1 + std::max(heightOf(node.left), heightOf(node.right)));
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::NodeIndex AVLSet<ElementType>::rotateLeft(NodeIndex index) noexcept
+{
+    NodeIndex newTop = nodes[index].right;
+
+    nodes[index].right = nodes[newTop].left;
+    nodes[newTop].left = index;
+
+    updateHeight(index);
+    updateHeight(newTop);
+
+    return newTop;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::NodeIndex AVLSet<ElementType>::rotateRight(NodeIndex index) noexcept
+{
+    NodeIndex newTop = nodes[index].left;
+
+    nodes[index].left = nodes[newTop].right;
+    nodes[newTop].right = index;
+
+    updateHeight(index);
+    updateHeight(newTop);
+
+    return newTop;
+}
 
-#endif // AVLSET_HPP
 
+template <typename ElementType>
+typename AVLSet<ElementType>::NodeIndex AVLSet<ElementType>::rebalance(NodeIndex index) noexcept
+{
+    // Returns the index of whichever node is at the top of the subtree
+    // after it's been rebalanced, with the subtree's heights up to date.
+    updateHeight(index);
+
+    Node& node = nodes[index];
+    int balance = heightOf(node.left) - heightOf(node.right);
+
+    if (balance > 1)
+    {
+        const Node& left = nodes[node.left];
+
+        if (heightOf(left.left) < heightOf(left.right))
+        {
+            node.left = rotateLeft(node.left);
+        }
+
+        return rotateRight(index);
+    }
+    else if (balance < -1)
+    {
+        const Node& right = nodes[node.right];
+
+        if (heightOf(right.right) < heightOf(right.left))
+        {
+            node.right = rotateRight(node.right);
+        }
+
+        return rotateLeft(index);
+    }
+    else
+    {
+        return index;
+    }
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::addUnbalanced(const ElementType& element)
+{
+    // Without balancing, nothing above the new node changes except the
+    // one link to it, so there's no need to remember the path.
+    NodeIndex parent = NONE;
+    NodeIndex index = root;
+    int depth = 0;
+
+    while (index != NONE)
+    {
+        const Node& node = nodes[index];
+
+        if (element < node.element)
+        {
+            parent = index;
+            index = node.left;
+        }
+        else if (node.element < element)
+        {
+            parent = index;
+            index = node.right;
+        }
+        else
+        {
+            return;
+        }
+
+        ++depth;
+    }
+
+    NodeIndex newIndex = createNode(element);
+
+    if (parent == NONE)
+    {
+        root = newIndex;
+    }
+    else if (element < nodes[parent].element)
+    {
+        nodes[parent].left = newIndex;
+    }
+    else
+    {
+        nodes[parent].right = newIndex;
+    }
+
+    unbalancedHeight = std::max(unbalancedHeight, depth);
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::addBalanced(const ElementType& element)
+{
+    NodeIndex path[MAX_BALANCED_HEIGHT + 1];
+    unsigned int pathLength = 0;
+
+    for (NodeIndex index = root; index != NONE; )
+    {
+        const Node& node = nodes[index];
+        path[pathLength++] = index;
+
+        if (element < node.element)
+        {
+            index = node.left;
+        }
+        else if (node.element < element)
+        {
+            index = node.right;
+        }
+        else
+        {
+            return;
+        }
+    }
+
+    // Creating the node may move the arena, so no references into it are
+    // held across this call; the path is made of indices, which don't
+    // change.
+    NodeIndex newIndex = createNode(element);
+
+    if (pathLength == 0)
+    {
+        root = newIndex;
+        return;
+    }
+
+    NodeIndex parent = path[pathLength - 1];
+
+    if (element < nodes[parent].element)
+    {
+        nodes[parent].left = newIndex;
+    }
+    else
+    {
+        nodes[parent].right = newIndex;
+    }
+
+    // Walk back up the path, rebalancing each subtree and linking it back
+    // into its parent, until reaching one whose height didn't change,
+    // since nothing above that one can have changed, either.
+    for (unsigned int i = pathLength; i-- > 0; )
+    {
+        NodeIndex index = path[i];
+        int oldHeight = nodes[index].height;
+        NodeIndex newTop = rebalance(index);
+
+        if (newTop != index)
+        {
+            if (i == 0)
+            {
+                root = newTop;
+            }
+            else if (nodes[path[i - 1]].left == index)
+            {
+                nodes[path[i - 1]].left = newTop;
+            }
+            else
+            {
+                nodes[path[i - 1]].right = newTop;
+            }
+        }
+
+        if (nodes[newTop].height == oldHeight)
+        {
+            break;
+        }
+    }
+}
+
+
+template <typename ElementType>
+template <typename Key>
+bool AVLSet<ElementType>::search(const Key& key) const
+{
+    NodeIndex index = root;
+
+    while (index != NONE)
+    {
+        const Node& node = nodes[index];
+
+        if (key < node.element)
+        {
+            index = node.left;
+        }
+        else if (node.element < key)
+        {
+            index = node.right;
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+
+#endif // AVLSET_HPP
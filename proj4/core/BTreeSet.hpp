@@ -0,0 +1,867 @@
+// BTreeSet.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A BTreeSet is an implementation of a Set that is a B+-tree: a search tree
+// in which every node holds up to NODE_CAPACITY sorted keys, so the tree is
+// only about log16(n) levels deep.  All of the elements are stored in the
+// leaves, which are linked together in ascending order; the keys in the
+// internal nodes ("branches") are copies of elements that only steer the
+// search.  A branch with k keys has k + 1 children, and its key i is the
+// smallest element anywhere below child i + 1.  Nodes are split in half
+// when they overflow, so every node but the root is at least half full --
+// with one exception.  When a node along the right edge of the tree
+// overflows because an element is being added to its end, it stays full
+// and the new node to its right starts with just that element, so adding
+// elements in ascending order (e.g., from a sorted word file) fills the
+// nodes completely, rather than leaving every one of them half empty.
+// Only the nodes along the right edge can be less than half full.
+//
+// A binary search tree visits one node -- and, typically, misses the cache
+// once -- for every comparison it makes.  A BTreeSet is laid out so that
+// each node costs about one cache miss instead.  Alongside its keys, every
+// node keeps a 32-bit, order-preserving "prefix" of each key (for strings,
+// the first four characters), and those prefixes fill exactly one 64-byte,
+// cache-line-aligned array.  Searching within a node compares the prefix of
+// the element being searched for against all of the node's prefixes at
+// once -- using SSE2 instructions, when they're available, and a simple
+// loop otherwise -- which narrows the search down to the keys that share
+// its prefix.  Only those keys (usually none or one) are compared in full.
+//
+// BTreeKeyPrefix decides what a key's prefix is.  It's specialized for
+// std::string and the integral types; for any other type, every prefix is
+// 0, so searches still work, but compare keys in full within each node.
+
+#ifndef BTREESET_HPP
+#define BTREESET_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <new>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "Set.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+
+// A BTreeKeyPrefix maps each key to a 32-bit prefix, in a way that
+// preserves order: if a < b, then of(a) <= of(b).
+
+template <typename ElementType, typename Enable = void>
+struct BTreeKeyPrefix
+{
+    static std::uint32_t of(const ElementType& element) noexcept
+    {
+        return 0;
+    }
+};
+
+
+template <typename ElementType>
+struct BTreeKeyPrefix<
+    ElementType,
+    std::enable_if_t<std::is_integral_v<ElementType> && !std::is_same_v<ElementType, bool>>>
+{
+    static std::uint32_t of(const ElementType& element) noexcept
+    {
+        using UnsignedType = std::make_unsigned_t<ElementType>;
+        constexpr unsigned int bits = std::numeric_limits<UnsignedType>::digits;
+
+        // Flipping the sign bit of a signed value makes its ordering agree
+        // with the ordering of the unsigned value with the same bits; larger
+        // values than 32 bits contribute only their highest 32 bits.
+        UnsignedType value = static_cast<UnsignedType>(element);
+
+        if constexpr (std::is_signed_v<ElementType>)
+        {
+            value ^= UnsignedType{1} << (bits - 1);
+        }
+
+        if constexpr (bits > 32)
+        {
+            return static_cast<std::uint32_t>(value >> (bits - 32));
+        }
+        else
+        {
+            return static_cast<std::uint32_t>(value);
+        }
+    }
+};
+
+
+template <>
+struct BTreeKeyPrefix<std::string>
+{
+    static std::uint32_t of(const std::string& element) noexcept
+    {
+        // The first four characters, as unsigned values (which is how
+        // std::string compares them), with missing ones counted as 0.
+        std::uint32_t prefix = 0;
+
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            prefix <<= 8;
+
+            if (i < element.size())
+            {
+                prefix |= static_cast<unsigned char>(element[i]);
+            }
+        }
+
+        return prefix;
+    }
+};
+
+
+
+template <typename ElementType>
+class BTreeSet : public Set<ElementType>
+{
+public:
+    // The most keys a node can hold.  Their prefixes fill one cache line.
+    static constexpr unsigned int NODE_CAPACITY = 16;
+
+    // A VisitFunction is a function that takes a reference to a const
+    // ElementType and returns no value.
+    using VisitFunction = std::function<void(const ElementType&)>;
+
+public:
+    // Initializes a BTreeSet to be empty.
+    BTreeSet();
+
+    // Cleans up the BTreeSet so that it leaks no memory.
+    ~BTreeSet() noexcept override;
+
+    // Initializes a new BTreeSet to be a copy of an existing one.
+    BTreeSet(const BTreeSet& s);
+
+    // Initializes a new BTreeSet whose contents are moved from an
+    // expiring one.
+    BTreeSet(BTreeSet&& s) noexcept;
+
+    // Assigns an existing BTreeSet into another.
+    BTreeSet& operator=(const BTreeSet& s);
+
+    // Assigns an expiring BTreeSet into another.
+    BTreeSet& operator=(BTreeSet&& s) noexcept;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  This function always runs in
+    // O(log n) time when there are n elements in the B-tree.
+    void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  This function always runs in O(log n) time when
+    // there are n elements in the B-tree.
+    bool contains(const ElementType& element) const override;
+
+
+    using Set<ElementType>::contains;
+
+
+    // size() returns the number of elements in the set.
+    unsigned int size() const noexcept override;
+
+
+    // height() returns the height of the B-tree, which is 0 when the root
+    // is a leaf.  As with AVLSet, the height of an empty tree is -1.
+    int height() const noexcept;
+
+
+    // inorder() calls the given "visit" function for each of the elements
+    // in the set, in ascending order, by following the chain of leaves.
+    void inorder(VisitFunction visit) const;
+
+
+    // memoryUsage() reports the tree's nodes, both leaves and branches,
+    // as nodeBytes.  The keys are stored inside the nodes, but any memory
+    // they've allocated for themselves -- including that of the copies
+    // kept in branches -- is counted as keyBytes.
+    SetMemoryUsage memoryUsage() const override;
+
+
+private:
+    // Every node begins with its prefixes, so they start on a cache line
+    // boundary, followed by its keys, which are only constructed in the
+    // first count slots.
+    struct Node
+    {
+        alignas(64) std::uint32_t prefixes[NODE_CAPACITY];
+        unsigned int count;
+        bool isLeaf;
+        alignas(ElementType) unsigned char keyStorage[NODE_CAPACITY * sizeof(ElementType)];
+
+        explicit Node(bool isLeaf) noexcept;
+
+        ElementType* keys() noexcept;
+        const ElementType* keys() const noexcept;
+    };
+
+    struct Leaf : Node
+    {
+        Leaf* nextLeaf;
+
+        Leaf() noexcept;
+    };
+
+    struct Branch : Node
+    {
+        Node* children[NODE_CAPACITY + 1];
+
+        Branch() noexcept;
+    };
+
+    // When adding an element causes a node to split, the new node holding
+    // the upper half of its keys is passed up to its parent along with
+    // the key that separates the two halves.
+    struct Split
+    {
+        Node* right;
+        ElementType separator;
+    };
+
+private:
+    Node* root;
+    Leaf* firstLeaf;
+    unsigned int size_;
+    int height_;
+
+private:
+    static void destroyNode(Node* node) noexcept;
+    static void destroySubtree(Node* node) noexcept;
+    Node* copySubtree(const Node* node, Leaf*& lastLeaf);
+
+    static std::pair<unsigned int, unsigned int> prefixRange(
+        const Node* node, std::uint32_t prefix) noexcept;
+
+    static unsigned int lowerBoundIn(const Node* node, const ElementType& element);
+    static unsigned int upperBoundIn(const Node* node, const ElementType& element);
+
+    static void insertKey(Node* node, unsigned int position, const ElementType& element);
+    static void moveKeys(Node* from, unsigned int first, Node* to);
+
+    std::optional<Split> insertInto(
+        Node* node, const ElementType& element, bool rightmost, bool& added);
+
+    std::optional<Split> insertIntoLeaf(
+        Leaf* leaf, const ElementType& element, bool rightmost, bool& added);
+
+    std::optional<Split> insertIntoBranch(
+        Branch* branch, const ElementType& element, bool rightmost, bool& added);
+
+    void measure(const Node* node, SetMemoryUsage& usage) const;
+};
+
+
+
+template <typename ElementType>
+BTreeSet<ElementType>::Node::Node(bool isLeaf) noexcept
+    : prefixes{}, count{0}, isLeaf{isLeaf}
+{
+}
+
+
+template <typename ElementType>
+ElementType* BTreeSet<ElementType>::Node::keys() noexcept
+{
+    return reinterpret_cast<ElementType*>(keyStorage);
+}
+
+
+template <typename ElementType>
+const ElementType* BTreeSet<ElementType>::Node::keys() const noexcept
+{
+    return reinterpret_cast<const ElementType*>(keyStorage);
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>::Leaf::Leaf() noexcept
+    : Node{true}, nextLeaf{nullptr}
+{
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>::Branch::Branch() noexcept
+    : Node{false}
+{
+}
+
+
+
+template <typename ElementType>
+BTreeSet<ElementType>::BTreeSet()
+    : root{nullptr}, firstLeaf{nullptr}, size_{0}, height_{-1}
+{
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>::~BTreeSet() noexcept
+{
+    destroySubtree(root);
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>::BTreeSet(const BTreeSet& s)
+    : root{nullptr}, firstLeaf{nullptr}, size_{0}, height_{-1}
+{
+    if (s.root != nullptr)
+    {
+        Leaf* lastLeaf = nullptr;
+        root = copySubtree(s.root, lastLeaf);
+        size_ = s.size_;
+        height_ = s.height_;
+    }
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>::BTreeSet(BTreeSet&& s) noexcept
+    : root{nullptr}, firstLeaf{nullptr}, size_{0}, height_{-1}
+{
+    std::swap(root, s.root);
+    std::swap(firstLeaf, s.firstLeaf);
+    std::swap(size_, s.size_);
+    std::swap(height_, s.height_);
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>& BTreeSet<ElementType>::operator=(const BTreeSet& s)
+{
+    if (this != &s)
+    {
+        BTreeSet copy{s};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>& BTreeSet<ElementType>::operator=(BTreeSet&& s) noexcept
+{
+    std::swap(root, s.root);
+    std::swap(firstLeaf, s.firstLeaf);
+    std::swap(size_, s.size_);
+    std::swap(height_, s.height_);
+    return *this;
+}
+
+
+template <typename ElementType>
+bool BTreeSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::add(const ElementType& element)
+{
+    if (root == nullptr)
+    {
+        Leaf* leaf = new Leaf;
+        root = leaf;
+        firstLeaf = leaf;
+        height_ = 0;
+    }
+
+    bool added = false;
+    std::optional<Split> split = insertInto(root, element, true, added);
+
+    // When the root splits, the tree grows one level taller, with a new
+    // root above the two halves.
+    if (split)
+    {
+        Branch* newRoot = new Branch;
+        newRoot->children[0] = root;
+        newRoot->children[1] = split->right;
+        insertKey(newRoot, 0, split->separator);
+
+        root = newRoot;
+        ++height_;
+    }
+
+    if (added)
+    {
+        ++size_;
+    }
+}
+
+
+template <typename ElementType>
+bool BTreeSet<ElementType>::contains(const ElementType& element) const
+{
+    if (root == nullptr)
+    {
+        return false;
+    }
+
+    const Node* node = root;
+
+    while (!node->isLeaf)
+    {
+        node = static_cast<const Branch*>(node)->children[upperBoundIn(node, element)];
+    }
+
+    unsigned int position = lowerBoundIn(node, element);
+    return position < node->count && node->keys()[position] == element;
+}
+
+
+template <typename ElementType>
+unsigned int BTreeSet<ElementType>::size() const noexcept
+{
+    return size_;
+}
+
+
+template <typename ElementType>
+int BTreeSet<ElementType>::height() const noexcept
+{
+    return height_;
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::inorder(VisitFunction visit) const
+{
+    for (const Leaf* leaf = firstLeaf; leaf != nullptr; leaf = leaf->nextLeaf)
+    {
+        for (unsigned int i = 0; i < leaf->count; ++i)
+        {
+            visit(leaf->keys()[i]);
+        }
+    }
+}
+
+
+template <typename ElementType>
+SetMemoryUsage BTreeSet<ElementType>::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+
+    if (root != nullptr)
+    {
+        measure(root, usage);
+    }
+
+    return usage;
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::destroyNode(Node* node) noexcept
+{
+    for (unsigned int i = 0; i < node->count; ++i)
+    {
+        node->keys()[i].~ElementType();
+    }
+
+    if (node->isLeaf)
+    {
+        delete static_cast<Leaf*>(node);
+    }
+    else
+    {
+        delete static_cast<Branch*>(node);
+    }
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::destroySubtree(Node* node) noexcept
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+
+    if (!node->isLeaf)
+    {
+        Branch* branch = static_cast<Branch*>(node);
+
+        for (unsigned int i = 0; i <= branch->count; ++i)
+        {
+            destroySubtree(branch->children[i]);
+        }
+    }
+
+    destroyNode(node);
+}
+
+
+template <typename ElementType>
+typename BTreeSet<ElementType>::Node* BTreeSet<ElementType>::copySubtree(
+    const Node* node, Leaf*& lastLeaf)
+{
+    // The leaves are copied from left to right, so each one is linked
+    // after the one copied before it.
+    if (node->isLeaf)
+    {
+        Leaf* leaf = new Leaf;
+
+        try
+        {
+            for (unsigned int i = 0; i < node->count; ++i)
+            {
+                insertKey(leaf, i, node->keys()[i]);
+            }
+        }
+        catch (...)
+        {
+            destroyNode(leaf);
+            throw;
+        }
+
+        if (lastLeaf == nullptr)
+        {
+            firstLeaf = leaf;
+        }
+        else
+        {
+            lastLeaf->nextLeaf = leaf;
+        }
+
+        lastLeaf = leaf;
+        return leaf;
+    }
+
+    const Branch* source = static_cast<const Branch*>(node);
+    Branch* branch = new Branch;
+    std::fill(branch->children, branch->children + NODE_CAPACITY + 1, nullptr);
+
+    try
+    {
+        for (unsigned int i = 0; i < source->count; ++i)
+        {
+            insertKey(branch, i, source->keys()[i]);
+        }
+
+        for (unsigned int i = 0; i <= source->count; ++i)
+        {
+            branch->children[i] = copySubtree(source->children[i], lastLeaf);
+        }
+    }
+    catch (...)
+    {
+        for (unsigned int i = 0; i <= branch->count; ++i)
+        {
+            destroySubtree(branch->children[i]);
+        }
+
+        destroyNode(branch);
+        throw;
+    }
+
+    return branch;
+}
+
+
+template <typename ElementType>
+std::pair<unsigned int, unsigned int> BTreeSet<ElementType>::prefixRange(
+    const Node* node, std::uint32_t prefix) noexcept
+{
+    // Returns how many of the node's keys have prefixes less than the given
+    // one, and how many have prefixes no greater than it.  Since the keys
+    // are sorted, so are their prefixes, so those are the bounds of the
+    // keys that share the given prefix.
+#if defined(__SSE2__)
+    // SSE2 only compares signed integers, so the sign bit of every prefix
+    // is flipped first, which makes signed comparisons order them the way
+    // unsigned comparisons would.
+    const __m128i signBit = _mm_set1_epi32(std::numeric_limits<int>::min());
+    const __m128i target = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(prefix)), signBit);
+
+    unsigned int lessMask = 0;
+    unsigned int greaterMask = 0;
+
+    for (unsigned int i = 0; i < NODE_CAPACITY; i += 4)
+    {
+        __m128i prefixes = _mm_xor_si128(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(node->prefixes + i)), signBit);
+
+        lessMask |= static_cast<unsigned int>(
+            _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(prefixes, target)))) << i;
+
+        greaterMask |= static_cast<unsigned int>(
+            _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(prefixes, target)))) << i;
+    }
+
+    // Only the first count slots hold keys.
+    unsigned int usedMask = (1u << node->count) - 1;
+    lessMask &= usedMask;
+    greaterMask &= usedMask;
+
+    unsigned int less = 0;
+    unsigned int greater = 0;
+
+    for (; lessMask != 0; lessMask &= lessMask - 1)
+    {
+        ++less;
+    }
+
+    for (; greaterMask != 0; greaterMask &= greaterMask - 1)
+    {
+        ++greater;
+    }
+
+    return {less, node->count - greater};
+#else
+    unsigned int less = 0;
+    unsigned int notGreater = 0;
+
+    for (unsigned int i = 0; i < node->count; ++i)
+    {
+        less += node->prefixes[i] < prefix;
+        notGreater += node->prefixes[i] <= prefix;
+    }
+
+    return {less, notGreater};
+#endif
+}
+
+
+template <typename ElementType>
+unsigned int BTreeSet<ElementType>::lowerBoundIn(const Node* node, const ElementType& element)
+{
+    // The position of the first key in the node that isn't less than the
+    // given element.
+    auto [first, last] = prefixRange(node, BTreeKeyPrefix<ElementType>::of(element));
+    const ElementType* keys = node->keys();
+
+    return std::lower_bound(keys + first, keys + last, element) - keys;
+}
+
+
+template <typename ElementType>
+unsigned int BTreeSet<ElementType>::upperBoundIn(const Node* node, const ElementType& element)
+{
+    // The position of the first key in the node that's greater than the
+    // given element, which, in a branch, is the child to search next.
+    auto [first, last] = prefixRange(node, BTreeKeyPrefix<ElementType>::of(element));
+    const ElementType* keys = node->keys();
+
+    return std::upper_bound(keys + first, keys + last, element) - keys;
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::insertKey(Node* node, unsigned int position, const ElementType& element)
+{
+    // Inserts a copy of the element before the given position in a node
+    // that isn't full, shifting the keys after it one slot to the right.
+    ElementType* keys = node->keys();
+
+    if (position == node->count)
+    {
+        new (&keys[position]) ElementType{element};
+    }
+    else
+    {
+        new (&keys[node->count]) ElementType{std::move(keys[node->count - 1])};
+        std::move_backward(keys + position, keys + node->count - 1, keys + node->count);
+        keys[position] = element;
+
+        std::copy_backward(
+            node->prefixes + position, node->prefixes + node->count,
+            node->prefixes + node->count + 1);
+    }
+
+    node->prefixes[position] = BTreeKeyPrefix<ElementType>::of(element);
+    ++node->count;
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::moveKeys(Node* from, unsigned int first, Node* to)
+{
+    // Moves the keys of one node, from the given position on, to the end
+    // of another (which has room for them).
+    for (unsigned int i = first; i < from->count; ++i)
+    {
+        new (&to->keys()[to->count]) ElementType{std::move(from->keys()[i])};
+        to->prefixes[to->count] = from->prefixes[i];
+        ++to->count;
+
+        from->keys()[i].~ElementType();
+    }
+
+    from->count = first;
+}
+
+
+template <typename ElementType>
+std::optional<typename BTreeSet<ElementType>::Split> BTreeSet<ElementType>::insertInto(
+    Node* node, const ElementType& element, bool rightmost, bool& added)
+{
+    if (node->isLeaf)
+    {
+        return insertIntoLeaf(static_cast<Leaf*>(node), element, rightmost, added);
+    }
+    else
+    {
+        return insertIntoBranch(static_cast<Branch*>(node), element, rightmost, added);
+    }
+}
+
+
+template <typename ElementType>
+std::optional<typename BTreeSet<ElementType>::Split> BTreeSet<ElementType>::insertIntoLeaf(
+    Leaf* leaf, const ElementType& element, bool rightmost, bool& added)
+{
+    unsigned int position = lowerBoundIn(leaf, element);
+
+    if (position < leaf->count && leaf->keys()[position] == element)
+    {
+        return std::nullopt;
+    }
+
+    added = true;
+
+    if (leaf->count < NODE_CAPACITY)
+    {
+        insertKey(leaf, position, element);
+        return std::nullopt;
+    }
+
+    // A full leaf is split in half, and the element goes into whichever
+    // half it belongs in.  The smallest element in the new right half
+    // separates the two.  (When the element goes after everything in the
+    // rightmost leaf, the new leaf gets only the element instead.)
+    unsigned int half = rightmost && position == NODE_CAPACITY ? NODE_CAPACITY : NODE_CAPACITY / 2;
+
+    Leaf* right = new Leaf;
+    moveKeys(leaf, half, right);
+
+    right->nextLeaf = leaf->nextLeaf;
+    leaf->nextLeaf = right;
+
+    if (position < half)
+    {
+        insertKey(leaf, position, element);
+    }
+    else
+    {
+        insertKey(right, position - half, element);
+    }
+
+    return Split{right, right->keys()[0]};
+}
+
+
+template <typename ElementType>
+std::optional<typename BTreeSet<ElementType>::Split> BTreeSet<ElementType>::insertIntoBranch(
+    Branch* branch, const ElementType& element, bool rightmost, bool& added)
+{
+    unsigned int childIndex = upperBoundIn(branch, element);
+
+    std::optional<Split> childSplit = insertInto(
+        branch->children[childIndex], element,
+        rightmost && childIndex == branch->count, added);
+
+    if (!childSplit)
+    {
+        return std::nullopt;
+    }
+
+    // The child's new right half goes just after it, with the separator
+    // just before that.
+    auto insertChild =
+        [&childSplit](Branch* target, unsigned int position)
+        {
+            std::copy_backward(
+                target->children + position + 1, target->children + target->count + 1,
+                target->children + target->count + 2);
+
+            target->children[position + 1] = childSplit->right;
+            insertKey(target, position, childSplit->separator);
+        };
+
+    if (branch->count < NODE_CAPACITY)
+    {
+        insertChild(branch, childIndex);
+        return std::nullopt;
+    }
+
+    // A full branch is split around its middle key, which moves up to the
+    // parent rather than staying in either half.  The left half keeps the
+    // keys before it, and the right half takes the keys after it, along
+    // with the children on either side of those.  (When the new child goes
+    // after all the others in the rightmost branch, the last key moves up
+    // instead, so the new branch gets only its last child and the new one.)
+    unsigned int middle =
+        rightmost && childIndex == NODE_CAPACITY ? NODE_CAPACITY - 1 : NODE_CAPACITY / 2;
+
+    Branch* right = new Branch;
+    moveKeys(branch, middle + 1, right);
+
+    std::copy(
+        branch->children + middle + 1, branch->children + NODE_CAPACITY + 1,
+        right->children);
+
+    Split split{right, std::move(branch->keys()[middle])};
+    branch->keys()[middle].~ElementType();
+    branch->count = middle;
+
+    if (childIndex <= middle)
+    {
+        insertChild(branch, childIndex);
+    }
+    else
+    {
+        insertChild(right, childIndex - middle - 1);
+    }
+
+    return split;
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::measure(const Node* node, SetMemoryUsage& usage) const
+{
+    for (unsigned int i = 0; i < node->count; ++i)
+    {
+        usage.keyBytes += elementHeapBytes(node->keys()[i]);
+    }
+
+    if (node->isLeaf)
+    {
+        usage.nodeBytes += sizeof(Leaf);
+    }
+    else
+    {
+        const Branch* branch = static_cast<const Branch*>(node);
+        usage.nodeBytes += sizeof(Branch);
+
+        for (unsigned int i = 0; i <= branch->count; ++i)
+        {
+            measure(branch->children[i], usage);
+        }
+    }
+}
+
+
+
+#endif // BTREESET_HPP
+
@@ -0,0 +1,365 @@
+// ConcurrentHashSet.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A ConcurrentHashSet is an implementation of a Set that can safely be
+// shared between threads: any number of threads can call contains() while
+// others call add().  It's a separately-chained hash table, just like
+// HashSet, except that it's split into a fixed number of independent
+// "shards," each with its own array of linked lists and its own
+// reader/writer lock.  An element's hash decides which shard it lives in,
+// so threads working on different shards never contend with one another,
+// and threads that are only reading a shard never block each other.
+//
+// Each shard grows on its own, using the same rule as HashSet: when the
+// ratio of its size to its capacity would exceed 0.8, its capacity becomes
+// capacity * 2 + 1.  Only that shard is locked while it's being resized.
+//
+// Copying or moving a set that other threads might be using at the same
+// time doesn't have a sensible meaning, so a ConcurrentHashSet can be
+// neither copied nor moved.
+
+#ifndef CONCURRENTHASHSET_HPP
+#define CONCURRENTHASHSET_HPP
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include "Set.hpp"
+
+
+
+template <typename ElementType>
+class ConcurrentHashSet : public Set<ElementType>
+{
+public:
+    // The default number of shards, which is rounded up to a power of two
+    // if some other number is asked for.  It's worth having comfortably
+    // more shards than threads, so that two threads rarely want the same
+    // one at the same time.
+    static constexpr unsigned int DEFAULT_SHARD_COUNT = 64;
+
+    // The capacity of each shard before anything has been added to it.
+    static constexpr unsigned int DEFAULT_CAPACITY = 10;
+
+    // A HashFunction is a function that takes a reference to a const
+    // ElementType and returns an unsigned int.  It will be called from
+    // many threads at once, so it must not modify any shared state.
+    using HashFunction = std::function<unsigned int(const ElementType&)>;
+
+public:
+    // Initializes a ConcurrentHashSet to be empty, so that it will use the
+    // given hash function whenever it needs to hash an element.
+    explicit ConcurrentHashSet(
+        HashFunction hashFunction, unsigned int shardCount = DEFAULT_SHARD_COUNT);
+
+    // Cleans up the ConcurrentHashSet so that it leaks no memory.  No
+    // other thread may be using the set when it's destroyed.
+    ~ConcurrentHashSet() noexcept override;
+
+    ConcurrentHashSet(const ConcurrentHashSet& s) = delete;
+    ConcurrentHashSet(ConcurrentHashSet&& s) = delete;
+    ConcurrentHashSet& operator=(const ConcurrentHashSet& s) = delete;
+    ConcurrentHashSet& operator=(ConcurrentHashSet&& s) = delete;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  Only the shard that the element
+    // hashes to is locked (exclusively) while this function runs.
+    void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  Only the shard that the element hashes to is
+    // locked, and only for reading, so any number of calls to contains()
+    // can run at the same time.
+    bool contains(const ElementType& element) const override;
+
+
+    using Set<ElementType>::contains;
+
+
+    // size() returns the number of elements in the set.  While other
+    // threads are adding elements, this is a snapshot that may already
+    // be out of date by the time it's returned.
+    unsigned int size() const noexcept override;
+
+
+    // shardCount() returns the number of shards.
+    unsigned int shardCount() const noexcept;
+
+
+    // elementsInShard() returns the number of elements stored in the
+    // given shard.  If the shard doesn't exist, this function returns 0.
+    unsigned int elementsInShard(unsigned int shard) const;
+
+
+    // memoryUsage() reports the shards and their bucket arrays as
+    // bucketBytes and the linked list nodes as nodeBytes.  Each shard is
+    // locked (for reading) while it's being measured.
+    SetMemoryUsage memoryUsage() const override;
+
+
+private:
+    struct Node
+    {
+        ElementType element;
+        Node* next;
+    };
+
+    // Each shard sits on its own cache line(s), so that the locks of two
+    // neighboring shards don't ping-pong one cache line between cores.
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mutex;
+        Node** buckets = nullptr;
+        unsigned int capacity = 0;
+        unsigned int size = 0;
+    };
+
+    HashFunction hashFunction;
+    unsigned int shardBits;
+    std::vector<Shard> shards;
+    std::atomic<unsigned int> totalSize;
+
+private:
+    unsigned int shardIndex(unsigned int hash) const noexcept;
+    static bool bucketContains(const Node* node, const ElementType& element);
+    void rehash(Shard& shard, unsigned int newCapacity);
+    static void destroyAll(Node* node) noexcept;
+};
+
+
+
+template <typename ElementType>
+ConcurrentHashSet<ElementType>::ConcurrentHashSet(
+    HashFunction hashFunction, unsigned int shardCount)
+    : hashFunction{hashFunction}, shardBits{0}, shards{}, totalSize{0}
+{
+    while ((1u << shardBits) < shardCount && shardBits < 16)
+    {
+        ++shardBits;
+    }
+
+    // Shards can't be moved (a shared_mutex can't be), so the vector
+    // is never resized after this.
+    shards = std::vector<Shard>(1u << shardBits);
+
+    try
+    {
+        for (unsigned int i = 0; i < (1u << shardBits); ++i)
+        {
+            shards[i].buckets = new Node*[DEFAULT_CAPACITY]{};
+            shards[i].capacity = DEFAULT_CAPACITY;
+        }
+    }
+    catch (...)
+    {
+        // The destructor won't run, so the shards whose buckets were
+        // allocated before one failed are cleaned up here.  The others'
+        // buckets are still nullptr, which delete[] ignores.
+        for (Shard& shard : shards)
+        {
+            delete[] shard.buckets;
+        }
+
+        throw;
+    }
+}
+
+
+template <typename ElementType>
+ConcurrentHashSet<ElementType>::~ConcurrentHashSet() noexcept
+{
+    for (unsigned int i = 0; i < (1u << shardBits); ++i)
+    {
+        for (unsigned int j = 0; j < shards[i].capacity; ++j)
+        {
+            destroyAll(shards[i].buckets[j]);
+        }
+
+        delete[] shards[i].buckets;
+    }
+}
+
+
+template <typename ElementType>
+bool ConcurrentHashSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void ConcurrentHashSet<ElementType>::add(const ElementType& element)
+{
+    unsigned int hash = hashFunction(element);
+    Shard& shard = shards[shardIndex(hash)];
+
+    std::unique_lock<std::shared_mutex> lock{shard.mutex};
+
+    if (bucketContains(shard.buckets[hash % shard.capacity], element))
+    {
+        return;
+    }
+
+    if (shard.size + 1 > shard.capacity * 0.8)
+    {
+        rehash(shard, shard.capacity * 2 + 1);
+    }
+
+    Node*& bucket = shard.buckets[hash % shard.capacity];
+    bucket = new Node{element, bucket};
+
+    ++shard.size;
+    totalSize.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+template <typename ElementType>
+bool ConcurrentHashSet<ElementType>::contains(const ElementType& element) const
+{
+    unsigned int hash = hashFunction(element);
+    const Shard& shard = shards[shardIndex(hash)];
+
+    std::shared_lock<std::shared_mutex> lock{shard.mutex};
+    return bucketContains(shard.buckets[hash % shard.capacity], element);
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentHashSet<ElementType>::size() const noexcept
+{
+    return totalSize.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentHashSet<ElementType>::shardCount() const noexcept
+{
+    return 1u << shardBits;
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentHashSet<ElementType>::elementsInShard(unsigned int shard) const
+{
+    if (shard >= shardCount())
+    {
+        return 0;
+    }
+
+    std::shared_lock<std::shared_mutex> lock{shards[shard].mutex};
+    return shards[shard].size;
+}
+
+
+template <typename ElementType>
+SetMemoryUsage ConcurrentHashSet<ElementType>::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+    usage.bucketBytes = shardCount() * sizeof(Shard);
+
+    for (unsigned int i = 0; i < shardCount(); ++i)
+    {
+        std::shared_lock<std::shared_mutex> lock{shards[i].mutex};
+
+        usage.bucketBytes += shards[i].capacity * sizeof(Node*);
+
+        for (unsigned int j = 0; j < shards[i].capacity; ++j)
+        {
+            for (const Node* node = shards[i].buckets[j]; node != nullptr; node = node->next)
+            {
+                usage.nodeBytes += sizeof(Node);
+                usage.keyBytes += elementHeapBytes(node->element);
+            }
+        }
+    }
+
+    return usage;
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentHashSet<ElementType>::shardIndex(unsigned int hash) const noexcept
+{
+    if (shardBits == 0)
+    {
+        return 0;
+    }
+
+    // The bucket index within a shard is taken from the low-order end of
+    // the hash (hash % capacity), so the shard is chosen by the high-order
+    // bits of a multiplicative (Fibonacci) scramble of the hash instead;
+    // otherwise, the elements in any one shard would all share the same
+    // remainder and crowd into a fraction of its buckets.
+    unsigned int scrambled = hash * 2654435769u;
+    return scrambled >> (32 - shardBits);
+}
+
+
+template <typename ElementType>
+bool ConcurrentHashSet<ElementType>::bucketContains(const Node* node, const ElementType& element)
+{
+    while (node != nullptr)
+    {
+        if (node->element == element)
+        {
+            return true;
+        }
+
+        node = node->next;
+    }
+
+    return false;
+}
+
+
+template <typename ElementType>
+void ConcurrentHashSet<ElementType>::rehash(Shard& shard, unsigned int newCapacity)
+{
+    Node** newBuckets = new Node*[newCapacity]{};
+
+    for (unsigned int i = 0; i < shard.capacity; ++i)
+    {
+        Node* curr = shard.buckets[i];
+
+        while (curr != nullptr)
+        {
+            Node* next = curr->next;
+            Node*& bucket = newBuckets[hashFunction(curr->element) % newCapacity];
+
+            curr->next = bucket;
+            bucket = curr;
+            curr = next;
+        }
+    }
+
+    delete[] shard.buckets;
+    shard.buckets = newBuckets;
+    shard.capacity = newCapacity;
+}
+
+
+template <typename ElementType>
+void ConcurrentHashSet<ElementType>::destroyAll(Node* node) noexcept
+{
+    while (node != nullptr)
+    {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+
+
+#endif // CONCURRENTHASHSET_HPP
+
@@ -0,0 +1,190 @@
+// EditDistance.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "EditDistance.hpp"
+
+
+
+unsigned int levenshteinDistance(const std::string& a, const std::string& b)
+{
+    // previous[j] and current[j] are the distances between the first i - 1
+    // and first i characters of a, respectively, and the first j of b.
+    std::vector<unsigned int> previous(b.length() + 1);
+    std::vector<unsigned int> current(b.length() + 1);
+    std::iota(previous.begin(), previous.end(), 0);
+
+    for (std::size_t i = 1; i <= a.length(); ++i)
+    {
+        current[0] = static_cast<unsigned int>(i);
+
+        for (std::size_t j = 1; j <= b.length(); ++j)
+        {
+            unsigned int replacement = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+            current[j] = std::min({previous[j] + 1, current[j - 1] + 1, replacement});
+        }
+
+        std::swap(previous, current);
+    }
+
+    return previous[b.length()];
+}
+
+
+unsigned int damerauDistance(const std::string& a, const std::string& b)
+{
+    // As above, plus beforePrevious, the row for the first i - 2.
+    std::vector<unsigned int> beforePrevious(b.length() + 1);
+    std::vector<unsigned int> previous(b.length() + 1);
+    std::vector<unsigned int> current(b.length() + 1);
+    std::iota(previous.begin(), previous.end(), 0);
+
+    for (std::size_t i = 1; i <= a.length(); ++i)
+    {
+        current[0] = static_cast<unsigned int>(i);
+
+        for (std::size_t j = 1; j <= b.length(); ++j)
+        {
+            unsigned int replacement = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+            current[j] = std::min({previous[j] + 1, current[j - 1] + 1, replacement});
+
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+            {
+                current[j] = std::min(current[j], beforePrevious[j - 2] + 1);
+            }
+        }
+
+        std::swap(beforePrevious, previous);
+        std::swap(previous, current);
+    }
+
+    return previous[b.length()];
+}
+
+
+
+EditDistancePattern::EditDistancePattern(const std::string& pattern)
+    : pattern{pattern}, matches{}
+{
+    if (pattern.length() <= MAX_BIT_PARALLEL_LENGTH)
+    {
+        for (std::size_t i = 0; i < pattern.length(); ++i)
+        {
+            matches[static_cast<unsigned char>(pattern[i])] |= std::uint64_t{1} << i;
+        }
+    }
+}
+
+
+unsigned int EditDistancePattern::levenshteinDistanceTo(const std::string& text) const
+{
+    if (pattern.length() > MAX_BIT_PARALLEL_LENGTH)
+    {
+        return levenshteinDistance(pattern, text);
+    }
+    else if (pattern.empty())
+    {
+        return static_cast<unsigned int>(text.length());
+    }
+
+    // Bit i of positiveVertical (negativeVertical) is set if the distance in
+    // row i + 1 of the current column is one more (less) than in row i.
+    // The distance in the last row -- the one the bits are all relative
+    // to -- is tracked alongside them, starting with the first column.
+    std::uint64_t positiveVertical = ~std::uint64_t{0};
+    std::uint64_t negativeVertical = 0;
+    std::uint64_t lastRow = std::uint64_t{1} << (pattern.length() - 1);
+    unsigned int distance = static_cast<unsigned int>(pattern.length());
+
+    for (char c : text)
+    {
+        std::uint64_t match = matches[static_cast<unsigned char>(c)];
+
+        // Where the diagonal step from the previous column costs nothing.
+        std::uint64_t x = match | negativeVertical;
+        std::uint64_t zeroDiagonal = (((x & positiveVertical) + positiveVertical) ^ positiveVertical) | x;
+
+        std::uint64_t positiveHorizontal = negativeVertical | ~(zeroDiagonal | positiveVertical);
+        std::uint64_t negativeHorizontal = positiveVertical & zeroDiagonal;
+
+        if ((positiveHorizontal & lastRow) != 0)
+        {
+            ++distance;
+        }
+        else if ((negativeHorizontal & lastRow) != 0)
+        {
+            --distance;
+        }
+
+        // Row 0 of every column is one more than in the previous column,
+        // since the whole of the text so far has to be inserted.
+        positiveHorizontal = (positiveHorizontal << 1) | 1;
+        negativeHorizontal <<= 1;
+
+        positiveVertical = negativeHorizontal | ~(zeroDiagonal | positiveHorizontal);
+        negativeVertical = positiveHorizontal & zeroDiagonal;
+    }
+
+    return distance;
+}
+
+
+unsigned int EditDistancePattern::damerauDistanceTo(const std::string& text) const
+{
+    if (pattern.length() > MAX_BIT_PARALLEL_LENGTH)
+    {
+        return damerauDistance(pattern, text);
+    }
+    else if (pattern.empty())
+    {
+        return static_cast<unsigned int>(text.length());
+    }
+
+    std::uint64_t positiveVertical = ~std::uint64_t{0};
+    std::uint64_t negativeVertical = 0;
+    std::uint64_t zeroDiagonal = 0;
+    std::uint64_t previousMatch = 0;
+    std::uint64_t lastRow = std::uint64_t{1} << (pattern.length() - 1);
+    unsigned int distance = static_cast<unsigned int>(pattern.length());
+
+    for (char c : text)
+    {
+        std::uint64_t match = matches[static_cast<unsigned char>(c)];
+
+        // The only difference from the Levenshtein distance is that a
+        // diagonal step into row i can also be free by completing a swap:
+        // when this character matches pattern character i - 1, the previous
+        // one matches pattern character i, and the diagonal step into row
+        // i - 1 of the previous column wasn't free (Hyyro's formulation).
+        std::uint64_t swap = (((~zeroDiagonal) & match) << 1) & previousMatch;
+        std::uint64_t x = match | negativeVertical;
+
+        zeroDiagonal =
+            (((x & positiveVertical) + positiveVertical) ^ positiveVertical) | x | swap;
+
+        std::uint64_t positiveHorizontal = negativeVertical | ~(zeroDiagonal | positiveVertical);
+        std::uint64_t negativeHorizontal = positiveVertical & zeroDiagonal;
+
+        if ((positiveHorizontal & lastRow) != 0)
+        {
+            ++distance;
+        }
+        else if ((negativeHorizontal & lastRow) != 0)
+        {
+            --distance;
+        }
+
+        positiveHorizontal = (positiveHorizontal << 1) | 1;
+        negativeHorizontal <<= 1;
+
+        positiveVertical = negativeHorizontal | ~(zeroDiagonal | positiveHorizontal);
+        negativeVertical = positiveHorizontal & zeroDiagonal;
+        previousMatch = match;
+    }
+
+    return distance;
+}
@@ -0,0 +1,72 @@
+// EditDistance.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Functions for computing the edit distance between two strings, i.e., the
+// fewest single-character edits that turn one into the other.  There are
+// two kinds of distance:
+//
+// * The Levenshtein distance counts insertions, deletions, and
+//   replacements.
+// * The Damerau distance (in its "optimal string alignment" form) counts
+//   swaps of two adjacent characters, too, as long as no character is
+//   edited again after it's been swapped.
+//
+// levenshteinDistance() and damerauDistance() use the textbook dynamic
+// programming algorithm, filling in a table with one row per character of
+// one string and one column per character of the other, in O(mn) time --
+// keeping only two (or, for the Damerau distance, three) rows at a time.
+//
+// An EditDistancePattern is faster when one string is compared against
+// many others -- as it is when suggestions for a misspelled word are
+// ranked.  It uses the bit-parallel algorithms of Myers (for Levenshtein)
+// and Hyyro (for Damerau): every column of the table is represented by
+// two 64-bit vectors, one bit per row, saying where the values go up or
+// down from the row above, and a whole column is computed from the one
+// before it with a handful of bitwise operations.  So each comparison
+// takes O(n) time when the pattern has no more than 64 characters; the
+// bit vectors that say where each character appears in the pattern are
+// built only once, when the EditDistancePattern is.  Longer patterns fall
+// back to dynamic programming.
+
+#ifndef EDITDISTANCE_HPP
+#define EDITDISTANCE_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+
+
+unsigned int levenshteinDistance(const std::string& a, const std::string& b);
+unsigned int damerauDistance(const std::string& a, const std::string& b);
+
+
+
+class EditDistancePattern
+{
+public:
+    // The longest pattern the bit-parallel algorithms can handle.
+    static constexpr unsigned int MAX_BIT_PARALLEL_LENGTH = 64;
+
+public:
+    explicit EditDistancePattern(const std::string& pattern);
+
+    // levenshteinDistanceTo() and damerauDistanceTo() return the same
+    // distances as levenshteinDistance() and damerauDistance() would,
+    // between the pattern and the given text.
+    unsigned int levenshteinDistanceTo(const std::string& text) const;
+    unsigned int damerauDistanceTo(const std::string& text) const;
+
+
+private:
+    std::string pattern;
+
+    // Bit i of matches[c] is set if character i of the pattern is c.
+    std::array<std::uint64_t, 256> matches;
+};
+
+
+
+#endif // EDITDISTANCE_HPP
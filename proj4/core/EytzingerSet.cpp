@@ -0,0 +1,244 @@
+// EytzingerSet.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "EytzingerSet.hpp"
+
+
+
+namespace
+{
+    // The first eight characters of a word, packed big-endian, with missing
+    // characters counted as 0.  Since characters are compared as unsigned
+    // values, if a < b then prefixOf(a) <= prefixOf(b).
+    std::uint64_t prefixOf(const char* chars, std::size_t length) noexcept
+    {
+        std::uint64_t prefix = 0;
+
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            prefix <<= 8;
+
+            if (i < length)
+            {
+                prefix |= static_cast<unsigned char>(chars[i]);
+            }
+        }
+
+        return prefix;
+    }
+
+
+    // Compares two words the way std::string does, returning a negative
+    // value, zero, or a positive value.
+    int compareWords(
+        const char* a, std::size_t aLength, const char* b, std::size_t bLength) noexcept
+    {
+        int result = std::memcmp(a, b, std::min(aLength, bLength));
+
+        if (result != 0)
+        {
+            return result;
+        }
+
+        return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+    }
+
+
+    // Fills in which word (by its index in sorted order) belongs at each
+    // position of the subtree rooted at position k, by visiting the
+    // subtree's positions in order.  Returns the index of the next word
+    // to be placed.  The recursion is only as deep as the tree is tall.
+    std::size_t assignPositions(
+        std::vector<std::size_t>& wordAt, std::size_t k, std::size_t nextWord)
+    {
+        if (k < wordAt.size())
+        {
+            nextWord = assignPositions(wordAt, 2 * k, nextWord);
+            wordAt[k] = nextWord++;
+            nextWord = assignPositions(wordAt, 2 * k + 1, nextWord);
+        }
+
+        return nextWord;
+    }
+
+
+    // Removes the lowest zero bit of k and every one bit below it.  After
+    // a search has run off the bottom of the tree, the ones at the bottom
+    // of k are the steps it took to the right, after the last step to the
+    // left, and the step to the left was taken at the word it's after.
+    std::size_t undoRightTurns(std::size_t k) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return k >> __builtin_ffsll(static_cast<long long>(~k));
+#else
+        while ((k & 1) != 0)
+        {
+            k >>= 1;
+        }
+
+        return k >> 1;
+#endif
+    }
+
+
+    void prefetch(const void* address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#endif
+    }
+}
+
+
+
+EytzingerSet::EytzingerSet(const std::vector<std::string>& words)
+    : size_{0}
+{
+    std::vector<const std::string*> keys;
+    keys.reserve(words.size());
+
+    for (const std::string& word : words)
+    {
+        keys.push_back(&word);
+    }
+
+    std::sort(
+        keys.begin(), keys.end(),
+        [](const std::string* a, const std::string* b) { return *a < *b; });
+
+    keys.erase(
+        std::unique(
+            keys.begin(), keys.end(),
+            [](const std::string* a, const std::string* b) { return *a == *b; }),
+        keys.end());
+
+    size_ = static_cast<unsigned int>(keys.size());
+
+    // Position 0 is never used, so that the root can be at position 1.
+    std::vector<std::size_t> wordAt(keys.size() + 1);
+    assignPositions(wordAt, 1, 0);
+
+    lines.resize((keys.size() + 1 + 3) / 4);
+
+    std::size_t arenaLength = 0;
+
+    for (const std::string* key : keys)
+    {
+        arenaLength += key->length();
+    }
+
+    if (arenaLength > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw TooLargeException{};
+    }
+
+    arena.reserve(arenaLength);
+
+    // The words' characters go into the arena in the same order as their
+    // entries, so the words near the root are near each other, too.
+    for (std::size_t k = 1; k < wordAt.size(); ++k)
+    {
+        const std::string& key = *keys[wordAt[k]];
+        Entry& entry = lines[k / 4].entries[k % 4];
+
+        entry.prefix = prefixOf(key.data(), key.length());
+        entry.offset = static_cast<std::uint32_t>(arena.length());
+        entry.length = static_cast<std::uint32_t>(key.length());
+
+        arena.append(key);
+    }
+}
+
+
+bool EytzingerSet::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void EytzingerSet::add(const std::string& element)
+{
+    if (!contains(element))
+    {
+        throw FrozenException{};
+    }
+}
+
+
+bool EytzingerSet::contains(const std::string& element) const
+{
+    std::uint64_t prefix = prefixOf(element.data(), element.length());
+    std::size_t lastLine = lines.size() - 1;
+
+    std::size_t k = 1;
+
+    while (k <= size_)
+    {
+        // The 16 entries four levels below k fill the four cache lines
+        // beginning with line 4k.  Near the bottom of the tree, they're
+        // past the end of the array, so the line numbers are clamped.
+        for (std::size_t line = 4 * k; line < 4 * k + 4; ++line)
+        {
+            prefetch(&lines[std::min(line, lastLine)]);
+        }
+
+        k = 2 * k + isLess(entryAt(k), prefix, element);
+    }
+
+    k = undoRightTurns(k);
+    return k != 0 && isEqual(entryAt(k), prefix, element);
+}
+
+
+unsigned int EytzingerSet::size() const noexcept
+{
+    return size_;
+}
+
+
+SetMemoryUsage EytzingerSet::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+    usage.nodeBytes = lines.capacity() * sizeof(EntryLine);
+    usage.keyBytes = elementHeapBytes(arena);
+    return usage;
+}
+
+
+const EytzingerSet::Entry& EytzingerSet::entryAt(std::size_t k) const noexcept
+{
+    return lines[k / 4].entries[k % 4];
+}
+
+
+bool EytzingerSet::isLess(
+    const Entry& entry, std::uint64_t prefix, const std::string& element) const noexcept
+{
+    // Only when the prefixes are equal -- which is rare, except close to
+    // where the element is (or would be) -- does this need to branch.
+    bool less = entry.prefix < prefix;
+
+    if (entry.prefix == prefix)
+    {
+        less = compareWords(
+            arena.data() + entry.offset, entry.length, element.data(), element.length()) < 0;
+    }
+
+    return less;
+}
+
+
+bool EytzingerSet::isEqual(
+    const Entry& entry, std::uint64_t prefix, const std::string& element) const noexcept
+{
+    return entry.prefix == prefix
+        && entry.length == element.length()
+        && std::memcmp(arena.data() + entry.offset, element.data(), element.length()) == 0;
+}
+
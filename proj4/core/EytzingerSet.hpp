@@ -0,0 +1,120 @@
+// EytzingerSet.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// An EytzingerSet is a read-only Set of strings, built once from a list of
+// words (such as the one returned by WordSetLoader::load) and never changed
+// afterward.  It's a sorted array searched by binary search, except that
+// the array isn't in sorted order: it's in "Eytzinger order," the order in
+// which a breadth-first traversal would visit the nodes of a perfectly
+// balanced binary search tree holding the same words.  The root is at
+// index 1, and the children of the word at index k are at indexes 2k and
+// 2k + 1, so no pointers are needed, and a search only ever moves forward
+// through the array.
+//
+// That layout helps a search in two ways:
+//
+// * The first few levels of the tree -- which every search passes through
+//   -- sit together at the front of the array, so they stay in the cache.
+// * Since the nodes four levels below index k are the 16 consecutive ones
+//   beginning at index 16k, a search can prefetch them long before it gets
+//   there, overlapping the wait for memory with the comparisons it still
+//   has to do on the way down.
+//
+// The search is also "branchless": every step computes k = 2k + (whether
+// the word at k is less than the one being searched for), with no branch
+// whose direction depends on the outcome of the comparison, so there are
+// no mispredicted branches, which a binary search otherwise suffers on
+// about half of its steps.  Once k has run off the bottom of the tree,
+// the position of the smallest word not less than the one being searched
+// for can be recovered from k's bits.
+//
+// Each entry is 16 bytes -- so four of them fill exactly one cache line --
+// and holds the first eight characters of its word (packed big-endian
+// into an integer, so that comparing integers compares the characters),
+// along with where the rest of the word is in a contiguous arena of
+// characters.  Most comparisons are settled by the prefixes alone; only
+// when two prefixes are equal is the arena consulted.
+//
+// As with FrozenHashSet, add() only accepts elements that are already
+// present (in which case it has no effect); adding any other element
+// throws an EytzingerSet::FrozenException.
+
+#ifndef EYTZINGERSET_HPP
+#define EYTZINGERSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Set.hpp"
+
+
+
+class EytzingerSet : public Set<std::string>
+{
+public:
+    // Builds an EytzingerSet containing the given words.  Duplicates are
+    // allowed and are ignored, just as they would be by add().  Offsets
+    // into the arena are 32 bits, so a TooLargeException is thrown if the
+    // distinct words have more than 2^32 - 1 characters altogether.
+    explicit EytzingerSet(const std::vector<std::string>& words);
+
+
+    bool isImplemented() const noexcept override;
+
+    // add() throws a FrozenException unless the element is already in
+    // the set.
+    void add(const std::string& element) override;
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  It runs in O(log n) time, making one comparison per
+    // level of the (implicit) tree, plus one more at the end.
+    bool contains(const std::string& element) const override;
+    using Set<std::string>::contains;
+
+    unsigned int size() const noexcept override;
+
+
+    // memoryUsage() reports the entries (which include each word's
+    // prefix) as nodeBytes and the arena as keyBytes.
+    SetMemoryUsage memoryUsage() const override;
+
+
+    class FrozenException { };
+    class TooLargeException { };
+
+
+private:
+    struct Entry
+    {
+        std::uint64_t prefix;
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    // The entries are stored in groups of four, each group aligned to
+    // a cache line, so that the two children of every entry share one.
+    // Entry k is entry k % 4 of line k / 4; entry 0 is never used, and
+    // there's always at least one line, even when the set is empty.
+    struct alignas(64) EntryLine
+    {
+        Entry entries[4];
+    };
+
+    std::vector<EntryLine> lines;
+    std::string arena;
+    unsigned int size_;
+
+private:
+    const Entry& entryAt(std::size_t k) const noexcept;
+
+    bool isLess(const Entry& entry, std::uint64_t prefix, const std::string& element) const noexcept;
+    bool isEqual(const Entry& entry, std::uint64_t prefix, const std::string& element) const noexcept;
+};
+
+
+
+#endif // EYTZINGERSET_HPP
+
@@ -0,0 +1,551 @@
+// FrozenHashSet.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include "FrozenHashSet.hpp"
+
+
+
+namespace
+{
+    // The average number of words per bucket.  Larger buckets mean fewer
+    // displacement pairs to store, but make it harder to find a pair that
+    // places a whole bucket without collisions.
+    constexpr unsigned int WORDS_PER_BUCKET = 5;
+
+    // How many values of d0 are tried for a bucket (each with every
+    // possible d1) before giving up and starting over with a new seed.
+    constexpr std::uint32_t MAX_D0 = 64;
+
+
+    std::uint64_t mix(std::uint64_t h) noexcept
+    {
+        // The finalizer from SplitMix64, which spreads every input bit
+        // across all 64 output bits.
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return h;
+    }
+
+
+    // Maps a 32-bit value uniformly onto [0, n) with a multiplication and
+    // a shift, which is several times cheaper than a % operator.
+    std::uint64_t reduce(std::uint64_t value, std::uint64_t n) noexcept
+    {
+        return ((value & 0xffffffffULL) * n) >> 32;
+    }
+
+
+    // The bucket is chosen from a rescrambled copy of the hash, so that it
+    // isn't correlated with f1 and f2, which come from the hash directly.
+    std::uint64_t bucketBits(std::uint64_t h) noexcept
+    {
+        return (h * 0x9e3779b97f4a7c15ULL) >> 32;
+    }
+
+
+    // Entries store a word's length in their low 24 bits and eight more
+    // bits of its (rescrambled) hash in their high 8 bits, so that most
+    // lookups of missing words can be rejected without touching the arena.
+    // Lengths that don't fit are stored as LONG_LENGTH, in which case the
+    // real length has to be worked out from where the next word begins.
+    constexpr std::uint32_t LONG_LENGTH = 0xffffff;
+
+
+    std::uint32_t packLengthAndFingerprint(std::size_t length, std::uint64_t h) noexcept
+    {
+        std::uint32_t fingerprint = ((h * 0x9e3779b97f4a7c15ULL) >> 24) & 0xff;
+        std::uint32_t packedLength =
+            length < LONG_LENGTH ? static_cast<std::uint32_t>(length) : LONG_LENGTH;
+
+        return (fingerprint << 24) | packedLength;
+    }
+
+
+    struct KeyHashes
+    {
+        std::uint64_t f1;
+        std::uint64_t f2;
+    };
+
+
+    // The layout of the header at the beginning of a saved file.
+    struct FileHeader
+    {
+        char magic[8];
+        std::uint64_t version;
+        std::uint64_t seed;
+        std::uint64_t bucketCount;
+        std::uint64_t wordCount;
+        std::uint64_t arenaLength;
+    };
+
+
+    constexpr char FILE_MAGIC[8] = {'I', 'C', 'S', '4', '6', 'F', 'H', 'S'};
+    constexpr std::uint64_t FILE_VERSION = 1;
+
+
+    // Every word's offset into the arena, and the offset just past the
+    // last word, have to fit in an Entry's 32 bits.
+    void requireArenaFits(const std::vector<const std::string*>& keys)
+    {
+        std::size_t totalLength = 0;
+
+        for (const std::string* key : keys)
+        {
+            totalLength += key->length();
+        }
+
+        if (totalLength > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw FrozenHashSet::TooLargeException{};
+        }
+    }
+}
+
+
+
+FrozenHashSet::FrozenHashSet()
+    : seed{0},
+      displacementData{nullptr}, displacementCount{0},
+      entryData{nullptr}, entryCount{0},
+      arenaData{nullptr}, arenaLength{0}
+{
+}
+
+
+FrozenHashSet::FrozenHashSet(const std::vector<std::string>& words)
+    : FrozenHashSet{}
+{
+    std::vector<const std::string*> keys;
+    keys.reserve(words.size());
+
+    for (const std::string& word : words)
+    {
+        keys.push_back(&word);
+    }
+
+    std::sort(
+        keys.begin(), keys.end(),
+        [](const std::string* a, const std::string* b) { return *a < *b; });
+
+    keys.erase(
+        std::unique(
+            keys.begin(), keys.end(),
+            [](const std::string* a, const std::string* b) { return *a == *b; }),
+        keys.end());
+
+    requireArenaFits(keys);
+
+    while (!tryBuild(keys))
+    {
+        seed = mix(seed + 1);
+    }
+
+    viewOwnedStorage();
+}
+
+
+FrozenHashSet::FrozenHashSet(const FrozenHashSet& s)
+    : seed{s.seed},
+      displacementData{s.displacementData}, displacementCount{s.displacementCount},
+      entryData{s.entryData}, entryCount{s.entryCount},
+      arenaData{s.arenaData}, arenaLength{s.arenaLength},
+      displacements{s.displacements}, entries{s.entries}, arena{s.arena},
+      mappedFile{s.mappedFile}
+{
+    viewOwnedStorage();
+}
+
+
+FrozenHashSet::FrozenHashSet(FrozenHashSet&& s) noexcept
+    : seed{s.seed},
+      displacementData{s.displacementData}, displacementCount{s.displacementCount},
+      entryData{s.entryData}, entryCount{s.entryCount},
+      arenaData{s.arenaData}, arenaLength{s.arenaLength},
+      displacements{std::move(s.displacements)}, entries{std::move(s.entries)},
+      arena{std::move(s.arena)}, mappedFile{std::move(s.mappedFile)}
+{
+    viewOwnedStorage();
+    s.viewOwnedStorage();
+}
+
+
+FrozenHashSet& FrozenHashSet::operator=(const FrozenHashSet& s)
+{
+    if (this != &s)
+    {
+        *this = FrozenHashSet{s};
+    }
+
+    return *this;
+}
+
+
+FrozenHashSet& FrozenHashSet::operator=(FrozenHashSet&& s) noexcept
+{
+    if (this != &s)
+    {
+        seed = s.seed;
+        displacementData = s.displacementData;
+        displacementCount = s.displacementCount;
+        entryData = s.entryData;
+        entryCount = s.entryCount;
+        arenaData = s.arenaData;
+        arenaLength = s.arenaLength;
+        displacements = std::move(s.displacements);
+        entries = std::move(s.entries);
+        arena = std::move(s.arena);
+        mappedFile = std::move(s.mappedFile);
+
+        viewOwnedStorage();
+        s.viewOwnedStorage();
+    }
+
+    return *this;
+}
+
+
+FrozenHashSet FrozenHashSet::map(const std::string& filePath)
+{
+    FrozenHashSet s;
+    s.mappedFile = std::make_shared<MappedFile>(filePath);
+
+    const char* data = s.mappedFile->data();
+    std::size_t size = s.mappedFile->size();
+
+    FileHeader header;
+
+    if (size < sizeof(header))
+    {
+        throw FileFormatException{};
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0
+        || header.version != FILE_VERSION
+        || header.wordCount > UINT32_MAX
+        || header.bucketCount > UINT32_MAX
+        || (header.wordCount > 0 && header.bucketCount == 0)
+        || header.arenaLength > UINT32_MAX
+        || size != sizeof(header)
+                   + header.bucketCount * sizeof(Displacement)
+                   + header.wordCount * sizeof(Entry)
+                   + header.arenaLength)
+    {
+        throw FileFormatException{};
+    }
+
+    // The header is a multiple of eight bytes long, and so are the
+    // displacements and entries, so every table in the mapping is
+    // suitably aligned to be read in place.  Only the header is checked;
+    // the tables themselves are trusted, since checking them would mean
+    // reading the whole file, which is what mapping it is meant to avoid.
+    s.seed = header.seed;
+    s.displacementData = reinterpret_cast<const Displacement*>(data + sizeof(header));
+    s.displacementCount = header.bucketCount;
+    s.entryData = reinterpret_cast<const Entry*>(s.displacementData + s.displacementCount);
+    s.entryCount = header.wordCount;
+    s.arenaData = reinterpret_cast<const char*>(s.entryData + s.entryCount);
+    s.arenaLength = header.arenaLength;
+
+    return s;
+}
+
+
+void FrozenHashSet::save(const std::string& filePath) const
+{
+    std::ofstream file{filePath, std::ios::binary | std::ios::trunc};
+
+    FileHeader header;
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.seed = seed;
+    header.bucketCount = displacementCount;
+    header.wordCount = entryCount;
+    header.arenaLength = arenaLength;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(
+        reinterpret_cast<const char*>(displacementData),
+        displacementCount * sizeof(Displacement));
+    file.write(reinterpret_cast<const char*>(entryData), entryCount * sizeof(Entry));
+    file.write(arenaData, arenaLength);
+
+    if (!file)
+    {
+        throw FileFormatException{};
+    }
+}
+
+
+bool FrozenHashSet::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void FrozenHashSet::add(const std::string& element)
+{
+    if (!contains(element))
+    {
+        throw FrozenException{};
+    }
+}
+
+
+bool FrozenHashSet::contains(const std::string& element) const
+{
+    if (entryCount == 0)
+    {
+        return false;
+    }
+
+    std::uint64_t h = hash(element.data(), element.length());
+    unsigned int index = indexOfHash(h);
+    const Entry& entry = entryData[index];
+
+    if (entry.lengthAndFingerprint != packLengthAndFingerprint(element.length(), h))
+    {
+        return false;
+    }
+
+    if (element.length() >= LONG_LENGTH)
+    {
+        std::size_t end = index + 1 < entryCount ? entryData[index + 1].offset : arenaLength;
+
+        if (end - entry.offset != element.length())
+        {
+            return false;
+        }
+    }
+
+    return std::memcmp(arenaData + entry.offset, element.data(), element.length()) == 0;
+}
+
+
+unsigned int FrozenHashSet::size() const noexcept
+{
+    return static_cast<unsigned int>(entryCount);
+}
+
+
+unsigned int FrozenHashSet::bucketCount() const noexcept
+{
+    return static_cast<unsigned int>(displacementCount);
+}
+
+
+unsigned int FrozenHashSet::indexOf(const std::string& element) const noexcept
+{
+    return entryCount == 0 ? 0 : indexOfHash(hash(element.data(), element.length()));
+}
+
+
+SetMemoryUsage FrozenHashSet::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+
+    if (mappedFile)
+    {
+        usage.bucketBytes = displacementCount * sizeof(Displacement);
+        usage.nodeBytes = entryCount * sizeof(Entry);
+        usage.keyBytes = arenaLength;
+    }
+    else
+    {
+        usage.bucketBytes = displacements.capacity() * sizeof(Displacement);
+        usage.nodeBytes = entries.capacity() * sizeof(Entry);
+        usage.keyBytes = elementHeapBytes(arena);
+    }
+
+    return usage;
+}
+
+
+void FrozenHashSet::viewOwnedStorage() noexcept
+{
+    if (mappedFile)
+    {
+        return;
+    }
+
+    displacementData = displacements.data();
+    displacementCount = displacements.size();
+    entryData = entries.data();
+    entryCount = entries.size();
+    arenaData = arena.data();
+    arenaLength = arena.length();
+}
+
+
+bool FrozenHashSet::tryBuild(const std::vector<const std::string*>& keys)
+{
+    std::uint64_t n = keys.size();
+    std::uint64_t bucketCount =
+        std::max<std::uint64_t>(1, (n + WORDS_PER_BUCKET - 1) / WORDS_PER_BUCKET);
+
+    std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+    std::vector<KeyHashes> keyHashes(n);
+
+    for (std::uint32_t i = 0; i < n; ++i)
+    {
+        std::uint64_t h = hash(keys[i]->data(), keys[i]->length());
+
+        buckets[reduce(bucketBits(h), bucketCount)].push_back(i);
+        keyHashes[i].f1 = reduce(h, n);
+        keyHashes[i].f2 = reduce(h >> 32, n - 1) + 1;
+    }
+
+    std::vector<std::uint32_t> bucketOrder(bucketCount);
+
+    for (std::uint32_t b = 0; b < bucketCount; ++b)
+    {
+        bucketOrder[b] = b;
+    }
+
+    std::stable_sort(
+        bucketOrder.begin(), bucketOrder.end(),
+        [&](std::uint32_t a, std::uint32_t b)
+        {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+    std::vector<Displacement> newDisplacements(bucketCount, Displacement{0, 0});
+    std::vector<std::uint32_t> slotOwner(n, UINT32_MAX);
+    std::vector<std::uint64_t> positions;
+
+    for (std::uint32_t b : bucketOrder)
+    {
+        const std::vector<std::uint32_t>& bucket = buckets[b];
+
+        if (bucket.empty())
+        {
+            break;
+        }
+
+        bool placed = false;
+
+        for (std::uint32_t d0 = 0; d0 < MAX_D0 && !placed; ++d0)
+        {
+            for (std::uint64_t d1 = 0; d1 < n && !placed; ++d1)
+            {
+                positions.clear();
+
+                for (std::uint32_t key : bucket)
+                {
+                    std::uint64_t position =
+                        (keyHashes[key].f1 + d0 * keyHashes[key].f2 + d1) % n;
+
+                    if (slotOwner[position] != UINT32_MAX
+                        || std::find(positions.begin(), positions.end(), position)
+                           != positions.end())
+                    {
+                        break;
+                    }
+
+                    positions.push_back(position);
+                }
+
+                if (positions.size() == bucket.size())
+                {
+                    for (std::size_t i = 0; i < bucket.size(); ++i)
+                    {
+                        slotOwner[positions[i]] = bucket[i];
+                    }
+
+                    newDisplacements[b] = Displacement{d0, static_cast<std::uint32_t>(d1)};
+                    placed = true;
+                }
+            }
+        }
+
+        if (!placed)
+        {
+            return false;
+        }
+    }
+
+    displacements = std::move(newDisplacements);
+
+    std::size_t totalLength = 0;
+
+    for (const std::string* key : keys)
+    {
+        totalLength += key->length();
+    }
+
+    arena.clear();
+    arena.reserve(totalLength);
+    entries.clear();
+    entries.reserve(n);
+
+    for (std::uint64_t slot = 0; slot < n; ++slot)
+    {
+        const std::string& key = *keys[slotOwner[slot]];
+        std::uint64_t h = hash(key.data(), key.length());
+
+        entries.push_back(
+            Entry{static_cast<std::uint32_t>(arena.length()),
+                  packLengthAndFingerprint(key.length(), h)});
+
+        arena.append(key);
+    }
+
+    return true;
+}
+
+
+std::uint64_t FrozenHashSet::hash(const char* chars, std::size_t length) const noexcept
+{
+    // The characters are consumed eight at a time (most words fit in one
+    // or two such chunks), with a single thorough mix at the end, so that
+    // every bit of the result depends on every character.
+    std::uint64_t h = seed ^ (length * 0x9e3779b97f4a7c15ULL);
+
+    while (length >= 8)
+    {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, chars, 8);
+
+        h = (h ^ chunk) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+
+        chars += 8;
+        length -= 8;
+    }
+
+    if (length > 0)
+    {
+        std::uint64_t chunk = 0;
+        std::memcpy(&chunk, chars, length);
+
+        h = (h ^ chunk) * 0xff51afd7ed558ccdULL;
+    }
+
+    return mix(h);
+}
+
+
+unsigned int FrozenHashSet::indexOfHash(std::uint64_t h) const noexcept
+{
+    std::uint64_t n = entryCount;
+
+    std::uint64_t f1 = reduce(h, n);
+    std::uint64_t f2 = reduce(h >> 32, n - 1) + 1;
+
+    const Displacement& d = displacementData[reduce(bucketBits(h), displacementCount)];
+
+    return static_cast<unsigned int>((f1 + d.d0 * f2 + d.d1) % n);
+}
+
@@ -0,0 +1,175 @@
+// FrozenHashSet.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A FrozenHashSet is a read-only Set of strings, built once from a list of
+// words (such as the one returned by WordSetLoader::load) and never changed
+// afterward.  Since every word is known up front, it can use a minimal
+// perfect hash function: one that maps each of the n words to a different
+// index between 0 and n - 1, so there are no collisions, no chains, and
+// no empty cells.  The function is built using the "compress, hash, and
+// displace" (CHD) algorithm:
+//
+// * Every word is hashed once into 64 bits.  Part of that hash splits the
+//   words into small buckets (about five words apiece); the rest of it
+//   provides two values, f1 and f2, for each word.
+// * The buckets are placed one at a time, largest first.  For each bucket,
+//   a "displacement" pair (d0, d1) is searched for, such that the index
+//   (f1 + d0 * f2 + d1) % n of every word in the bucket lands on a cell
+//   that nobody has claimed yet.  Only the pair is stored for the bucket.
+//
+// The words themselves are stored back-to-back in one contiguous arena of
+// characters, in index order.  Alongside it is an array with one eight-byte
+// entry per index, holding the word's offset into the arena, its length,
+// and an eight-bit fingerprint taken from its hash.  So contains() hashes
+// the word once, reads one displacement pair, computes one index, reads
+// one entry, and -- only if the length and fingerprint both match, which
+// almost never happens for a misspelled word -- compares against the one
+// word stored there with a single memcmp().
+//
+// Because the set is frozen, add() only accepts elements that are already
+// present (in which case, as with any Set, it has no effect); adding any
+// other element throws a FrozenHashSet::FrozenException.
+//
+// A built FrozenHashSet can be saved to a binary file with save(), and a
+// saved file can be brought back with map().  The file is laid out exactly
+// the way the tables are laid out in memory:
+//
+//     header          six 64-bit values: the magic number "ICS46FHS",
+//                     the format version, the hash seed, the number of
+//                     buckets, the number of words, and the arena length
+//     displacements   one 8-byte (d0, d1) pair per bucket
+//     entries         one 8-byte entry per word
+//     arena           the characters of all of the words
+//
+// so map() only has to mmap() the file and check the header; lookups then
+// run directly against the mapped pages, which the operating system reads
+// from disk only as they're touched.  Starting up from a saved file costs
+// almost nothing, no matter how large the dictionary is.  (Numbers are
+// stored in the machine's native byte order, so saved files aren't meant
+// to be moved between machines of different kinds.)
+
+#ifndef FROZENHASHSET_HPP
+#define FROZENHASHSET_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MappedFile.hpp"
+#include "Set.hpp"
+
+
+
+class FrozenHashSet : public Set<std::string>
+{
+public:
+    // Builds a FrozenHashSet containing the given words.  Duplicates are
+    // allowed and are ignored, just as they would be by add().  Offsets
+    // into the arena are 32 bits, so a TooLargeException is thrown if the
+    // distinct words have more than 2^32 - 1 characters altogether.
+    explicit FrozenHashSet(const std::vector<std::string>& words);
+
+    // Copies share the mapped file of the set they were copied from, if
+    // it has one, rather than copying its contents.
+    FrozenHashSet(const FrozenHashSet& s);
+    FrozenHashSet(FrozenHashSet&& s) noexcept;
+    FrozenHashSet& operator=(const FrozenHashSet& s);
+    FrozenHashSet& operator=(FrozenHashSet&& s) noexcept;
+
+
+    // map() returns a FrozenHashSet whose tables are the contents of the
+    // given file (previously written by save()), mapped into memory.  A
+    // MappedFile::OpenException is thrown if the file can't be mapped,
+    // and a FileFormatException if it isn't a saved FrozenHashSet.
+    static FrozenHashSet map(const std::string& filePath);
+
+
+    // save() writes the set to the given file, in the format that map()
+    // expects.  A FileFormatException is thrown if the file can't be
+    // written.
+    void save(const std::string& filePath) const;
+
+
+    bool isImplemented() const noexcept override;
+
+    // add() throws a FrozenException unless the element is already in
+    // the set.
+    void add(const std::string& element) override;
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  It always runs in constant time (with respect to the
+    // number of elements), with exactly one probe into the table.
+    bool contains(const std::string& element) const override;
+    using Set<std::string>::contains;
+
+    unsigned int size() const noexcept override;
+
+
+    // bucketCount() returns the number of buckets that the perfect hash
+    // function uses, each of which stores one displacement pair.
+    unsigned int bucketCount() const noexcept;
+
+
+    // indexOf() returns the index (between 0 and size() - 1) that the
+    // perfect hash function assigns to the given element.  For elements
+    // that aren't in the set, the index is meaningless but still valid.
+    unsigned int indexOf(const std::string& element) const noexcept;
+
+
+    // memoryUsage() reports the displacement pairs as bucketBytes, the
+    // entries as nodeBytes, and the arena as keyBytes.  For a mapped set,
+    // these are pages of the mapped file rather than allocated memory.
+    SetMemoryUsage memoryUsage() const override;
+
+
+    class FrozenException { };
+    class FileFormatException { };
+    class TooLargeException { };
+
+
+private:
+    struct Displacement
+    {
+        std::uint32_t d0;
+        std::uint32_t d1;
+    };
+
+    struct Entry
+    {
+        std::uint32_t offset;
+        std::uint32_t lengthAndFingerprint;
+    };
+
+    std::uint64_t seed;
+
+    // Lookups always go through these views, which point either into the
+    // storage below (for a set that was built in memory) or into the
+    // mapped file (for a set returned by map()).
+    const Displacement* displacementData;
+    std::size_t displacementCount;
+    const Entry* entryData;
+    std::size_t entryCount;
+    const char* arenaData;
+    std::size_t arenaLength;
+
+    std::vector<Displacement> displacements;
+    std::vector<Entry> entries;
+    std::string arena;
+
+    std::shared_ptr<const MappedFile> mappedFile;
+
+private:
+    FrozenHashSet();
+
+    void viewOwnedStorage() noexcept;
+    bool tryBuild(const std::vector<const std::string*>& keys);
+    std::uint64_t hash(const char* chars, std::size_t length) const noexcept;
+    unsigned int indexOfHash(std::uint64_t h) const noexcept;
+};
+
+
+
+#endif // FROZENHASHSET_HPP
+
@@ -40,11 +40,20 @@ public:
     // ElementType and returns an unsigned int.
     using HashFunction = std::function<unsigned int(const ElementType&)>;
 
+    // A ViewHashFunction hashes a view of an element (see Set.hpp), giving
+    // the same hash as the HashFunction would give the element itself.
+    using ElementView = typename Set<ElementType>::ElementView;
+    using ViewHashFunction = std::function<unsigned int(ElementView)>;
+
 public:
     // Initializes a HashSet to be empty, so that it will use the given
     // hash function whenever it needs to hash an element.
     explicit HashSet(HashFunction hashFunction);
 
+    // Initializes a HashSet to be empty, so that it will also use the given
+    // view hash function to search for views without copying them.
+    HashSet(HashFunction hashFunction, ViewHashFunction viewHashFunction);
+
     // Cleans up the HashSet so that it leaks no memory.
     ~HashSet() noexcept override;
 
@@ -87,6 +96,15 @@ public:
     bool contains(const ElementType& element) const override;
 
 
+    // This contains() searches for a view of an element in the same way,
+    // provided that the HashSet was given a view hash function; if not,
+    // the view is copied into an element, which is searched for instead.
+    bool contains(ElementView element) const override;
+
+
+    using Set<ElementType>::contains;
+
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
@@ -103,8 +121,14 @@ public:
     bool isElementAtIndex(const ElementType& element, unsigned int index) const;
 
 
+    // memoryUsage() reports the bucket array as bucketBytes and the
+    // linked list nodes (each holding a copy of its key) as nodeBytes.
+    SetMemoryUsage memoryUsage() const override;
+
+
 private:
     HashFunction hashFunction;
+    ViewHashFunction viewHashFunction;
 
     struct HashNode{
         ElementType key;
@@ -135,7 +159,14 @@ namespace impl_
 
 template <typename ElementType>
 HashSet<ElementType>::HashSet(HashFunction hashFunction)
-    : hashFunction{hashFunction}
+    : HashSet{hashFunction, nullptr}
+{
+}
+
+
+template <typename ElementType>
+HashSet<ElementType>::HashSet(HashFunction hashFunction, ViewHashFunction viewHashFunction)
+    : hashFunction{hashFunction}, viewHashFunction{viewHashFunction}
 {
     hash_capacity = DEFAULT_CAPACITY;
     hash_size = 0;
@@ -152,7 +183,7 @@ HashSet<ElementType>::~HashSet() noexcept
         for (unsigned int i = 0; i < hash_capacity; i++) {
             if (hashtable[i] != NULL) deleteNode(hashtable[i]);
         }
-        delete hashtable;
+        delete []hashtable;
     }
 
     hash_capacity = DEFAULT_CAPACITY;
@@ -166,6 +197,7 @@ HashSet<ElementType>::HashSet(const HashSet& s)
 {
     // copy constructor
     hashFunction = s.hashFunction;
+    viewHashFunction = s.viewHashFunction;
     hash_capacity = s.hash_capacity;
     hash_size = s.hash_size;
 
@@ -200,6 +232,7 @@ HashSet<ElementType>::HashSet(HashSet&& s) noexcept
     : hashFunction{impl_::HashSet__undefinedHashFunction<ElementType>}
 {
     hashFunction = s.hashFunction;
+    viewHashFunction = s.viewHashFunction;
     hash_capacity = s.hash_capacity;
     hashtable = s.hashtable; // non-deep copy
     hash_size = s.hash_size;
@@ -222,6 +255,7 @@ HashSet<ElementType>& HashSet<ElementType>::operator=(const HashSet& s)
 
         // do copy
         hashFunction = s.hashFunction;
+        viewHashFunction = s.viewHashFunction;
         hash_capacity = s.hash_capacity;
         hash_size = s.hash_size;
 
@@ -259,6 +293,7 @@ HashSet<ElementType>& HashSet<ElementType>::operator=(HashSet&& s) noexcept
 {
     if (this != &s) {
         hashFunction = s.hashFunction;
+        viewHashFunction = s.viewHashFunction;
         hash_capacity = s.hash_capacity;
         hashtable = s.hashtable; // non-deep copy
         hash_size = s.hash_size;
@@ -279,6 +314,37 @@ bool HashSet<ElementType>::isImplemented() const noexcept
 template <typename ElementType>
 void HashSet<ElementType>::add(const ElementType& element)
 {
+    if (contains(element)) return;
+
+    if ((hash_size + 1) > hash_capacity * 0.8) { // resize and rehash
+        unsigned int new_capacity = hash_capacity * 2 + 1;
+
+        HashNode **new_hashtable = new HashNode*[new_capacity];
+        for (unsigned int i = 0; i < new_capacity; i++)
+            new_hashtable[i] = NULL;
+
+        for (unsigned int i = 0; i < hash_capacity; i++) {
+            HashNode *ptr = hashtable[i];
+
+            while (ptr != NULL) { // relink every node, no copies
+                HashNode *nxt = ptr->next;
+                unsigned int idx = hashFunction(ptr->key)%new_capacity;
+
+                ptr->next = new_hashtable[idx];
+                new_hashtable[idx] = ptr;
+                ptr = nxt;
+            }
+        }
+
+        delete []hashtable;
+        hashtable = new_hashtable;
+        hash_capacity = new_capacity;
+    }
+
+    unsigned int idx = hashFunction(element)%hash_capacity;
+
+    hashtable[idx] = new HashNode{element, hashtable[idx]};
+    hash_size += 1;
 }
 
 
@@ -297,6 +363,25 @@ bool HashSet<ElementType>::contains(const ElementType& element) const
 }
 
 
+template <typename ElementType>
+bool HashSet<ElementType>::contains(ElementView element) const
+{
+    if constexpr (Set<ElementType>::HAS_ELEMENT_VIEW) {
+        if (!viewHashFunction) return Set<ElementType>::contains(element);
+
+        unsigned int idx = viewHashFunction(element)%hash_capacity;
+
+        HashNode *ptr = hashtable[idx];
+        while (ptr != NULL) { // compare without copying the view
+            if (ptr->key == element) return true;
+            ptr = ptr->next;
+        }
+    }
+
+    return false;
+}
+
+
 template <typename ElementType>
 unsigned int HashSet<ElementType>::size() const noexcept
 {
@@ -334,5 +419,27 @@ bool HashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned
 
 
 
+template <typename ElementType>
+SetMemoryUsage HashSet<ElementType>::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+
+    if (hashtable == NULL) return usage;
+
+    usage.bucketBytes = hash_capacity * sizeof(HashNode*);
+
+    for (unsigned int i = 0; i < hash_capacity; i++) {
+        for (HashNode *ptr = hashtable[i]; ptr != NULL; ptr = ptr->next) {
+            usage.nodeBytes += sizeof(HashNode);
+            usage.keyBytes += elementHeapBytes(ptr->key);
+        }
+    }
+
+    return usage;
+}
+
+
+
 #endif // HASHSET_HPP
 
@@ -0,0 +1,865 @@
+// LockFreeSkipListSet.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A LockFreeSkipListSet is an implementation of a Set that is a skip list
+// which any number of threads can use at once -- adding, removing, looking
+// up, and iterating over elements in order -- without any locks.  No thread
+// ever waits for another: if one thread is stalled partway through changing
+// the skip list, the others carry on around it.
+//
+// The nodes are laid out like SkipListSet's (one node per element, with an
+// array of forward pointers), except that the forward pointers are atomic
+// and their lowest bit is used as a "mark."  This is the design of Harris
+// (for linked lists) as extended to skip lists by Fraser:
+//
+// * add() links a new node into level 0 with a single compare-and-swap,
+//   at which point the element is in the set, and then links it into the
+//   higher levels one at a time.
+// * remove() marks the forward pointers of the element's node, from the
+//   top level down.  Marking level 0 is the moment the element leaves the
+//   set.  A marked node is then unlinked ("snipped") from each level by
+//   whichever thread next searches past it, including the one removing it.
+// * contains() and forEach() never change anything; they just step over
+//   marked nodes.
+//
+// A removed node can't be deleted as soon as it's unlinked, because other
+// threads may have been looking at it.  Instead, it's handed to an
+// epoch-based reclamation scheme: each operation "pins" the current global
+// epoch for as long as it runs, the epoch only moves forward once every
+// pinned operation has seen it, and a node retired during one epoch is
+// deleted three epochs later, by which time no operation that could have
+// seen it is still running.
+//
+// The level tester decides how many levels each new element is on, as it
+// does for SkipListSet, but level testers aren't safe to share between
+// threads.  So the set keeps a small pool of clones of the given level
+// tester, each with its own lock, and each thread uses the clone that
+// corresponds to it; the lock is only ever held during the coin flips.
+// The tester is consulted for every call to add(), even ones that turn
+// out to be adding an element that was already present.
+//
+// Copying or moving a set that other threads might be using at the same
+// time doesn't have a sensible meaning, so a LockFreeSkipListSet can be
+// neither copied nor moved.
+
+#ifndef LOCKFREESKIPLISTSET_HPP
+#define LOCKFREESKIPLISTSET_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "Set.hpp"
+#include "SkipListSet.hpp"
+
+
+
+template <typename ElementType>
+class LockFreeSkipListSet : public Set<ElementType>
+{
+public:
+    // No element is ever on more than this many levels, no matter what
+    // the level tester says.
+    static constexpr unsigned int MAX_LEVEL_COUNT = 32;
+
+    // A VisitFunction is a function that takes a reference to a const
+    // ElementType and returns no value.
+    using VisitFunction = std::function<void(const ElementType&)>;
+
+public:
+    // Initializes a LockFreeSkipListSet to be empty, with or without a
+    // "level tester" object that will decide, whenever a "coin flip"
+    // is needed, whether a key should occupy the next level above.
+    LockFreeSkipListSet();
+    explicit LockFreeSkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester);
+
+    // Cleans up the LockFreeSkipListSet so that it leaks no memory.  No
+    // other thread may be using the set when it's destroyed.
+    ~LockFreeSkipListSet() noexcept override;
+
+    LockFreeSkipListSet(const LockFreeSkipListSet& s) = delete;
+    LockFreeSkipListSet(LockFreeSkipListSet&& s) = delete;
+    LockFreeSkipListSet& operator=(const LockFreeSkipListSet& s) = delete;
+    LockFreeSkipListSet& operator=(LockFreeSkipListSet&& s) = delete;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  This function runs in an expected
+    // time of O(log n), plus any retries caused by other threads changing
+    // the same part of the skip list at the same time.
+    void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  It never writes to the skip list, so any number of
+    // calls to it can run at once without slowing one another down.
+    bool contains(const ElementType& element) const override;
+
+
+    using Set<ElementType>::contains;
+
+
+    // remove() removes the given element from the set, returning true if
+    // this call removed it and false if it wasn't there (including if
+    // another thread removed it first).
+    bool remove(const ElementType& element);
+
+
+    // size() returns the number of elements in the set.  While other
+    // threads are changing the set, this is a snapshot that may already
+    // be out of date by the time it's returned.
+    unsigned int size() const noexcept override;
+
+
+    // levelCount() returns the number of levels in the skip list, which
+    // is the greatest number of levels that any element has ever been on
+    // (and at least 1).
+    unsigned int levelCount() const noexcept;
+
+
+    // forEach() calls the given "visit" function for each of the elements
+    // in the set, in ascending order.  If other threads are changing the
+    // set at the same time, elements added or removed during the call
+    // may or may not be visited, but no element is visited twice.
+    void forEach(VisitFunction visit) const;
+
+
+    // memoryUsage() reports the nodes (including removed ones that are
+    // waiting to be deleted) as nodeBytes and the epoch and level tester
+    // bookkeeping as bucketBytes.  The level testers aren't counted.
+    SetMemoryUsage memoryUsage() const override;
+
+
+private:
+    using Link = std::atomic<std::uintptr_t>;
+
+    // As in SkipListSet, a Node is allocated with its array of forward
+    // pointers immediately after it.  A node is deleted once both the
+    // thread that added it has finished linking it into the skip list and
+    // the thread that removed it has finished unlinking it, whichever
+    // happens last, so unfinishedOwners starts out at 2.
+    struct Node
+    {
+        Node(const ElementType& element, unsigned int height)
+            : element{element}, height{height}, unfinishedOwners{2}
+        {
+        }
+
+        ElementType element;
+        alignas(Link) unsigned int height;
+        std::atomic<unsigned int> unfinishedOwners;
+
+        Link* links() noexcept
+        {
+            return reinterpret_cast<Link*>(this + 1);
+        }
+
+        const Link* links() const noexcept
+        {
+            return reinterpret_cast<const Link*>(this + 1);
+        }
+    };
+
+    // An EpochSlot records the epoch pinned by the operation currently
+    // using it (with the lowest bit set while it's pinned), and the nodes
+    // retired during the last three epochs in which it was used.  Each
+    // operation claims a slot for as long as it runs.
+    struct alignas(64) EpochSlot
+    {
+        std::atomic<bool> claimed{false};
+        std::atomic<std::uint64_t> pinnedEpoch{0};
+        std::vector<Node*> retired[3];
+        std::uint64_t retiredEpoch[3] = {0, 0, 0};
+        unsigned int retiredSinceAdvance = 0;
+    };
+
+    static constexpr unsigned int EPOCH_SLOT_COUNT = 64;
+    static constexpr unsigned int RETIREMENTS_PER_ADVANCE = 64;
+
+    // An EpochGuard claims an EpochSlot and pins the current epoch for as
+    // long as it exists.
+    class EpochGuard
+    {
+    public:
+        explicit EpochGuard(const LockFreeSkipListSet& set);
+        ~EpochGuard() noexcept;
+
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+
+        void retire(Node* node);
+
+    private:
+        const LockFreeSkipListSet& set;
+        EpochSlot* slot;
+        std::uint64_t epoch;
+    };
+
+    struct alignas(64) TesterSlot
+    {
+        std::mutex mutex;
+        std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
+    };
+
+    static constexpr unsigned int TESTER_SLOT_COUNT = 16;
+
+    Link head[MAX_LEVEL_COUNT];
+    std::atomic<unsigned int> levelCount_;
+    std::atomic<unsigned int> size_;
+
+    std::vector<TesterSlot> testerSlots;
+
+    mutable std::vector<EpochSlot> epochSlots;
+    mutable std::atomic<std::uint64_t> globalEpoch;
+
+private:
+    static Node* pointerOf(std::uintptr_t link) noexcept;
+    static bool isMarked(std::uintptr_t link) noexcept;
+    static std::uintptr_t linkTo(const Node* node) noexcept;
+
+    static std::size_t nodeBytes(unsigned int height) noexcept;
+    static Node* createNode(const ElementType& element, unsigned int height);
+    static void destroyNode(Node* node) noexcept;
+
+    static unsigned int currentThreadIndex() noexcept;
+
+    Link& linkAfter(Node* node, unsigned int level) noexcept;
+    const Link& linkAfter(const Node* node, unsigned int level) const noexcept;
+
+    unsigned int randomHeight(const ElementType& element);
+    void raiseLevelCount(unsigned int height) noexcept;
+
+    bool find(const ElementType& element, Node** preds, Node** succs);
+    bool tryFind(const ElementType& element, Node** preds, Node** succs, bool& found);
+
+    void releaseOwner(Node* node, EpochGuard& guard);
+    EpochSlot* claimEpochSlot() const noexcept;
+    void tryAdvanceEpoch() const noexcept;
+};
+
+
+
+template <typename ElementType>
+LockFreeSkipListSet<ElementType>::LockFreeSkipListSet()
+    : LockFreeSkipListSet{std::make_unique<GeometricSkipListLevelTester<ElementType>>()}
+{
+}
+
+
+template <typename ElementType>
+LockFreeSkipListSet<ElementType>::LockFreeSkipListSet(
+    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
+    : levelCount_{1}, size_{0}, testerSlots(TESTER_SLOT_COUNT),
+      epochSlots(EPOCH_SLOT_COUNT), globalEpoch{0}
+{
+    for (Link& link : head)
+    {
+        link.store(0, std::memory_order_relaxed);
+    }
+
+    for (TesterSlot& testerSlot : testerSlots)
+    {
+        testerSlot.levelTester = levelTester->clone();
+    }
+}
+
+
+template <typename ElementType>
+LockFreeSkipListSet<ElementType>::~LockFreeSkipListSet() noexcept
+{
+    Node* node = pointerOf(head[0].load());
+
+    while (node != nullptr)
+    {
+        Node* next = pointerOf(node->links()[0].load());
+        destroyNode(node);
+        node = next;
+    }
+
+    for (EpochSlot& slot : epochSlots)
+    {
+        for (std::vector<Node*>& retired : slot.retired)
+        {
+            for (Node* retiredNode : retired)
+            {
+                destroyNode(retiredNode);
+            }
+        }
+    }
+}
+
+
+template <typename ElementType>
+bool LockFreeSkipListSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void LockFreeSkipListSet<ElementType>::add(const ElementType& element)
+{
+    EpochGuard guard{*this};
+
+    unsigned int height = randomHeight(element);
+    raiseLevelCount(height);
+
+    Node* preds[MAX_LEVEL_COUNT];
+    Node* succs[MAX_LEVEL_COUNT];
+    Node* node = nullptr;
+
+    while (true)
+    {
+        if (find(element, preds, succs))
+        {
+            if (node != nullptr)
+            {
+                destroyNode(node);
+            }
+
+            return;
+        }
+
+        if (node == nullptr)
+        {
+            node = createNode(element, height);
+        }
+
+        for (unsigned int level = 0; level < height; ++level)
+        {
+            node->links()[level].store(linkTo(succs[level]), std::memory_order_relaxed);
+        }
+
+        // This is the moment the element joins the set.
+        std::uintptr_t expected = linkTo(succs[0]);
+
+        if (linkAfter(preds[0], 0).compare_exchange_strong(expected, linkTo(node)))
+        {
+            break;
+        }
+    }
+
+    size_.fetch_add(1);
+
+    // Link the node into the higher levels.  If some other thread starts
+    // removing the node in the meantime (marking its forward pointers),
+    // there's no point in going any further.
+    bool removed = false;
+
+    for (unsigned int level = 1; level < height && !removed; ++level)
+    {
+        while (true)
+        {
+            std::uintptr_t current = node->links()[level].load();
+
+            if (isMarked(current))
+            {
+                removed = true;
+                break;
+            }
+
+            if (current != linkTo(succs[level])
+                && !node->links()[level].compare_exchange_strong(current, linkTo(succs[level])))
+            {
+                continue;
+            }
+
+            std::uintptr_t expected = linkTo(succs[level]);
+
+            if (linkAfter(preds[level], level).compare_exchange_strong(expected, linkTo(node)))
+            {
+                break;
+            }
+
+            // Something changed around the node on this level, so search
+            // again to find out where it belongs now.
+            if (!find(element, preds, succs) || succs[0] != node)
+            {
+                removed = true;
+                break;
+            }
+        }
+    }
+
+    // If the node was removed while it was being linked, the remover may
+    // already have finished unlinking it -- before some of the links above
+    // were made -- so search once more to be sure that it's unlinked from
+    // every level.
+    if (isMarked(node->links()[0].load()))
+    {
+        find(element, preds, succs);
+    }
+
+    releaseOwner(node, guard);
+}
+
+
+template <typename ElementType>
+bool LockFreeSkipListSet<ElementType>::contains(const ElementType& element) const
+{
+    EpochGuard guard{*this};
+
+    const Node* pred = nullptr;
+    const Node* curr = nullptr;
+
+    for (unsigned int level = levelCount_.load(); level-- > 0; )
+    {
+        curr = pointerOf(linkAfter(pred, level).load());
+
+        while (curr != nullptr)
+        {
+            std::uintptr_t succ = curr->links()[level].load();
+
+            if (isMarked(succ))
+            {
+                curr = pointerOf(succ);
+            }
+            else if (curr->element < element)
+            {
+                pred = curr;
+                curr = pointerOf(succ);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    return curr != nullptr && curr->element == element;
+}
+
+
+template <typename ElementType>
+bool LockFreeSkipListSet<ElementType>::remove(const ElementType& element)
+{
+    EpochGuard guard{*this};
+
+    Node* preds[MAX_LEVEL_COUNT];
+    Node* succs[MAX_LEVEL_COUNT];
+
+    if (!find(element, preds, succs))
+    {
+        return false;
+    }
+
+    Node* node = succs[0];
+
+    for (unsigned int level = node->height; level-- > 1; )
+    {
+        std::uintptr_t current = node->links()[level].load();
+
+        while (!isMarked(current)
+            && !node->links()[level].compare_exchange_weak(current, current | 1))
+        {
+        }
+    }
+
+    std::uintptr_t current = node->links()[0].load();
+
+    while (true)
+    {
+        if (isMarked(current))
+        {
+            // Another thread removed it first.
+            return false;
+        }
+
+        // This is the moment the element leaves the set.
+        if (node->links()[0].compare_exchange_strong(current, current | 1))
+        {
+            break;
+        }
+    }
+
+    size_.fetch_sub(1);
+
+    // Searching for the element snips the node out of every level on
+    // which it's linked.
+    find(element, preds, succs);
+
+    releaseOwner(node, guard);
+    return true;
+}
+
+
+template <typename ElementType>
+unsigned int LockFreeSkipListSet<ElementType>::size() const noexcept
+{
+    return size_.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType>
+unsigned int LockFreeSkipListSet<ElementType>::levelCount() const noexcept
+{
+    return levelCount_.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType>
+void LockFreeSkipListSet<ElementType>::forEach(VisitFunction visit) const
+{
+    EpochGuard guard{*this};
+
+    const Node* node = pointerOf(head[0].load());
+
+    while (node != nullptr)
+    {
+        std::uintptr_t next = node->links()[0].load();
+
+        if (!isMarked(next))
+        {
+            visit(node->element);
+        }
+
+        node = pointerOf(next);
+    }
+}
+
+
+template <typename ElementType>
+SetMemoryUsage LockFreeSkipListSet<ElementType>::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+    usage.bucketBytes =
+        testerSlots.capacity() * sizeof(TesterSlot) + epochSlots.capacity() * sizeof(EpochSlot);
+
+    usage.nodesPerLevel.assign(levelCount(), 0);
+
+    for (const Node* node = pointerOf(head[0].load()); node != nullptr;
+         node = pointerOf(node->links()[0].load()))
+    {
+        usage.nodeBytes += nodeBytes(node->height);
+        usage.keyBytes += elementHeapBytes(node->element);
+
+        if (!isMarked(node->links()[0].load()))
+        {
+            for (unsigned int level = 0; level < node->height; ++level)
+            {
+                usage.nodesPerLevel[level] += 1;
+            }
+        }
+    }
+
+    for (const EpochSlot& slot : epochSlots)
+    {
+        for (const std::vector<Node*>& retired : slot.retired)
+        {
+            usage.bucketBytes += retired.capacity() * sizeof(Node*);
+
+            for (const Node* retiredNode : retired)
+            {
+                usage.nodeBytes += nodeBytes(retiredNode->height);
+                usage.keyBytes += elementHeapBytes(retiredNode->element);
+            }
+        }
+    }
+
+    return usage;
+}
+
+
+template <typename ElementType>
+typename LockFreeSkipListSet<ElementType>::Node*
+LockFreeSkipListSet<ElementType>::pointerOf(std::uintptr_t link) noexcept
+{
+    return reinterpret_cast<Node*>(link & ~std::uintptr_t{1});
+}
+
+
+template <typename ElementType>
+bool LockFreeSkipListSet<ElementType>::isMarked(std::uintptr_t link) noexcept
+{
+    return (link & 1) != 0;
+}
+
+
+template <typename ElementType>
+std::uintptr_t LockFreeSkipListSet<ElementType>::linkTo(const Node* node) noexcept
+{
+    return reinterpret_cast<std::uintptr_t>(node);
+}
+
+
+template <typename ElementType>
+std::size_t LockFreeSkipListSet<ElementType>::nodeBytes(unsigned int height) noexcept
+{
+    return sizeof(Node) + height * sizeof(Link);
+}
+
+
+template <typename ElementType>
+typename LockFreeSkipListSet<ElementType>::Node*
+LockFreeSkipListSet<ElementType>::createNode(const ElementType& element, unsigned int height)
+{
+    void* memory = ::operator new(nodeBytes(height));
+    Node* node;
+
+    try
+    {
+        node = new (memory) Node{element, height};
+    }
+    catch (...)
+    {
+        ::operator delete(memory);
+        throw;
+    }
+
+    for (unsigned int level = 0; level < height; ++level)
+    {
+        new (&node->links()[level]) Link{0};
+    }
+
+    return node;
+}
+
+
+template <typename ElementType>
+void LockFreeSkipListSet<ElementType>::destroyNode(Node* node) noexcept
+{
+    node->~Node();
+    ::operator delete(node);
+}
+
+
+template <typename ElementType>
+unsigned int LockFreeSkipListSet<ElementType>::currentThreadIndex() noexcept
+{
+    static std::atomic<unsigned int> nextThreadIndex{0};
+    thread_local unsigned int threadIndex = nextThreadIndex.fetch_add(1);
+
+    return threadIndex;
+}
+
+
+template <typename ElementType>
+typename LockFreeSkipListSet<ElementType>::Link&
+LockFreeSkipListSet<ElementType>::linkAfter(Node* node, unsigned int level) noexcept
+{
+    return node == nullptr ? head[level] : node->links()[level];
+}
+
+
+template <typename ElementType>
+const typename LockFreeSkipListSet<ElementType>::Link&
+LockFreeSkipListSet<ElementType>::linkAfter(const Node* node, unsigned int level) const noexcept
+{
+    return node == nullptr ? head[level] : node->links()[level];
+}
+
+
+template <typename ElementType>
+unsigned int LockFreeSkipListSet<ElementType>::randomHeight(const ElementType& element)
+{
+    TesterSlot& testerSlot = testerSlots[currentThreadIndex() % TESTER_SLOT_COUNT];
+    std::lock_guard<std::mutex> lock{testerSlot.mutex};
+
+    return testerSlot.levelTester->chooseHeight(element, MAX_LEVEL_COUNT);
+}
+
+
+template <typename ElementType>
+void LockFreeSkipListSet<ElementType>::raiseLevelCount(unsigned int height) noexcept
+{
+    unsigned int current = levelCount_.load();
+
+    while (current < height && !levelCount_.compare_exchange_weak(current, height))
+    {
+    }
+}
+
+
+template <typename ElementType>
+bool LockFreeSkipListSet<ElementType>::find(
+    const ElementType& element, Node** preds, Node** succs)
+{
+    bool found;
+
+    while (!tryFind(element, preds, succs, found))
+    {
+    }
+
+    return found;
+}
+
+
+template <typename ElementType>
+bool LockFreeSkipListSet<ElementType>::tryFind(
+    const ElementType& element, Node** preds, Node** succs, bool& found)
+{
+    // Walks down the skip list just as contains() does, recording the last
+    // node before the element (preds) and the first node not before it
+    // (succs) on every level, and snipping out every marked node it meets
+    // along the way.  If a snip fails, or the node we're standing on turns
+    // out to be marked, the skip list changed underneath us, so we give up
+    // and the caller starts over from the top.
+    Node* pred = nullptr;
+
+    for (unsigned int level = levelCount_.load(); level-- > 0; )
+    {
+        std::uintptr_t currLink = linkAfter(pred, level).load();
+
+        if (isMarked(currLink))
+        {
+            return false;
+        }
+
+        Node* curr = pointerOf(currLink);
+
+        while (curr != nullptr)
+        {
+            std::uintptr_t succLink = curr->links()[level].load();
+
+            if (isMarked(succLink))
+            {
+                std::uintptr_t expected = linkTo(curr);
+
+                if (!linkAfter(pred, level).compare_exchange_strong(
+                        expected, succLink & ~std::uintptr_t{1}))
+                {
+                    return false;
+                }
+
+                curr = pointerOf(succLink);
+            }
+            else if (curr->element < element)
+            {
+                pred = curr;
+                curr = pointerOf(succLink);
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+
+    found = succs[0] != nullptr && succs[0]->element == element;
+    return true;
+}
+
+
+template <typename ElementType>
+void LockFreeSkipListSet<ElementType>::releaseOwner(Node* node, EpochGuard& guard)
+{
+    if (node->unfinishedOwners.fetch_sub(1) == 1)
+    {
+        guard.retire(node);
+    }
+}
+
+
+template <typename ElementType>
+typename LockFreeSkipListSet<ElementType>::EpochSlot*
+LockFreeSkipListSet<ElementType>::claimEpochSlot() const noexcept
+{
+    // Each thread starts with "its own" slot, but if that one is claimed
+    // (because there are more threads than slots, or because this thread
+    // is in the middle of another operation, such as a call to add() from
+    // a function passed to forEach()), it moves on to the next one.
+    for (unsigned int index = currentThreadIndex(); ; ++index)
+    {
+        EpochSlot& slot = epochSlots[index % EPOCH_SLOT_COUNT];
+        bool unclaimed = false;
+
+        if (!slot.claimed.load(std::memory_order_relaxed)
+            && slot.claimed.compare_exchange_strong(unclaimed, true, std::memory_order_acquire))
+        {
+            return &slot;
+        }
+    }
+}
+
+
+template <typename ElementType>
+void LockFreeSkipListSet<ElementType>::tryAdvanceEpoch() const noexcept
+{
+    std::uint64_t epoch = globalEpoch.load();
+
+    for (const EpochSlot& slot : epochSlots)
+    {
+        std::uint64_t pinned = slot.pinnedEpoch.load();
+
+        if ((pinned & 1) != 0 && (pinned >> 1) != epoch)
+        {
+            return;
+        }
+    }
+
+    globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+
+template <typename ElementType>
+LockFreeSkipListSet<ElementType>::EpochGuard::EpochGuard(const LockFreeSkipListSet& set)
+    : set{set}, slot{set.claimEpochSlot()}, epoch{set.globalEpoch.load()}
+{
+    slot->pinnedEpoch.store((epoch << 1) | 1);
+
+    // The epoch may have moved on between reading it and pinning it, in
+    // which case we pin the newer one instead.  Once a pinned epoch has
+    // been seen to match, the global epoch can't get more than one ahead
+    // of it until this guard is destroyed.
+    std::uint64_t current;
+
+    while ((current = set.globalEpoch.load()) != epoch)
+    {
+        epoch = current;
+        slot->pinnedEpoch.store((epoch << 1) | 1);
+    }
+
+    // Nodes retired into this bucket were retired during an epoch at
+    // least three before this one, so no running operation can still be
+    // looking at them.
+    unsigned int bucket = epoch % 3;
+
+    if (slot->retiredEpoch[bucket] != epoch)
+    {
+        for (Node* node : slot->retired[bucket])
+        {
+            destroyNode(node);
+        }
+
+        slot->retired[bucket].clear();
+        slot->retiredEpoch[bucket] = epoch;
+    }
+}
+
+
+template <typename ElementType>
+LockFreeSkipListSet<ElementType>::EpochGuard::~EpochGuard() noexcept
+{
+    slot->pinnedEpoch.store(epoch << 1);
+    slot->claimed.store(false, std::memory_order_release);
+}
+
+
+template <typename ElementType>
+void LockFreeSkipListSet<ElementType>::EpochGuard::retire(Node* node)
+{
+    slot->retired[epoch % 3].push_back(node);
+
+    if (++slot->retiredSinceAdvance >= RETIREMENTS_PER_ADVANCE)
+    {
+        slot->retiredSinceAdvance = 0;
+        set.tryAdvanceEpoch();
+    }
+}
+
+
+
+#endif // LOCKFREESKIPLISTSET_HPP
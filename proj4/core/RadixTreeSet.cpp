@@ -0,0 +1,750 @@
+// RadixTreeSet.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+#include "RadixTreeSet.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+
+struct RadixTreeSet::Node4 : Node
+{
+    unsigned char keys[4];
+    Node* children[4];
+};
+
+
+struct RadixTreeSet::Node16 : Node
+{
+    unsigned char keys[16];
+    Node* children[16];
+};
+
+
+// A Node48's childIndex holds, for each character, one more than the index
+// of its child in children, or 0 if there is no child for it.
+struct RadixTreeSet::Node48 : Node
+{
+    unsigned char childIndex[256];
+    Node* children[48];
+};
+
+
+struct RadixTreeSet::Node256 : Node
+{
+    Node* children[256];
+};
+
+
+
+#if defined(__SSE2__)
+namespace
+{
+    // Returns the index of the lowest one bit of a nonzero mask.
+    unsigned int lowestBit(unsigned int mask) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#else
+        unsigned int index = 0;
+
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            ++index;
+        }
+
+        return index;
+#endif
+    }
+}
+#endif
+
+
+
+RadixTreeSet::RadixTreeSet()
+    : root{nullptr}, size_{0}
+{
+}
+
+
+RadixTreeSet::~RadixTreeSet() noexcept
+{
+    destroySubtree(root);
+}
+
+
+RadixTreeSet::RadixTreeSet(const RadixTreeSet& s)
+    : root{nullptr}, size_{s.size_}
+{
+    if (s.root != nullptr)
+    {
+        root = copySubtree(s.root);
+    }
+}
+
+
+RadixTreeSet::RadixTreeSet(RadixTreeSet&& s) noexcept
+    : root{nullptr}, size_{0}
+{
+    std::swap(root, s.root);
+    std::swap(size_, s.size_);
+}
+
+
+RadixTreeSet& RadixTreeSet::operator=(const RadixTreeSet& s)
+{
+    if (this != &s)
+    {
+        RadixTreeSet copy{s};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+
+RadixTreeSet& RadixTreeSet::operator=(RadixTreeSet&& s) noexcept
+{
+    std::swap(root, s.root);
+    std::swap(size_, s.size_);
+    return *this;
+}
+
+
+bool RadixTreeSet::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void RadixTreeSet::add(const std::string& element)
+{
+    const char* chars = element.data();
+    std::size_t length = element.length();
+    std::size_t depth = 0;
+
+    // The slot is the pointer that points to the current node -- either
+    // the root or an entry in its parent's children -- so that the node
+    // can be replaced when it has to be split or grown.
+    Node** slot = &root;
+
+    while (*slot != nullptr)
+    {
+        Node* node = *slot;
+        const char* prefix = prefixOf(node);
+
+        std::size_t matched = 0;
+        std::size_t limit = std::min<std::size_t>(node->prefixLength, length - depth);
+
+        while (matched < limit && prefix[matched] == chars[depth + matched])
+        {
+            ++matched;
+        }
+
+        if (matched < node->prefixLength)
+        {
+            // The element parts ways with the node's prefix (or ends) partway
+            // through it, so the node is split in two there: a new Node4
+            // holding the part of the prefix that matched, with the node --
+            // keeping only the rest of its prefix -- as one of its children.
+            // Unless the element ends at the split, its remaining characters
+            // become a new leaf alongside it.
+            bool endsAtSplit = depth + matched == length;
+            Node* parent = createNode(Kind::Node4, prefix, matched, endsAtSplit);
+            Node* leaf = nullptr;
+
+            try
+            {
+                if (!endsAtSplit)
+                {
+                    leaf = createNode(
+                        Kind::Node0, chars + depth + matched + 1, length - depth - matched - 1, true);
+                }
+
+                unsigned char splitCharacter = static_cast<unsigned char>(prefix[matched]);
+
+                Node* rest = rebuild(
+                    node, node->kind, prefix + matched + 1, node->prefixLength - matched - 1);
+
+                addChild(parent, splitCharacter, rest);
+            }
+            catch (...)
+            {
+                destroyNode(leaf);
+                destroyNode(parent);
+                throw;
+            }
+
+            if (leaf != nullptr)
+            {
+                addChild(parent, static_cast<unsigned char>(chars[depth + matched]), leaf);
+            }
+
+            *slot = parent;
+            ++size_;
+            return;
+        }
+
+        depth += matched;
+
+        if (depth == length)
+        {
+            if (!node->isWord)
+            {
+                node->isWord = true;
+                ++size_;
+            }
+
+            return;
+        }
+
+        unsigned char c = static_cast<unsigned char>(chars[depth]);
+        Node** child = findChild(node, c);
+
+        if (child != nullptr)
+        {
+            slot = child;
+            ++depth;
+            continue;
+        }
+
+        Node* leaf = createNode(Kind::Node0, chars + depth + 1, length - depth - 1, true);
+
+        if (node->childCount == capacity(node->kind))
+        {
+            try
+            {
+                node = rebuild(node, nextLargerKind(node->kind), prefix, node->prefixLength);
+            }
+            catch (...)
+            {
+                destroyNode(leaf);
+                throw;
+            }
+
+            *slot = node;
+        }
+
+        addChild(node, c, leaf);
+        ++size_;
+        return;
+    }
+
+    *slot = createNode(Kind::Node0, chars, length, true);
+    ++size_;
+}
+
+
+bool RadixTreeSet::contains(const std::string& element) const
+{
+    const char* chars = element.data();
+    std::size_t length = element.length();
+    std::size_t depth = 0;
+
+    const Node* node = root;
+
+    while (node != nullptr)
+    {
+        if (node->prefixLength > length - depth
+            || std::memcmp(prefixOf(node), chars + depth, node->prefixLength) != 0)
+        {
+            return false;
+        }
+
+        depth += node->prefixLength;
+
+        if (depth == length)
+        {
+            return node->isWord;
+        }
+
+        Node* const* child = findChild(node, static_cast<unsigned char>(chars[depth]));
+
+        if (child == nullptr)
+        {
+            return false;
+        }
+
+        node = *child;
+        ++depth;
+    }
+
+    return false;
+}
+
+
+unsigned int RadixTreeSet::size() const noexcept
+{
+    return size_;
+}
+
+
+void RadixTreeSet::forEachWithPrefix(const std::string& prefix, VisitFunction visit) const
+{
+    const char* chars = prefix.data();
+    std::size_t length = prefix.length();
+    std::size_t depth = 0;
+
+    const Node* node = root;
+
+    while (node != nullptr)
+    {
+        // Once the rest of the prefix fits within the node's prefix, every
+        // element below the node -- and no other -- begins with it, as long
+        // as the node's prefix begins with the rest of it.
+        if (node->prefixLength >= length - depth)
+        {
+            if (std::memcmp(prefixOf(node), chars + depth, length - depth) == 0)
+            {
+                std::string path{chars, depth};
+                visitSubtree(node, path, visit);
+            }
+
+            return;
+        }
+
+        if (std::memcmp(prefixOf(node), chars + depth, node->prefixLength) != 0)
+        {
+            return;
+        }
+
+        depth += node->prefixLength;
+
+        Node* const* child = findChild(node, static_cast<unsigned char>(chars[depth]));
+
+        if (child == nullptr)
+        {
+            return;
+        }
+
+        node = *child;
+        ++depth;
+    }
+}
+
+
+SetMemoryUsage RadixTreeSet::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+
+    if (root != nullptr)
+    {
+        measure(root, usage);
+    }
+
+    return usage;
+}
+
+
+RadixTreeSet::Node* RadixTreeSet::createNode(
+    Kind kind, const char* prefix, std::size_t prefixLength, bool isWord)
+{
+    void* memory = ::operator new(nodeSize(kind) + prefixLength);
+    Node* node;
+
+    // Value-initializing the node zeroes all of it, which leaves it with
+    // no children; in a Node48, a 0 in childIndex means "no child."
+    switch (kind)
+    {
+    case Kind::Node0:
+        node = new (memory) Node{};
+        break;
+
+    case Kind::Node4:
+        node = new (memory) Node4{};
+        break;
+
+    case Kind::Node16:
+        node = new (memory) Node16{};
+        break;
+
+    case Kind::Node48:
+        node = new (memory) Node48{};
+        break;
+
+    default:
+        node = new (memory) Node256{};
+        break;
+    }
+
+    node->kind = kind;
+    node->isWord = isWord;
+    node->prefixLength = static_cast<std::uint32_t>(prefixLength);
+    std::memcpy(prefixOf(node), prefix, prefixLength);
+
+    return node;
+}
+
+
+void RadixTreeSet::destroyNode(Node* node) noexcept
+{
+    // Every kind of node is trivially destructible, so there's nothing to
+    // do but give back its memory.
+    ::operator delete(node);
+}
+
+
+void RadixTreeSet::destroySubtree(Node* node) noexcept
+{
+    if (node != nullptr)
+    {
+        forEachChild(node, [](unsigned char, Node* child) { destroySubtree(child); });
+        destroyNode(node);
+    }
+}
+
+
+RadixTreeSet::Node* RadixTreeSet::copySubtree(const Node* node)
+{
+    Node* copy = createNode(node->kind, prefixOf(node), node->prefixLength, node->isWord);
+
+    try
+    {
+        forEachChild(
+            node,
+            [copy](unsigned char c, const Node* child)
+            {
+                addChild(copy, c, copySubtree(child));
+            });
+    }
+    catch (...)
+    {
+        destroySubtree(copy);
+        throw;
+    }
+
+    return copy;
+}
+
+
+std::size_t RadixTreeSet::nodeSize(Kind kind) noexcept
+{
+    switch (kind)
+    {
+    case Kind::Node0:
+        return sizeof(Node);
+
+    case Kind::Node4:
+        return sizeof(Node4);
+
+    case Kind::Node16:
+        return sizeof(Node16);
+
+    case Kind::Node48:
+        return sizeof(Node48);
+
+    default:
+        return sizeof(Node256);
+    }
+}
+
+
+std::size_t RadixTreeSet::capacity(Kind kind) noexcept
+{
+    switch (kind)
+    {
+    case Kind::Node0:
+        return 0;
+
+    case Kind::Node4:
+        return 4;
+
+    case Kind::Node16:
+        return 16;
+
+    case Kind::Node48:
+        return 48;
+
+    default:
+        return 256;
+    }
+}
+
+
+char* RadixTreeSet::prefixOf(Node* node) noexcept
+{
+    return reinterpret_cast<char*>(node) + nodeSize(node->kind);
+}
+
+
+const char* RadixTreeSet::prefixOf(const Node* node) noexcept
+{
+    return reinterpret_cast<const char*>(node) + nodeSize(node->kind);
+}
+
+
+RadixTreeSet::Node* const* RadixTreeSet::findChild(const Node* node, unsigned char c) noexcept
+{
+    return findChild(const_cast<Node*>(node), c);
+}
+
+
+RadixTreeSet::Node** RadixTreeSet::findChild(Node* node, unsigned char c) noexcept
+{
+    switch (node->kind)
+    {
+    case Kind::Node0:
+        return nullptr;
+
+    case Kind::Node4:
+    {
+        Node4* node4 = static_cast<Node4*>(node);
+
+        for (unsigned int i = 0; i < node4->childCount; ++i)
+        {
+            if (node4->keys[i] == c)
+            {
+                return &node4->children[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    case Kind::Node16:
+    {
+        Node16* node16 = static_cast<Node16*>(node);
+
+#if defined(__SSE2__)
+        // All 16 keys are compared at once; only the first childCount of
+        // the results count.
+        __m128i matches = _mm_cmpeq_epi8(
+            _mm_set1_epi8(static_cast<char>(c)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(node16->keys)));
+
+        unsigned int mask =
+            static_cast<unsigned int>(_mm_movemask_epi8(matches)) & ((1u << node16->childCount) - 1);
+
+        return mask != 0 ? &node16->children[lowestBit(mask)] : nullptr;
+#else
+        for (unsigned int i = 0; i < node16->childCount; ++i)
+        {
+            if (node16->keys[i] == c)
+            {
+                return &node16->children[i];
+            }
+        }
+
+        return nullptr;
+#endif
+    }
+
+    case Kind::Node48:
+    {
+        Node48* node48 = static_cast<Node48*>(node);
+        unsigned int index = node48->childIndex[c];
+        return index != 0 ? &node48->children[index - 1] : nullptr;
+    }
+
+    default:
+    {
+        Node256* node256 = static_cast<Node256*>(node);
+        return node256->children[c] != nullptr ? &node256->children[c] : nullptr;
+    }
+    }
+}
+
+
+void RadixTreeSet::addChild(Node* node, unsigned char c, Node* child) noexcept
+{
+    // The node is assumed to have room for another child, and not to have
+    // one for the given character already.
+    switch (node->kind)
+    {
+    case Kind::Node4:
+    case Kind::Node16:
+    {
+        unsigned char* keys;
+        Node** children;
+
+        if (node->kind == Kind::Node4)
+        {
+            keys = static_cast<Node4*>(node)->keys;
+            children = static_cast<Node4*>(node)->children;
+        }
+        else
+        {
+            keys = static_cast<Node16*>(node)->keys;
+            children = static_cast<Node16*>(node)->children;
+        }
+
+        unsigned int i = node->childCount;
+
+        for (; i > 0 && keys[i - 1] > c; --i)
+        {
+            keys[i] = keys[i - 1];
+            children[i] = children[i - 1];
+        }
+
+        keys[i] = c;
+        children[i] = child;
+        break;
+    }
+
+    case Kind::Node48:
+    {
+        Node48* node48 = static_cast<Node48*>(node);
+        node48->children[node48->childCount] = child;
+        node48->childIndex[c] = static_cast<unsigned char>(node48->childCount + 1);
+        break;
+    }
+
+    case Kind::Node256:
+        static_cast<Node256*>(node)->children[c] = child;
+        break;
+
+    default:
+        return;
+    }
+
+    ++node->childCount;
+}
+
+
+template <typename ChildFunction>
+void RadixTreeSet::forEachChild(const Node* node, ChildFunction f)
+{
+    // The children are visited in ascending order of their characters,
+    // compared as unsigned values, which is the order std::string uses.
+    switch (node->kind)
+    {
+    case Kind::Node0:
+        break;
+
+    case Kind::Node4:
+    {
+        const Node4* node4 = static_cast<const Node4*>(node);
+
+        for (unsigned int i = 0; i < node4->childCount; ++i)
+        {
+            f(node4->keys[i], node4->children[i]);
+        }
+
+        break;
+    }
+
+    case Kind::Node16:
+    {
+        const Node16* node16 = static_cast<const Node16*>(node);
+
+        for (unsigned int i = 0; i < node16->childCount; ++i)
+        {
+            f(node16->keys[i], node16->children[i]);
+        }
+
+        break;
+    }
+
+    case Kind::Node48:
+    {
+        const Node48* node48 = static_cast<const Node48*>(node);
+
+        for (unsigned int c = 0; c < 256; ++c)
+        {
+            if (node48->childIndex[c] != 0)
+            {
+                f(static_cast<unsigned char>(c), node48->children[node48->childIndex[c] - 1]);
+            }
+        }
+
+        break;
+    }
+
+    default:
+    {
+        const Node256* node256 = static_cast<const Node256*>(node);
+
+        for (unsigned int c = 0; c < 256; ++c)
+        {
+            if (node256->children[c] != nullptr)
+            {
+                f(static_cast<unsigned char>(c), node256->children[c]);
+            }
+        }
+
+        break;
+    }
+    }
+}
+
+
+RadixTreeSet::Kind RadixTreeSet::nextLargerKind(Kind kind) noexcept
+{
+    switch (kind)
+    {
+    case Kind::Node0:
+        return Kind::Node4;
+
+    case Kind::Node4:
+        return Kind::Node16;
+
+    case Kind::Node16:
+        return Kind::Node48;
+
+    default:
+        return Kind::Node256;
+    }
+}
+
+
+RadixTreeSet::Node* RadixTreeSet::rebuild(
+    Node* node, Kind kind, const char* prefix, std::size_t prefixLength)
+{
+    // Replaces a node with a new one of the given kind and prefix (which
+    // may be part of the old node's own prefix, so it's copied before the
+    // old node is destroyed), moving its children into the new one.
+    Node* replacement = createNode(kind, prefix, prefixLength, node->isWord);
+
+    forEachChild(
+        node,
+        [replacement](unsigned char c, Node* child)
+        {
+            addChild(replacement, c, child);
+        });
+
+    destroyNode(node);
+    return replacement;
+}
+
+
+void RadixTreeSet::visitSubtree(const Node* node, std::string& path, const VisitFunction& visit)
+{
+    std::size_t pathLength = path.length();
+    path.append(prefixOf(node), node->prefixLength);
+
+    // A word ending at a node is a prefix of every word below it, so it
+    // comes before all of them.
+    if (node->isWord)
+    {
+        visit(path);
+    }
+
+    forEachChild(
+        node,
+        [&path, &visit](unsigned char c, const Node* child)
+        {
+            path.push_back(static_cast<char>(c));
+            visitSubtree(child, path, visit);
+            path.pop_back();
+        });
+
+    path.resize(pathLength);
+}
+
+
+void RadixTreeSet::measure(const Node* node, SetMemoryUsage& usage) noexcept
+{
+    usage.nodeBytes += nodeSize(node->kind) + node->prefixLength;
+
+    forEachChild(node, [&usage](unsigned char, const Node* child) { measure(child, usage); });
+}
@@ -0,0 +1,175 @@
+// RadixTreeSet.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A RadixTreeSet is a Set of strings stored in a compressed radix tree (a
+// trie), in the style of the "adaptive radix tree" (ART).  Rather than
+// storing each string whole and comparing strings against one another, it
+// stores each string as a path from the root, one character per edge, so
+// strings that share a prefix share the nodes along it.  Looking up a
+// string of length m takes O(m) time, no matter how many strings there
+// are, and never compares the string against anything but the characters
+// along its own path.
+//
+// Two things keep the tree small:
+//
+// * Path compression.  A chain of nodes that each have only one child
+//   and don't end a word is collapsed into a single node, which stores
+//   the chain's characters as its "prefix."  (In a dictionary, most of
+//   the tree is such chains -- the tails of words that no other word
+//   shares -- so most nodes are leaves whose prefix is the rest of a
+//   word.)  The prefix is stored in the same allocation as the node,
+//   right after it.
+// * Adaptive nodes.  A node has room for 0, 4, 16, 48, or 256 children,
+//   and is replaced by the next larger kind when it runs out of room:
+//     - Node0 is a leaf.
+//     - Node4 and Node16 keep sorted arrays of the characters on their
+//       edges alongside the children; a Node16 is searched for a character
+//       with SSE2 instructions, when they're available, and a simple loop
+//       otherwise.
+//     - Node48 has a 256-entry table mapping every character to one of
+//       its 48 children (or to none).
+//     - Node256 has one child pointer for every character.
+//   Since most nodes have few children, most nodes are small.
+//
+// Every node has a flag saying whether the path to it (including its
+// prefix) spells a word in the set; that's how a word that's a prefix of
+// another -- "BO" and "BOO" -- is distinguished from one that isn't.
+//
+// Because the tree is ordered by character, it can also visit every word
+// beginning with a given prefix, in ascending order, in time proportional
+// to the prefix's length plus the size of the part of the tree below it.
+
+#ifndef RADIXTREESET_HPP
+#define RADIXTREESET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "Set.hpp"
+
+
+
+class RadixTreeSet : public Set<std::string>
+{
+public:
+    // A VisitFunction is a function that takes a reference to a const
+    // std::string and returns no value.
+    using VisitFunction = std::function<void(const std::string&)>;
+
+public:
+    // Initializes a RadixTreeSet to be empty.
+    RadixTreeSet();
+
+    // Cleans up the RadixTreeSet so that it leaks no memory.
+    ~RadixTreeSet() noexcept override;
+
+    // Initializes a new RadixTreeSet to be a copy of an existing one.
+    RadixTreeSet(const RadixTreeSet& s);
+
+    // Initializes a new RadixTreeSet whose contents are moved from an
+    // expiring one.
+    RadixTreeSet(RadixTreeSet&& s) noexcept;
+
+    // Assigns an existing RadixTreeSet into another.
+    RadixTreeSet& operator=(const RadixTreeSet& s);
+
+    // Assigns an expiring RadixTreeSet into another.
+    RadixTreeSet& operator=(RadixTreeSet&& s) noexcept;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  This function runs in O(m) time,
+    // where m is the length of the element.
+    void add(const std::string& element) override;
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  This function runs in O(m) time, where m is the
+    // length of the element.
+    bool contains(const std::string& element) const override;
+
+
+    using Set<std::string>::contains;
+
+
+    // size() returns the number of elements in the set.
+    unsigned int size() const noexcept override;
+
+
+    // forEachWithPrefix() calls the given "visit" function for each of the
+    // elements in the set that begin with the given prefix (including the
+    // prefix itself, if it's in the set), in ascending order.  Every
+    // element begins with the empty string, so an empty prefix visits all
+    // of them.
+    void forEachWithPrefix(const std::string& prefix, VisitFunction visit) const;
+
+
+    // memoryUsage() reports the tree's nodes, including the prefixes
+    // stored after them, as nodeBytes.  The elements aren't stored
+    // anywhere else, so there are no keyBytes.
+    SetMemoryUsage memoryUsage() const override;
+
+
+private:
+    // The kinds of nodes, named for how many children they have room for.
+    enum class Kind : std::uint8_t
+    {
+        Node0,
+        Node4,
+        Node16,
+        Node48,
+        Node256
+    };
+
+    // Every kind of node begins with a Node, which is followed by the
+    // kind-specific parts and then by prefixLength characters.
+    struct Node
+    {
+        Kind kind;
+        bool isWord;
+        std::uint16_t childCount;
+        std::uint32_t prefixLength;
+    };
+
+    struct Node4;
+    struct Node16;
+    struct Node48;
+    struct Node256;
+
+    Node* root;
+    unsigned int size_;
+
+private:
+    static Node* createNode(Kind kind, const char* prefix, std::size_t prefixLength, bool isWord);
+    static void destroyNode(Node* node) noexcept;
+    static void destroySubtree(Node* node) noexcept;
+    static Node* copySubtree(const Node* node);
+
+    static std::size_t nodeSize(Kind kind) noexcept;
+    static std::size_t capacity(Kind kind) noexcept;
+    static char* prefixOf(Node* node) noexcept;
+    static const char* prefixOf(const Node* node) noexcept;
+
+    static Node* const* findChild(const Node* node, unsigned char c) noexcept;
+    static Node** findChild(Node* node, unsigned char c) noexcept;
+    static void addChild(Node* node, unsigned char c, Node* child) noexcept;
+
+    template <typename ChildFunction>
+    static void forEachChild(const Node* node, ChildFunction f);
+
+    static Kind nextLargerKind(Kind kind) noexcept;
+    static Node* rebuild(Node* node, Kind kind, const char* prefix, std::size_t prefixLength);
+
+    static void visitSubtree(const Node* node, std::string& path, const VisitFunction& visit);
+    static void measure(const Node* node, SetMemoryUsage& usage) noexcept;
+};
+
+
+
+#endif // RADIXTREESET_HPP
@@ -0,0 +1,533 @@
+// RobinHoodHashSet.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A RobinHoodHashSet is an implementation of a Set that is an open-addressing
+// hash table using "Robin Hood" linear probing.  Unlike HashSet, there are no
+// linked lists: every element lives directly in one array cell, and when the
+// cell an element hashes to (its "home") is taken, it's stored in one of the
+// cells after it instead.  How far an element ended up from its home is its
+// "probe length."
+//
+// The Robin Hood rule is that, while an element is being inserted, it takes
+// the cell of any element it meets that is closer to its own home than the
+// new element is to its home; the displaced element then continues along
+// the table in its place.  This keeps probe lengths short and remarkably
+// even, and it means a search can stop as soon as it meets an element that
+// is closer to home than the one being searched for would be at that point.
+//
+// Unlike the other sets, a RobinHoodHashSet also supports remove().  It uses
+// "backward-shift deletion": after an element is removed, the elements that
+// follow it are each shifted back one cell, until reaching an empty cell or
+// an element already in its home.  So no "tombstones" are left behind, and
+// probe lengths after many removals are as short as if the remaining
+// elements had been inserted into a fresh table.
+//
+// The capacity is always a power of two.  The table doubles when it would
+// become more than 90% full, or when an insertion would give some element
+// a probe length longer than MAX_PROBE_LENGTH, so as long as the hash
+// function spreads elements out at all, every probe length is bounded by
+// that constant.  (A hash function that sends many elements to the same
+// value can't be helped by a bigger table, so once the table is less than
+// a quarter full, long probes no longer make it grow; those elements are
+// simply stored further along.  Probe lengths are stored in 16 bits, so
+// no more than about 65,000 elements can share a hash value.)
+
+#ifndef ROBINHOODHASHSET_HPP
+#define ROBINHOODHASHSET_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include "Set.hpp"
+
+
+
+template <typename ElementType>
+class RobinHoodHashSet : public Set<ElementType>
+{
+public:
+    // The default capacity of the RobinHoodHashSet before anything has
+    // been added to it.
+    static constexpr unsigned int DEFAULT_CAPACITY = 16;
+
+    // No element is ever stored more than this many cells past its home.
+    // (Probe lengths are counted from 1, with 1 meaning "in its home.")
+    static constexpr unsigned int MAX_PROBE_LENGTH = 64;
+
+    // A HashFunction is a function that takes a reference to a const
+    // ElementType and returns an unsigned int.
+    using HashFunction = std::function<unsigned int(const ElementType&)>;
+
+    // ProbeStatistics summarizes the probe lengths of the elements
+    // currently in the set.
+    struct ProbeStatistics
+    {
+        unsigned int maxProbeLength;
+        double averageProbeLength;
+    };
+
+public:
+    // Initializes a RobinHoodHashSet to be empty, so that it will use the
+    // given hash function whenever it needs to hash an element.
+    explicit RobinHoodHashSet(HashFunction hashFunction);
+
+    // Cleans up the RobinHoodHashSet so that it leaks no memory.
+    ~RobinHoodHashSet() noexcept override;
+
+    // Initializes a new RobinHoodHashSet to be a copy of an existing one.
+    RobinHoodHashSet(const RobinHoodHashSet& s);
+
+    // Initializes a new RobinHoodHashSet whose contents are moved from an
+    // expiring one.  The expiring one is left empty, with no table at all,
+    // but can still be used; its table is allocated when it's next added
+    // to.
+    RobinHoodHashSet(RobinHoodHashSet&& s) noexcept;
+
+    // Assigns an existing RobinHoodHashSet into another.
+    RobinHoodHashSet& operator=(const RobinHoodHashSet& s);
+
+    // Assigns an expiring RobinHoodHashSet into another.
+    RobinHoodHashSet& operator=(RobinHoodHashSet&& s) noexcept;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  It runs in amortized constant time
+    // (assuming a good hash function).
+    void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  It looks at no more cells than the longest probe
+    // length in the table.
+    bool contains(const ElementType& element) const override;
+
+
+    using Set<ElementType>::contains;
+
+
+    // remove() removes the given element from the set, returning true if
+    // it was there and false (with no effect) if it wasn't.  It runs in
+    // constant time (assuming a good hash function).
+    bool remove(const ElementType& element);
+
+
+    // size() returns the number of elements in the set.
+    unsigned int size() const noexcept override;
+
+
+    // capacity() returns the number of cells in the table.
+    unsigned int capacity() const noexcept;
+
+
+    // probeStatistics() returns the longest and average probe lengths of
+    // the elements in the set.  Both are 0 if the set is empty.
+    ProbeStatistics probeStatistics() const noexcept;
+
+
+    // memoryUsage() reports the table of cells as bucketBytes (the
+    // elements are stored directly in it) along with the probe lengths
+    // stored alongside them.
+    SetMemoryUsage memoryUsage() const override;
+
+
+private:
+    HashFunction hashFunction;
+
+    // The cells are two parallel arrays: the elements, which are only
+    // constructed in cells that are occupied, and each cell's probe
+    // length, which is 0 for an empty cell.
+    ElementType* elements;
+    std::uint16_t* probeLengths;
+    unsigned int capacity_;
+    unsigned int size_;
+
+    // The home of an element is the top log2(capacity) bits of its
+    // scrambled hash, so this is 32 - log2(capacity).
+    unsigned int homeShift;
+
+private:
+    void allocate(unsigned int capacity);
+    void destroyAll() noexcept;
+    unsigned int homeOf(const ElementType& element) const;
+    int find(const ElementType& element) const;
+    void insertNew(ElementType element);
+    void grow();
+};
+
+
+
+template <typename ElementType>
+RobinHoodHashSet<ElementType>::RobinHoodHashSet(HashFunction hashFunction)
+    : hashFunction{hashFunction}, elements{nullptr}, probeLengths{nullptr},
+      capacity_{0}, size_{0}, homeShift{32}
+{
+    allocate(DEFAULT_CAPACITY);
+}
+
+
+template <typename ElementType>
+RobinHoodHashSet<ElementType>::~RobinHoodHashSet() noexcept
+{
+    destroyAll();
+}
+
+
+template <typename ElementType>
+RobinHoodHashSet<ElementType>::RobinHoodHashSet(const RobinHoodHashSet& s)
+    : hashFunction{s.hashFunction}, elements{nullptr}, probeLengths{nullptr},
+      capacity_{0}, size_{0}, homeShift{32}
+{
+    allocate(s.capacity_);
+
+    try
+    {
+        for (unsigned int i = 0; i < capacity_; ++i)
+        {
+            if (s.probeLengths[i] != 0)
+            {
+                new (&elements[i]) ElementType{s.elements[i]};
+                probeLengths[i] = s.probeLengths[i];
+                ++size_;
+            }
+        }
+    }
+    catch (...)
+    {
+        destroyAll();
+        throw;
+    }
+}
+
+
+template <typename ElementType>
+RobinHoodHashSet<ElementType>::RobinHoodHashSet(RobinHoodHashSet&& s) noexcept
+    : hashFunction{s.hashFunction}, elements{nullptr}, probeLengths{nullptr},
+      capacity_{0}, size_{0}, homeShift{32}
+{
+    std::swap(elements, s.elements);
+    std::swap(probeLengths, s.probeLengths);
+    std::swap(capacity_, s.capacity_);
+    std::swap(size_, s.size_);
+    std::swap(homeShift, s.homeShift);
+}
+
+
+template <typename ElementType>
+RobinHoodHashSet<ElementType>& RobinHoodHashSet<ElementType>::operator=(const RobinHoodHashSet& s)
+{
+    if (this != &s)
+    {
+        RobinHoodHashSet copy{s};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType>
+RobinHoodHashSet<ElementType>& RobinHoodHashSet<ElementType>::operator=(RobinHoodHashSet&& s) noexcept
+{
+    std::swap(hashFunction, s.hashFunction);
+    std::swap(elements, s.elements);
+    std::swap(probeLengths, s.probeLengths);
+    std::swap(capacity_, s.capacity_);
+    std::swap(size_, s.size_);
+    std::swap(homeShift, s.homeShift);
+    return *this;
+}
+
+
+template <typename ElementType>
+bool RobinHoodHashSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void RobinHoodHashSet<ElementType>::add(const ElementType& element)
+{
+    if (find(element) >= 0)
+    {
+        return;
+    }
+
+    if (size_ + 1 > capacity_ * 0.9)
+    {
+        grow();
+    }
+
+    insertNew(element);
+}
+
+
+template <typename ElementType>
+bool RobinHoodHashSet<ElementType>::contains(const ElementType& element) const
+{
+    return find(element) >= 0;
+}
+
+
+template <typename ElementType>
+bool RobinHoodHashSet<ElementType>::remove(const ElementType& element)
+{
+    int found = find(element);
+
+    if (found < 0)
+    {
+        return false;
+    }
+
+    unsigned int mask = capacity_ - 1;
+    unsigned int hole = static_cast<unsigned int>(found);
+    unsigned int next = (hole + 1) & mask;
+
+    // Shift each following element back one cell (which brings it one
+    // cell closer to home) until reaching an empty cell or an element
+    // that's already home and so can't move any closer.
+    while (probeLengths[next] > 1)
+    {
+        elements[hole] = std::move(elements[next]);
+        probeLengths[hole] = probeLengths[next] - 1;
+
+        hole = next;
+        next = (next + 1) & mask;
+    }
+
+    elements[hole].~ElementType();
+    probeLengths[hole] = 0;
+    --size_;
+
+    return true;
+}
+
+
+template <typename ElementType>
+unsigned int RobinHoodHashSet<ElementType>::size() const noexcept
+{
+    return size_;
+}
+
+
+template <typename ElementType>
+unsigned int RobinHoodHashSet<ElementType>::capacity() const noexcept
+{
+    return capacity_;
+}
+
+
+template <typename ElementType>
+typename RobinHoodHashSet<ElementType>::ProbeStatistics
+RobinHoodHashSet<ElementType>::probeStatistics() const noexcept
+{
+    ProbeStatistics statistics{0, 0.0};
+    unsigned long long total = 0;
+
+    for (unsigned int i = 0; i < capacity_; ++i)
+    {
+        if (probeLengths[i] > statistics.maxProbeLength)
+        {
+            statistics.maxProbeLength = probeLengths[i];
+        }
+
+        total += probeLengths[i];
+    }
+
+    if (size_ > 0)
+    {
+        statistics.averageProbeLength = static_cast<double>(total) / size_;
+    }
+
+    return statistics;
+}
+
+
+template <typename ElementType>
+SetMemoryUsage RobinHoodHashSet<ElementType>::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+    usage.bucketBytes = capacity_ * (sizeof(ElementType) + sizeof(std::uint16_t));
+
+    for (unsigned int i = 0; i < capacity_; ++i)
+    {
+        if (probeLengths[i] != 0)
+        {
+            usage.keyBytes += elementHeapBytes(elements[i]);
+        }
+    }
+
+    return usage;
+}
+
+
+template <typename ElementType>
+void RobinHoodHashSet<ElementType>::allocate(unsigned int capacity)
+{
+    // Both arrays are allocated before any member is changed, so that if
+    // either allocation fails, the set is left with the table it had (and
+    // the other array isn't leaked).
+    std::unique_ptr<std::uint16_t[]> newProbeLengths{new std::uint16_t[capacity]{}};
+
+    elements = static_cast<ElementType*>(
+        ::operator new(capacity * sizeof(ElementType), std::align_val_t{alignof(ElementType)}));
+
+    probeLengths = newProbeLengths.release();
+    capacity_ = capacity;
+    homeShift = 32;
+
+    while ((1u << (32 - homeShift)) < capacity)
+    {
+        --homeShift;
+    }
+}
+
+
+template <typename ElementType>
+void RobinHoodHashSet<ElementType>::destroyAll() noexcept
+{
+    if (elements == nullptr)
+    {
+        return;
+    }
+
+    for (unsigned int i = 0; i < capacity_; ++i)
+    {
+        if (probeLengths[i] != 0)
+        {
+            elements[i].~ElementType();
+        }
+    }
+
+    ::operator delete(elements, std::align_val_t{alignof(ElementType)});
+    delete[] probeLengths;
+
+    elements = nullptr;
+    probeLengths = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+}
+
+
+template <typename ElementType>
+unsigned int RobinHoodHashSet<ElementType>::homeOf(const ElementType& element) const
+{
+    // A multiplicative (Fibonacci) scramble, keeping the high-order bits,
+    // so that hash functions whose low-order bits are poorly distributed
+    // still spread elements evenly over a power-of-two table.
+    unsigned int scrambled = hashFunction(element) * 2654435769u;
+    return scrambled >> homeShift;
+}
+
+
+template <typename ElementType>
+int RobinHoodHashSet<ElementType>::find(const ElementType& element) const
+{
+    // A set that's been moved from has no table, so there's nowhere for
+    // the element to be.
+    if (capacity_ == 0)
+    {
+        return -1;
+    }
+
+    unsigned int mask = capacity_ - 1;
+    unsigned int index = homeOf(element);
+
+    // An element whose probe length is shorter than the one we'd have at
+    // this point would have been displaced by us if we were present, so
+    // once we see one (or an empty cell, whose probe length is 0), we can
+    // stop looking.
+    for (unsigned int probeLength = 1; probeLength <= probeLengths[index]; ++probeLength)
+    {
+        if (probeLengths[index] == probeLength && elements[index] == element)
+        {
+            return static_cast<int>(index);
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    return -1;
+}
+
+
+template <typename ElementType>
+void RobinHoodHashSet<ElementType>::insertNew(ElementType element)
+{
+    unsigned int mask = capacity_ - 1;
+    unsigned int index = homeOf(element);
+    unsigned int probeLength = 1;
+
+    while (true)
+    {
+        if (probeLengths[index] == 0)
+        {
+            new (&elements[index]) ElementType{std::move(element)};
+            probeLengths[index] = static_cast<std::uint16_t>(probeLength);
+            ++size_;
+            return;
+        }
+
+        if (probeLengths[index] < probeLength)
+        {
+            // Take from the rich (close to home) and give to the poor;
+            // the displaced element continues along the table in our place.
+            std::swap(element, elements[index]);
+
+            unsigned int displacedProbeLength = probeLengths[index];
+            probeLengths[index] = static_cast<std::uint16_t>(probeLength);
+            probeLength = displacedProbeLength;
+        }
+
+        index = (index + 1) & mask;
+        ++probeLength;
+
+        if ((probeLength > MAX_PROBE_LENGTH && size_ >= capacity_ / 4)
+            || probeLength == UINT16_MAX)
+        {
+            // Every element except the one we're carrying is in a valid
+            // position, so it's safe to grow the table and then insert the
+            // carried element into the new one.
+            grow();
+            insertNew(std::move(element));
+            return;
+        }
+    }
+}
+
+
+template <typename ElementType>
+void RobinHoodHashSet<ElementType>::grow()
+{
+    ElementType* oldElements = elements;
+    std::uint16_t* oldProbeLengths = probeLengths;
+    unsigned int oldCapacity = capacity_;
+
+    allocate(oldCapacity == 0 ? DEFAULT_CAPACITY : oldCapacity * 2);
+    size_ = 0;
+
+    for (unsigned int i = 0; i < oldCapacity; ++i)
+    {
+        if (oldProbeLengths[i] != 0)
+        {
+            insertNew(std::move(oldElements[i]));
+            oldElements[i].~ElementType();
+        }
+    }
+
+    ::operator delete(oldElements, std::align_val_t{alignof(ElementType)});
+    delete[] oldProbeLengths;
+}
+
+
+
+#endif // ROBINHOODHASHSET_HPP
+
@@ -12,25 +12,50 @@
 // nodes, with pointers connecting them.  You can, however, use other parts of
 // the C++ Standard Library -- including <random>, notably.
 //
-// Each node should contain only two pointers: one to the node that follows it
-// on the same level and another to the equivalent node on the level below it.
-// Additional pointers use more memory but don't enable any techniques not
-// enabled by the other two.
+// The nodes are laid out the way Pugh originally described: rather than
+// one node per level per element, linked to its neighbors above and below,
+// each element has exactly one node, holding a single copy of the element
+// and an array of forward pointers, one for each level the element is on.
+// So an element on k + 1 levels costs one allocation instead of k + 1, a
+// search moves down a level without following a pointer, and most of the
+// nodes (the ones only on level 0) hold just one pointer.  The -INF tower
+// is an array of levels held by the SkipListSet itself, and +INF is simply
+// a null forward pointer.
+//
+// Searches can also be "finger searches": a Finger remembers the path taken
+// by the most recent search made with it -- the last node before the
+// element on every level -- and the next search made with it starts from
+// there, moving up only as many levels as it needs to get past the distance
+// between the two elements, rather than starting over from the top of the
+// -INF tower.  A search for an element d positions away from the previous
+// one takes O(log d) time, so a sorted batch of n lookups (such as the
+// words of a sorted document) takes O(n) time in all, rather than
+// O(n log n).  A Finger belongs to whoever searches with it, not to the
+// set, so contains() and the other const member functions never change the
+// set, and any number of threads can search it at once, each with its own
+// Finger or with none.  add() keeps a finger of its own, so adding a
+// sorted batch of n elements (such as a sorted word file being loaded)
+// takes O(n) time, too.
 //
 // A couple of utilities are included here: SkipListKind and SkipListKey.
-// You can feel free to use these as-is and probably will not need to
-// modify them, though you can make changes to them, if you'd like.
+// The node layout doesn't need them, since -INF and +INF are never stored
+// as keys, but they're kept for anyone who wants to compare keys that way.
 
 #ifndef SKIPLISTSET_HPP
 #define SKIPLISTSET_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
 #include <memory>
+#include <new>
 #include <random>
+#include <utility>
 #include "Set.hpp"
 
 
-#include <iostream>
-
 // SkipListKind indicates a kind of key: a normal one, the special key
 // -INF, or the special key +INF.  It's necessary for us to implement
 // the notion of -INF and +INF separately, since we're building a class
@@ -60,7 +85,7 @@ public:
     SkipListKey(SkipListKind kind) : kind{kind} {
     }
 
-    ElementType getElement() { return element; }
+    const ElementType& getElement() const { return element; }
 
     bool operator==(const SkipListKey& other) const;
     bool operator<(const SkipListKey& other) const;
@@ -108,12 +133,17 @@ bool SkipListKey<ElementType>::operator<(const SkipListKey& other) const
 // The SkipListLevelTester class represents the ability to decide whether
 // a key placed on one level of the skip list should also occupy the next
 // level.  This is the "coin flip," so to speak.  Note that this is an
-// abstract base class with one implementation, RandomSkipListLevelTester,
-// just below it.  RandomSkipListLevelTester is what it sounds like: It
-// makes the decision at random (with a 50/50 chance of deciding whether
-// a key should occupy the next level).  However, by setting things up
-// this way, we have a way to control things more carefully in our
-// testing (as you can, as well).
+// abstract base class with two implementations just below it.
+// RandomSkipListLevelTester is what it sounds like: It makes the decision
+// at random (with a 50/50 chance of deciding whether a key should occupy
+// the next level).  GeometricSkipListLevelTester makes the same kind of
+// decision much more cheaply, and is what a SkipListSet uses by default.
+// However, by setting things up this way, we have a way to control things
+// more carefully in our testing (as you can, as well).
+//
+// A skip list asks for all of a new key's coin flips at once, by calling
+// chooseHeight().  Unless a level tester overrides it, chooseHeight()
+// calls shouldOccupyNextLevel() until it returns false.
 //
 // DO NOT MAKE CHANGES TO THE SIGNATURES OF THE MEMBER FUNCTIONS OF
 // THE "level tester" CLASSES.  You can add new member functions or even
@@ -129,9 +159,28 @@ public:
 
     virtual bool shouldOccupyNextLevel(const ElementType& element) = 0;
     virtual std::unique_ptr<SkipListLevelTester<ElementType>> clone() = 0;
+
+    // chooseHeight() returns the number of levels, at least 1 and at most
+    // maxHeight, that a new key should occupy.
+    virtual unsigned int chooseHeight(const ElementType& element, unsigned int maxHeight);
 };
 
 
+template <typename ElementType>
+unsigned int SkipListLevelTester<ElementType>::chooseHeight(
+    const ElementType& element, unsigned int maxHeight)
+{
+    unsigned int height = 1;
+
+    while (height < maxHeight && shouldOccupyNextLevel(element))
+    {
+        ++height;
+    }
+
+    return height;
+}
+
+
 template <typename ElementType>
 class RandomSkipListLevelTester : public SkipListLevelTester<ElementType>
 {
@@ -170,10 +219,169 @@ std::unique_ptr<SkipListLevelTester<ElementType>> RandomSkipListLevelTester<Elem
 
 
 
+// A GeometricSkipListLevelTester chooses a key's whole height from a single
+// 64-bit random number, rather than flipping one coin per level: each bit
+// of a random number is a fair coin flip, so the number of trailing zero
+// bits is the number of flips that came up "heads" before the first
+// "tails," and counting them takes one instruction.  The random numbers
+// come from SplitMix64, which is a handful of shifts, xors, and multiplies.
+//
+// The probability that a key on one level also occupies the next one is
+// 1 / 2^log2Branching: 1/2 by default, or 1/4 with log2Branching = 2,
+// which gives a skip list with fewer levels and fewer forward pointers
+// per key, at the cost of a few more comparisons per level during a
+// search.  No key is given more than maxHeight levels.
+//
+// shouldOccupyNextLevel() still works, one flip at a time, for anyone
+// who asks for flips that way; it chooses a height when asked for the
+// first flip of a key, then answers the remaining flips from that.
+
+template <typename ElementType>
+class GeometricSkipListLevelTester : public SkipListLevelTester<ElementType>
+{
+public:
+    static constexpr unsigned int DEFAULT_MAX_HEIGHT = 32;
+
+    explicit GeometricSkipListLevelTester(
+        unsigned int log2Branching = 1, unsigned int maxHeight = DEFAULT_MAX_HEIGHT);
+
+    GeometricSkipListLevelTester(
+        unsigned int log2Branching, unsigned int maxHeight, std::uint64_t seed);
+
+    bool shouldOccupyNextLevel(const ElementType& element) override;
+    std::unique_ptr<SkipListLevelTester<ElementType>> clone() override;
+    unsigned int chooseHeight(const ElementType& element, unsigned int maxHeight) override;
+
+private:
+    std::uint64_t nextRandom() noexcept;
+    static unsigned int countTrailingZeros(std::uint64_t value) noexcept;
+
+    unsigned int log2Branching;
+    unsigned int maxHeight;
+    std::uint64_t state;
+
+    // While a key's flips are being asked for one at a time, this is how
+    // many more of them should come up true.
+    bool flipping;
+    unsigned int remainingFlips;
+};
+
+
+template <typename ElementType>
+GeometricSkipListLevelTester<ElementType>::GeometricSkipListLevelTester(
+    unsigned int log2Branching, unsigned int maxHeight)
+    : GeometricSkipListLevelTester{
+        log2Branching, maxHeight,
+        (std::uint64_t{std::random_device{}()} << 32) ^ std::random_device{}()}
+{
+}
+
+
+template <typename ElementType>
+GeometricSkipListLevelTester<ElementType>::GeometricSkipListLevelTester(
+    unsigned int log2Branching, unsigned int maxHeight, std::uint64_t seed)
+    : log2Branching{log2Branching < 1 ? 1 : log2Branching},
+      maxHeight{maxHeight < 1 ? 1 : maxHeight}, state{seed},
+      flipping{false}, remainingFlips{0}
+{
+}
+
+
+template <typename ElementType>
+bool GeometricSkipListLevelTester<ElementType>::shouldOccupyNextLevel(const ElementType& element)
+{
+    if (!flipping)
+    {
+        remainingFlips = chooseHeight(element, maxHeight) - 1;
+        flipping = true;
+    }
+
+    if (remainingFlips > 0)
+    {
+        --remainingFlips;
+        return true;
+    }
+
+    flipping = false;
+    return false;
+}
+
+
+template <typename ElementType>
+std::unique_ptr<SkipListLevelTester<ElementType>> GeometricSkipListLevelTester<ElementType>::clone()
+{
+    return std::unique_ptr<SkipListLevelTester<ElementType>>{
+        new GeometricSkipListLevelTester<ElementType>{log2Branching, maxHeight, nextRandom()}};
+}
+
+
+template <typename ElementType>
+unsigned int GeometricSkipListLevelTester<ElementType>::chooseHeight(
+    const ElementType& element, unsigned int maxHeight)
+{
+    unsigned int height = 1 + countTrailingZeros(nextRandom()) / log2Branching;
+
+    if (maxHeight > this->maxHeight)
+    {
+        maxHeight = this->maxHeight;
+    }
+
+    return height < maxHeight ? height : maxHeight;
+}
+
+
+template <typename ElementType>
+std::uint64_t GeometricSkipListLevelTester<ElementType>::nextRandom() noexcept
+{
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+
+template <typename ElementType>
+unsigned int GeometricSkipListLevelTester<ElementType>::countTrailingZeros(std::uint64_t value) noexcept
+{
+    if (value == 0)
+    {
+        return 64;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_ctzll(value));
+#else
+    unsigned int count = 0;
+
+    while ((value & 1) == 0)
+    {
+        value >>= 1;
+        ++count;
+    }
+
+    return count;
+#endif
+}
+
 
 template <typename ElementType>
 class SkipListSet : public Set<ElementType>
 {
+public:
+    // A VisitFunction is a function that takes a reference to a const
+    // ElementType and returns no value.
+    using VisitFunction = std::function<void(const ElementType&)>;
+
+    using ElementView = typename Set<ElementType>::ElementView;
+
+    // A Finger is where a finger search begins: the path taken by the most
+    // recent search made with it.  A new Finger begins at the top of the
+    // -INF tower.  A Finger can be used with only one set at a time; using
+    // it with another set, or with the same set after it's been assigned
+    // to or moved from, starts it over from the top.  It mustn't be used
+    // with a set that's since been destroyed.
+    class Finger;
+
 public:
     // Initializes an SkipListSet to be empty, with or without a
     // "level tester" object that will decide, whenever a "coin flip"
@@ -188,7 +396,9 @@ public:
     SkipListSet(const SkipListSet& s);
 
     // Initializes a new SkipListSet whose contents are moved from an
-    // expiring one.
+    // expiring one.  The expiring one is left empty, with no levels and no
+    // level tester, but can still be used; adding to it gives it a level
+    // and a GeometricSkipListLevelTester.
     SkipListSet(SkipListSet&& s) noexcept;
 
     // Assigns an existing SkipListSet into another.
@@ -217,6 +427,39 @@ public:
     bool contains(const ElementType& element) const override;
 
 
+    // This contains() searches for a view of an element in the same way,
+    // comparing the view with the elements directly rather than copying it.
+    bool contains(ElementView element) const override;
+
+
+    using Set<ElementType>::contains;
+
+
+    // containsFrom() returns the same result as contains(), but searches
+    // from the given Finger, leaving it at the element afterward.  The
+    // element can be of any type that can be compared with the elements
+    // using < and ==.
+    template <typename Key>
+    bool containsFrom(Finger& finger, const Key& element) const;
+
+
+    // lowerBound() returns a pointer to the smallest element in the set that
+    // isn't less than the given one, or nullptr if there is no such element.
+    // The pointer remains valid for as long as the SkipListSet exists.  The
+    // second version searches from the given Finger, leaving it at the
+    // element afterward.
+    const ElementType* lowerBound(const ElementType& element) const;
+    const ElementType* lowerBound(Finger& finger, const ElementType& element) const;
+
+
+    // forEachInRange() calls the given "visit" function for each element
+    // that is at least low and less than high, in ascending order.  It
+    // runs in O(log n + k) expected time, where k is the number of
+    // elements visited.
+    void forEachInRange(
+        const ElementType& low, const ElementType& high, VisitFunction visit) const;
+
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
@@ -239,460 +482,739 @@ public:
     // exist, this function returns false.
     bool isElementOnLevel(const ElementType& element, unsigned int level) const;
 
-    void printSkipList() {
-        SkipListNode *h = head, *t = tail;
-        while (h != nullptr) {
-            printLevelList(h, t);
-            h = h->down;
-            t = t->down;
-        }
-    }
+
+    // memoryUsage() reports the nodes (each with its forward pointers) as
+    // nodeBytes and the array of levels, which plays the part of the -INF
+    // tower, as bucketBytes.  nodesPerLevel counts the nodes on each
+    // level, starting from level 0.  The level tester isn't counted.
+    SetMemoryUsage memoryUsage() const override;
+
+
+    // printSkipList() prints the elements on each level, from the top
+    // level down, with a line of dashes after each level.
+    void printSkipList() const;
+
 
 private:
-    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
-    struct SkipListNode {
-        SkipListKey<ElementType> keyValue;
-        SkipListNode *prev, *next, *up, *down;
-
-        SkipListNode(const SkipListKey<ElementType> &kv) 
-            : keyValue(kv) {
-            prev = next = nullptr;
-            up = down = nullptr;
+    // There is one Node per element, no matter how many levels it's on.
+    // Its "height" is the number of levels it's on, and the node is
+    // allocated with room for that many forward pointers immediately
+    // after it: forward()[i] is the next node on level i.  (The height
+    // is aligned like a pointer, so that sizeof(Node) is a multiple of
+    // the alignment of the pointers that follow it.)
+    struct Node
+    {
+        ElementType element;
+        alignas(void*) unsigned int height;
+
+        Node** forward() noexcept
+        {
+            return reinterpret_cast<Node**>(this + 1);
+        }
+
+        Node* const* forward() const noexcept
+        {
+            return reinterpret_cast<Node* const*>(this + 1);
         }
     };
-    int totalNodes;
-    int totalLevel;
 
-    SkipListNode *head, *tail;
+    // Each Level records the first node on it (playing the part of the
+    // -INF key, with nullptr playing the part of +INF) and how many
+    // nodes are on it.
+    struct Level
+    {
+        Node* first;
+        unsigned int size;
+    };
 
-    void clone(const SkipListSet &s);
-    void empty();
-    void insertNode(SkipListNode *p, SkipListNode *q);
-    void addEmptyLevel();
+    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
 
-    SkipListNode* findNode(const SkipListKey<ElementType> &kv) {
-        SkipListNode *p = head;
+    Level* levels;
+    unsigned int levelCount_;
+    unsigned int levelCapacity;
 
-        while (true) {
-            while (p->next != nullptr && p->next->keyValue < kv) {
-                p = p->next;
-            }
+    // add()'s finger: the last node before the most recently added
+    // element on each level (nullptr meaning the beginning of the level),
+    // where the next add() begins its search.  It's always as big as the
+    // array of levels, and every entry is always either nullptr or a node
+    // that's on that entry's level.
+    Node** path;
 
-            if (p->down != nullptr) p = p->down;
-            else break;
-        }
+    unsigned int size_;
 
-        return p;
-    }
+    // version changes whenever the set's nodes are replaced all at once, by
+    // assignment or by being moved from, so that a Finger into the old ones
+    // can be recognized and started over.
+    unsigned long version;
 
-    void initHeadTail() {
-        SkipListKey<ElementType> hk(SkipListKind::NegInf);
-        SkipListKey<ElementType> tk(SkipListKind::PosInf);
+private:
+    static std::size_t nodeBytes(unsigned int height) noexcept;
+    static Node* createNode(const ElementType& element, unsigned int height);
+    static void destroyNode(Node* node) noexcept;
 
-        head = new SkipListNode(hk);
-        tail = new SkipListNode(tk);
-    }
+    void initialize();
+    void destroyAll() noexcept;
+    void copyFrom(const SkipListSet& s);
+    void reserveLevels(unsigned int count);
 
-    void printLevelList(SkipListNode *h, SkipListNode *t) {
-        SkipListNode *p = h->next;
-        while (p != t) {
-            std::cout << p->keyValue.getElement() << std::endl;
-            p = p->next;
-        }
-        std::cout << "---\n";
-    }
+    Node* next(const Node* node, unsigned int level) const noexcept;
+
+    template <typename Key>
+    Node* search(const Key& element) const;
 
+    template <typename Key>
+    Node* searchFrom(Node** path, const Key& element) const;
 
+    template <typename Key>
+    const Node* find(const Key& element) const;
+
+    void prepareFinger(Finger& finger) const;
 };
 
 
+
 template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet()
-    : SkipListSet{std::make_unique<RandomSkipListLevelTester<ElementType>>()} // levelTester
+class SkipListSet<ElementType>::Finger
 {
-    totalNodes = 0;
-    totalLevel = 0;
+public:
+    Finger() noexcept;
+
+private:
+    friend class SkipListSet<ElementType>;
 
-    initHeadTail();
+    const SkipListSet* set;
+    unsigned long version;
+
+    // The path has pathLength entries, laid out the same way as add()'s.
+    std::unique_ptr<Node*[]> path;
+    unsigned int pathLength;
+};
 
-    head->next = tail;
-    tail->prev = head;
+
+template <typename ElementType>
+SkipListSet<ElementType>::Finger::Finger() noexcept
+    : set{nullptr}, version{0}, path{nullptr}, pathLength{0}
+{
 }
 
 
+
 template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
-    : levelTester{std::move(levelTester)}
+SkipListSet<ElementType>::SkipListSet()
+    : SkipListSet{std::make_unique<GeometricSkipListLevelTester<ElementType>>()}
 {
-    totalNodes = 0;
-    totalLevel = 0;
+}
 
-    initHeadTail();
 
-    head->next = tail;
-    tail->prev = head;
+template <typename ElementType>
+SkipListSet<ElementType>::SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
+    : levelTester{std::move(levelTester)}, levels{nullptr}, levelCount_{0},
+      levelCapacity{0}, path{nullptr}, size_{0}, version{0}
+{
+    initialize();
 }
 
+
 template <typename ElementType>
-void SkipListSet<ElementType>::empty()
+SkipListSet<ElementType>::~SkipListSet() noexcept
 {
-    SkipListNode *tmp;
-    SkipListNode *p = head, *q, *t;
+    destroyAll();
+}
 
-    if (head == nullptr) return;
-    
-    p = head;
-    t = tail;
 
-    while (p != nullptr) { // free data nodes
-        q = p->next;
-        while (q != t) {
-            tmp = q->next;
-            delete q;
-            q = tmp;
-        }
-        p = p->down; // next level
-        t = t->down;
+template <typename ElementType>
+SkipListSet<ElementType>::SkipListSet(const SkipListSet& s)
+    : levelTester{s.levelTester ? s.levelTester->clone() : nullptr}, levels{nullptr},
+      levelCount_{0}, levelCapacity{0}, path{nullptr}, size_{0}, version{0}
+{
+    try
+    {
+        copyFrom(s);
+    }
+    catch (...)
+    {
+        destroyAll();
+        throw;
     }
+}
 
-    p = head;
-    t = tail;
 
-    while (p != nullptr) { // free head and tail nodes
-        tmp = p->down;
-        delete p;
-        p = tmp;
+template <typename ElementType>
+SkipListSet<ElementType>::SkipListSet(SkipListSet&& s) noexcept
+    : levelTester{nullptr}, levels{nullptr}, levelCount_{0},
+      levelCapacity{0}, path{nullptr}, size_{0}, version{0}
+{
+    *this = std::move(s);
+}
 
-        tmp = t->down;
-        delete t;
-        t = tmp;
+
+template <typename ElementType>
+SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(const SkipListSet& s)
+{
+    if (this != &s)
+    {
+        SkipListSet copy{s};
+        *this = std::move(copy);
     }
+
+    return *this;
 }
 
+
 template <typename ElementType>
-SkipListSet<ElementType>::~SkipListSet() noexcept
+SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(SkipListSet&& s) noexcept
 {
-    empty();
+    std::swap(levelTester, s.levelTester);
+    std::swap(levels, s.levels);
+    std::swap(levelCount_, s.levelCount_);
+    std::swap(levelCapacity, s.levelCapacity);
+    std::swap(path, s.path);
+    std::swap(size_, s.size_);
+
+    ++version;
+    ++s.version;
+
+    return *this;
 }
 
 
 template <typename ElementType>
-void SkipListSet<ElementType>::clone(const SkipListSet& s)
+bool SkipListSet<ElementType>::isImplemented() const noexcept
 {
-    totalNodes = s.totalNodes;
-    totalLevel = s.totalLevel;
+    return true;
+}
 
-    //levelTester = std::move(s.levelTester);
 
-    head = tail = nullptr;
+template <typename ElementType>
+void SkipListSet<ElementType>::add(const ElementType& element)
+{
+    if (levels == nullptr)
+    {
+        initialize();
+    }
 
-    // copy head and tail
-    SkipListNode *p, *q, *t, *hq = nullptr, *tq = nullptr, 
-                 *ph, *pt, *bp, *bt;
-    p = s.head;
+    if (!levelTester)
+    {
+        levelTester = std::make_unique<GeometricSkipListLevelTester<ElementType>>();
+    }
 
-    if (p == nullptr) return;
+    // The search leaves the last node before the element on each level in
+    // path, and those are the nodes whose forward pointers will change.
+    Node* existing = next(searchFrom(path, element), 0);
 
-    initHeadTail();
+    if (existing != nullptr && existing->element == element)
+    {
+        return;
+    }
 
-    head->next = tail;
-    tail->prev = head;
+    // The coin flips happen only once we know the element is new, so a
+    // level tester sees exactly one sequence of flips per added element.
+    unsigned int height = levelTester->chooseHeight(
+        element, std::numeric_limits<unsigned int>::max());
 
-    ph = head;
-    pt = tail;
+    if (height > levelCount_)
+    {
+        reserveLevels(height);
 
-    p = p->down;
-    t = tail->down;
-    bp = p;
-    bt = t;
+        for (unsigned int level = levelCount_; level < height; ++level)
+        {
+            levels[level] = Level{nullptr, 0};
+            path[level] = nullptr;
+        }
 
-    SkipListKey<ElementType> hk(SkipListKind::NegInf);
-    SkipListKey<ElementType> tk(SkipListKind::PosInf);
+        levelCount_ = height;
+    }
 
-    while (p != nullptr) { // copy head and tail list
-        hq = new SkipListNode(hk);
-        tq = new SkipListNode(tk);
+    Node* newNode = createNode(element, height);
 
-        hq->next = tq;
-        tq->prev = hq;
+    for (unsigned int level = 0; level < height; ++level)
+    {
+        Node*& link = path[level] == nullptr
+            ? levels[level].first
+            : path[level]->forward()[level];
 
-        ph->down = hq;
-        hq->up = ph;
-        ph = hq;
+        newNode->forward()[level] = link;
+        link = newNode;
 
-        pt->down = tq;
-        tq->up = pt;
-        pt = tq;
+        ++levels[level].size;
+    }
 
-        bp = p;
-        bt = t;
+    ++size_;
+}
 
-        p = p->down;
-        t = t->down;
-    }
 
-    ph = hq;
-    pt = tq;
+template <typename ElementType>
+bool SkipListSet<ElementType>::contains(const ElementType& element) const
+{
+    return find(element) != nullptr;
+}
 
-    if (hq == nullptr) ph = head;
-    if (tq == nullptr) pt = tail;
 
-    SkipListNode *tmp;
-    // copy nodes from bottom to up
-    p = bp;
-    t = bt;
-    if (p != nullptr) {
-        q = p->next;
-        hq = ph;
+template <typename ElementType>
+bool SkipListSet<ElementType>::contains(ElementView element) const
+{
+    if constexpr (Set<ElementType>::HAS_ELEMENT_VIEW)
+    {
+        return find(element) != nullptr;
+    }
+    else
+    {
+        return false;
+    }
+}
 
-        while (q != t) {
-            tmp = new SkipListNode(q->keyValue);
 
-            hq->next = tmp; // add one node in line
-            tmp->prev = hq;
-            hq = tmp;
-            tmp->next = tail;
-            tail->prev = tmp;
+template <typename ElementType>
+template <typename Key>
+bool SkipListSet<ElementType>::containsFrom(Finger& finger, const Key& element) const
+{
+    if (levelCount_ == 0)
+    {
+        return false;
+    }
 
-            // add column list
-            SkipListNode *sln = q->up;
-            // newhead
-            SkipListNode *newtail = tail, *newhead;
+    prepareFinger(finger);
 
-            while (sln != nullptr) {
-                newhead = newtail->prev;
+    const Node* found = next(searchFrom(finger.path.get(), element), 0);
+    return found != nullptr && found->element == element;
+}
 
-                SkipListNode *t1 = new SkipListNode(sln->keyValue);
 
-                // add level nodes
-                newhead->next = t1;
-                t1->prev = newhead;
-                t1->next = newtail;
-                newtail->prev = t1;
+template <typename ElementType>
+const ElementType* SkipListSet<ElementType>::lowerBound(const ElementType& element) const
+{
+    if (levelCount_ == 0)
+    {
+        return nullptr;
+    }
 
-                tmp->up = t1;
-                t1->down = tmp;
-                tmp = t1;
+    const Node* node = next(search(element), 0);
+    return node == nullptr ? nullptr : &node->element;
+}
 
-                newtail = newtail->up;
-                sln = sln->up;
-            }
 
-            q = q->next;
-        }
+template <typename ElementType>
+const ElementType* SkipListSet<ElementType>::lowerBound(
+    Finger& finger, const ElementType& element) const
+{
+    if (levelCount_ == 0)
+    {
+        return nullptr;
     }
+
+    prepareFinger(finger);
+
+    const Node* node = next(searchFrom(finger.path.get(), element), 0);
+    return node == nullptr ? nullptr : &node->element;
 }
 
 
 template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(const SkipListSet& s)
+void SkipListSet<ElementType>::forEachInRange(
+    const ElementType& low, const ElementType& high, VisitFunction visit) const
 {
-    clone(s);
+    if (levelCount_ == 0)
+    {
+        return;
+    }
+
+    for (const Node* node = next(search(low), 0);
+         node != nullptr && node->element < high;
+         node = next(node, 0))
+    {
+        visit(node->element);
+    }
 }
 
 
 template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(SkipListSet&& s) noexcept
+unsigned int SkipListSet<ElementType>::size() const noexcept
 {
-    totalNodes = s.totalNodes;
-    totalLevel = s.totalLevel;
+    return size_;
+}
 
-    levelTester = std::move(s.levelTester);
 
-    head = s.head;
-    tail = s.tail;
-    s.head = nullptr;
-    s.tail = nullptr;
+template <typename ElementType>
+unsigned int SkipListSet<ElementType>::levelCount() const noexcept
+{
+    return levelCount_;
 }
 
+
 template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(const SkipListSet& s)
+unsigned int SkipListSet<ElementType>::elementsOnLevel(unsigned int level) const noexcept
 {
-    if (this != &s) {
-        if (head != nullptr) empty();
-        clone(s);
+    if (level >= levelCount_)
+    {
+        return 0;
     }
 
-    return *this;
+    return levels[level].size;
 }
 
 
 template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(SkipListSet&& s) noexcept
+bool SkipListSet<ElementType>::isElementOnLevel(const ElementType& element, unsigned int level) const
+{
+    const Node* node = find(element);
+    return node != nullptr && level < node->height;
+}
+
+
+template <typename ElementType>
+SetMemoryUsage SkipListSet<ElementType>::memoryUsage() const
 {
-    if (this != &s) {
-        totalNodes = s.totalNodes;
-        totalLevel = s.totalLevel;
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+    usage.bucketBytes = levelCapacity * (sizeof(Level) + sizeof(Node*));
 
-        //levelTester = std::move(s.levelTester);
+    for (unsigned int level = 0; level < levelCount_; ++level)
+    {
+        usage.nodesPerLevel.push_back(levels[level].size);
+    }
 
-        head = s.head;
-        tail = s.tail;
-        s.head = nullptr;
-        s.tail = nullptr;
+    for (const Node* node = levelCount_ == 0 ? nullptr : next(nullptr, 0);
+         node != nullptr;
+         node = next(node, 0))
+    {
+        usage.nodeBytes += nodeBytes(node->height);
+        usage.keyBytes += elementHeapBytes(node->element);
     }
 
-    return *this;
+    return usage;
 }
 
 
 template <typename ElementType>
-bool SkipListSet<ElementType>::isImplemented() const noexcept
+void SkipListSet<ElementType>::printSkipList() const
 {
-    return true;
+    for (unsigned int level = levelCount_; level-- > 0; )
+    {
+        for (const Node* node = next(nullptr, level); node != nullptr; node = next(node, level))
+        {
+            std::cout << node->element << std::endl;
+        }
+
+        std::cout << "---\n";
+    }
 }
 
+
 template <typename ElementType>
-void SkipListSet<ElementType>::insertNode(SkipListNode *p, SkipListNode *q) 
+std::size_t SkipListSet<ElementType>::nodeBytes(unsigned int height) noexcept
 {
-    q->next = p->next;
-    q->prev = p;
-    p->next->prev = q;
-    p->next = q;
+    return sizeof(Node) + height * sizeof(Node*);
 }
 
+
 template <typename ElementType>
-void SkipListSet<ElementType>::addEmptyLevel()
+typename SkipListSet<ElementType>::Node* SkipListSet<ElementType>::createNode(
+    const ElementType& element, unsigned int height)
 {
-    // add one level
-    SkipListKey<ElementType> hk(SkipListKind::NegInf);
-    SkipListKey<ElementType> tk(SkipListKind::PosInf);
+    void* memory = ::operator new(nodeBytes(height));
+    Node* node;
 
-    SkipListNode *p1 = new SkipListNode(hk);
-    SkipListNode *p2 = new SkipListNode(tk);
+    try
+    {
+        node = new (memory) Node{element, height};
+    }
+    catch (...)
+    {
+        ::operator delete(memory);
+        throw;
+    }
 
-    p1->next = p2;
-    p1->down = head;
-    p2->prev = p1;
-    p2->down = tail;
+    Node** forward = node->forward();
 
-    head->up = p1;
-    tail->up = p2;
+    for (unsigned int level = 0; level < height; ++level)
+    {
+        new (&forward[level]) Node*{nullptr};
+    }
 
-    head = p1;
-    tail = p2;
+    return node;
+}
 
-    totalLevel += 1;
+
+template <typename ElementType>
+void SkipListSet<ElementType>::destroyNode(Node* node) noexcept
+{
+    node->~Node();
+    ::operator delete(node);
 }
 
+
 template <typename ElementType>
-void SkipListSet<ElementType>::add(const ElementType& element)
+void SkipListSet<ElementType>::initialize()
 {
-    if (contains(element)) return;
+    reserveLevels(1);
+    levels[0] = Level{nullptr, 0};
+    path[0] = nullptr;
+    levelCount_ = 1;
+}
 
-    SkipListKey<ElementType> *kv = 
-        new SkipListKey<ElementType>(SkipListKind::Normal, element);
 
-    SkipListNode* p = findNode(*kv);
-    SkipListNode *q = new SkipListNode(*kv);
-    insertNode(p, q); // add new node
+template <typename ElementType>
+void SkipListSet<ElementType>::destroyAll() noexcept
+{
+    if (levels != nullptr)
+    {
+        Node* node = levels[0].first;
 
-    int currentLevel = 0;
-    while (levelTester->shouldOccupyNextLevel(element)) {
-        if (currentLevel >= totalLevel) { // add new level
-            addEmptyLevel();
-        }
-        
-        while (p->up == nullptr) { // find prev node
-            p = p->prev;
+        while (node != nullptr)
+        {
+            Node* following = node->forward()[0];
+            destroyNode(node);
+            node = following;
         }
+    }
 
-        p = p->up;
+    delete[] levels;
+    delete[] path;
 
-        // add level node
-        SkipListNode *z = new SkipListNode(*kv);
-        insertNode(p, z);
+    levels = nullptr;
+    path = nullptr;
+    levelCount_ = 0;
+    levelCapacity = 0;
+    size_ = 0;
+}
 
-        // build relationship
-        z->down = q;
-        q->up = z;
 
-        // move up
-        q = z;
-        currentLevel += 1;
+template <typename ElementType>
+void SkipListSet<ElementType>::copyFrom(const SkipListSet& s)
+{
+    if (s.levels == nullptr)
+    {
+        return;
     }
 
-    totalNodes += 1;
+    reserveLevels(s.levelCount_);
+
+    // Nodes are appended to the end of every level they're on, so path
+    // keeps track of the last node on each level so far.
+    for (unsigned int level = 0; level < s.levelCount_; ++level)
+    {
+        levels[level] = Level{nullptr, 0};
+        path[level] = nullptr;
+    }
+
+    levelCount_ = s.levelCount_;
+
+    for (const Node* node = s.next(nullptr, 0); node != nullptr; node = s.next(node, 0))
+    {
+        Node* newNode = createNode(node->element, node->height);
+
+        for (unsigned int level = 0; level < node->height; ++level)
+        {
+            Node*& link = path[level] == nullptr
+                ? levels[level].first
+                : path[level]->forward()[level];
 
-    delete kv;
+            link = newNode;
+            path[level] = newNode;
+            ++levels[level].size;
+        }
+
+        ++size_;
+    }
 }
 
 
 template <typename ElementType>
-bool SkipListSet<ElementType>::contains(const ElementType& element) const
+void SkipListSet<ElementType>::reserveLevels(unsigned int count)
 {
-    if (head == nullptr) return false;
+    if (count <= levelCapacity)
+    {
+        return;
+    }
 
-    if (isElementOnLevel(element, 0)) return true;
+    unsigned int newCapacity = levelCapacity == 0 ? 8 : levelCapacity;
 
-    return false;
+    while (newCapacity < count)
+    {
+        newCapacity *= 2;
+    }
+
+    Level* newLevels = new Level[newCapacity];
+    Node** newPath;
+
+    try
+    {
+        newPath = new Node*[newCapacity];
+    }
+    catch (...)
+    {
+        delete[] newLevels;
+        throw;
+    }
+
+    for (unsigned int level = 0; level < levelCount_; ++level)
+    {
+        newLevels[level] = levels[level];
+        newPath[level] = path[level];
+    }
+
+    delete[] levels;
+    delete[] path;
+
+    levels = newLevels;
+    path = newPath;
+    levelCapacity = newCapacity;
 }
 
 
 template <typename ElementType>
-unsigned int SkipListSet<ElementType>::size() const noexcept
+typename SkipListSet<ElementType>::Node* SkipListSet<ElementType>::next(
+    const Node* node, unsigned int level) const noexcept
 {
-    return totalNodes;
+    return node == nullptr ? levels[level].first : node->forward()[level];
 }
 
 
 template <typename ElementType>
-unsigned int SkipListSet<ElementType>::levelCount() const noexcept
+template <typename Key>
+typename SkipListSet<ElementType>::Node* SkipListSet<ElementType>::search(
+    const Key& element) const
 {
-    if (head == nullptr) return 0;
+    // An ordinary search, from the top of the -INF tower, returning the
+    // last node before the element on level 0.
+    Node* node = nullptr;
 
-    return totalLevel+1;
+    for (unsigned int level = levelCount_; level-- > 0; )
+    {
+        Node* candidate = next(node, level);
+
+        while (candidate != nullptr && candidate->element < element)
+        {
+            node = candidate;
+            candidate = next(node, level);
+        }
+    }
+
+    return node;
 }
 
 
 template <typename ElementType>
-unsigned int SkipListSet<ElementType>::elementsOnLevel(unsigned int level) const noexcept
+template <typename Key>
+typename SkipListSet<ElementType>::Node* SkipListSet<ElementType>::searchFrom(
+    Node** path, const Key& element) const
 {
-    SkipListNode *p = head, *q = tail;
-    if (p == nullptr) return 0;
-    if (level > totalLevel) return 0;
+    // First, move up from level 0 until reaching a level from which a
+    // search can begin: one where the finger is before the element and
+    // the node after the finger isn't (or, if the element comes before
+    // the finger, one where the finger has moved back far enough to be
+    // before the element).  The farther apart the two elements are, the
+    // higher this goes; if it runs out of levels, the search begins from
+    // the top of the -INF tower, just like an ordinary search.
+    unsigned int level = 0;
+    Node* node;
+
+    if (path[0] == nullptr || path[0]->element < element)
+    {
+        while (level + 1 < levelCount_)
+        {
+            Node* following = next(path[level + 1], level + 1);
+
+            if (following == nullptr || !(following->element < element))
+            {
+                break;
+            }
+
+            ++level;
+        }
 
-    while (p->down != nullptr && totalLevel-level > 0) {
-        p = p->down;
-        q = q->down;
-        level += 1;
+        node = path[level];
     }
+    else
+    {
+        while (level < levelCount_ && path[level] != nullptr && !(path[level]->element < element))
+        {
+            ++level;
+        }
 
-    int count = 0;
-    while (p->next != q) {
-        count += 1;
-        p = p->next;
+        if (level == levelCount_)
+        {
+            --level;
+            node = nullptr;
+        }
+        else
+        {
+            node = path[level];
+        }
     }
 
-    return count;
+    // Then search down from there, as usual, moving the finger along.
+    while (true)
+    {
+        Node* candidate = next(node, level);
+
+        while (candidate != nullptr && candidate->element < element)
+        {
+            node = candidate;
+            candidate = next(node, level);
+        }
+
+        path[level] = node;
+
+        if (level == 0)
+        {
+            return node;
+        }
+
+        --level;
+    }
 }
 
 
 template <typename ElementType>
-bool SkipListSet<ElementType>::isElementOnLevel(const ElementType& element, unsigned int level) const
+template <typename Key>
+const typename SkipListSet<ElementType>::Node* SkipListSet<ElementType>::find(
+    const Key& element) const
 {
-    SkipListNode *p = head, *q = tail;
-    if (p == nullptr) return false;
-    if (level > totalLevel) return false;
-
-    while (totalLevel-level > 0 && p->down != nullptr) {
-        p = p->down;
-        q = q->down;
-        level += 1;
+    // A set that's been moved from has no levels, not even an empty one.
+    if (levelCount_ == 0)
+    {
+        return nullptr;
     }
 
-    SkipListKey<ElementType> sk{SkipListKind::Normal, element};
-    p = p->next;
-    while (p != q) {
-        if (p->keyValue == sk) return true;
-        p = p->next;
+    const Node* found = next(search(element), 0);
+
+    if (found != nullptr && found->element == element)
+    {
+        return found;
     }
 
-    return false;
+    return nullptr;
 }
 
 
+template <typename ElementType>
+void SkipListSet<ElementType>::prepareFinger(Finger& finger) const
+{
+    if (finger.set != this || finger.version != version)
+    {
+        finger.set = this;
+        finger.version = version;
+        finger.pathLength = 0;
+    }
 
-#endif // SKIPLISTSET_HPP
+    // Levels added since the finger was last used begin at the start of
+    // the level, which is before every node, so the finger's entries stay
+    // in order from the top level down.
+    if (finger.pathLength < levelCount_)
+    {
+        std::unique_ptr<Node*[]> newPath{new Node*[levelCapacity]};
+
+        for (unsigned int level = 0; level < levelCapacity; ++level)
+        {
+            newPath[level] = level < finger.pathLength ? finger.path[level] : nullptr;
+        }
+
+        finger.path = std::move(newPath);
+        finger.pathLength = levelCount_;
+    }
+}
 
 
+
+#endif // SKIPLISTSET_HPP
@@ -0,0 +1,266 @@
+// SuggestionIndex.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "SuggestionIndex.hpp"
+
+
+
+namespace
+{
+    // The FNV-1a hash of the given characters, leaving out the one at
+    // index skipped (or none of them, if skipped is the length).
+    std::uint64_t hashWithout(const char* chars, std::size_t length, std::size_t skipped) noexcept
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if (i != skipped)
+            {
+                hash ^= static_cast<unsigned char>(chars[i]);
+                hash *= 0x100000001b3ull;
+            }
+        }
+
+        return hash;
+    }
+
+
+    // Calls f with the hash of every key a word is filed under: the word
+    // itself and each of its one-character deletions.  Deleting any of a
+    // run of equal characters leaves the same string, so only the first
+    // of each run is deleted.
+    template <typename KeyFunction>
+    void forEachKey(const char* chars, std::size_t length, KeyFunction f)
+    {
+        f(hashWithout(chars, length, length));
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if (i == 0 || chars[i] != chars[i - 1])
+            {
+                f(hashWithout(chars, length, i));
+            }
+        }
+    }
+
+
+    bool isLetter(char c) noexcept
+    {
+        return c >= 'A' && c <= 'Z';
+    }
+
+
+    std::size_t firstMismatch(const char* a, const char* b, std::size_t length) noexcept
+    {
+        std::size_t i = 0;
+
+        while (i < length && a[i] == b[i])
+        {
+            ++i;
+        }
+
+        return i;
+    }
+
+
+    // Returns true if the candidate is one of the edits that WordChecker
+    // generates away from the word (and isn't the word itself).
+    bool isOneEditAway(
+        const char* word, std::size_t wordLength,
+        const char* candidate, std::size_t candidateLength) noexcept
+    {
+        if (candidateLength == wordLength + 1)
+        {
+            // Whichever of the equivalent places the letter was inserted,
+            // it's the candidate's character at the first mismatch.
+            std::size_t i = firstMismatch(word, candidate, wordLength);
+
+            return isLetter(candidate[i])
+                && std::memcmp(word + i, candidate + i + 1, wordLength - i) == 0;
+        }
+        else if (candidateLength + 1 == wordLength)
+        {
+            std::size_t i = firstMismatch(word, candidate, candidateLength);
+            return std::memcmp(word + i + 1, candidate + i, candidateLength - i) == 0;
+        }
+        else if (candidateLength == wordLength)
+        {
+            std::size_t i = firstMismatch(word, candidate, wordLength);
+
+            if (i == wordLength)
+            {
+                return false;
+            }
+            else if (std::memcmp(word + i + 1, candidate + i + 1, wordLength - i - 1) == 0)
+            {
+                return isLetter(candidate[i]);
+            }
+            else
+            {
+                return i + 1 < wordLength
+                    && word[i] == candidate[i + 1] && word[i + 1] == candidate[i]
+                    && std::memcmp(word + i + 2, candidate + i + 2, wordLength - i - 2) == 0;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+}
+
+
+
+SuggestionIndex::SuggestionIndex(const std::vector<std::string>& words)
+    : bucketMask{0}
+{
+    std::vector<const std::string*> sorted;
+    sorted.reserve(words.size());
+
+    for (const std::string& word : words)
+    {
+        sorted.push_back(&word);
+    }
+
+    std::sort(
+        sorted.begin(), sorted.end(),
+        [](const std::string* a, const std::string* b) { return *a < *b; });
+
+    sorted.erase(
+        std::unique(
+            sorted.begin(), sorted.end(),
+            [](const std::string* a, const std::string* b) { return *a == *b; }),
+        sorted.end());
+
+    std::size_t characterCount = 0;
+    std::size_t keyCount = 0;
+
+    for (const std::string* word : sorted)
+    {
+        characterCount += word->length();
+        forEachKey(word->data(), word->length(), [&keyCount](std::uint64_t) { ++keyCount; });
+    }
+
+    if (characterCount > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw TooLargeException{};
+    }
+
+    wordCharacters.reserve(characterCount);
+    wordStarts.reserve(sorted.size() + 1);
+
+    for (const std::string* word : sorted)
+    {
+        wordStarts.push_back(static_cast<std::uint32_t>(wordCharacters.length()));
+        wordCharacters.append(*word);
+    }
+
+    wordStarts.push_back(static_cast<std::uint32_t>(wordCharacters.length()));
+
+    // There are about as many buckets as keys, so most buckets hold the
+    // words filed under only one key.
+    std::size_t bucketCount = 1;
+
+    while (bucketCount < keyCount)
+    {
+        bucketCount *= 2;
+    }
+
+    bucketMask = bucketCount - 1;
+
+    // The entries are placed in two passes: one counting how many land in
+    // each bucket, which determines where each bucket starts, and another
+    // filling them in.  Since the words are visited in ascending order,
+    // each bucket's word numbers end up in ascending order, too.
+    bucketStarts.assign(bucketCount + 1, 0);
+
+    for (const std::string* word : sorted)
+    {
+        forEachKey(
+            word->data(), word->length(),
+            [this](std::uint64_t hash) { ++bucketStarts[bucketOf(hash) + 1]; });
+    }
+
+    for (std::size_t b = 0; b < bucketCount; ++b)
+    {
+        bucketStarts[b + 1] += bucketStarts[b];
+    }
+
+    entries.resize(keyCount);
+    std::vector<std::uint32_t> nextEntry(bucketStarts.begin(), bucketStarts.end() - 1);
+
+    for (std::uint32_t w = 0; w < sorted.size(); ++w)
+    {
+        forEachKey(
+            sorted[w]->data(), sorted[w]->length(),
+            [this, w, &nextEntry](std::uint64_t hash) { entries[nextEntry[bucketOf(hash)]++] = w; });
+    }
+}
+
+
+std::vector<std::string> SuggestionIndex::findOneEditAway(const std::string& word) const
+{
+    std::vector<std::uint32_t> found;
+
+    forEachKey(
+        word.data(), word.length(),
+        [this, &word, &found](std::uint64_t hash)
+        {
+            std::size_t bucket = bucketOf(hash);
+
+            for (std::uint32_t e = bucketStarts[bucket]; e < bucketStarts[bucket + 1]; ++e)
+            {
+                std::uint32_t w = entries[e];
+                const char* candidate = wordCharacters.data() + wordStarts[w];
+                std::size_t candidateLength = wordStarts[w + 1] - wordStarts[w];
+
+                if (isOneEditAway(word.data(), word.length(), candidate, candidateLength))
+                {
+                    found.push_back(w);
+                }
+            }
+        });
+
+    // Word numbers are in the same order as the words, so sorting them
+    // puts the words in ascending order.
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+
+    std::vector<std::string> suggestions;
+    suggestions.reserve(found.size());
+
+    for (std::uint32_t w : found)
+    {
+        suggestions.emplace_back(
+            wordCharacters.data() + wordStarts[w], wordStarts[w + 1] - wordStarts[w]);
+    }
+
+    return suggestions;
+}
+
+
+unsigned int SuggestionIndex::size() const noexcept
+{
+    return static_cast<unsigned int>(wordStarts.size() - 1);
+}
+
+
+std::size_t SuggestionIndex::memoryBytes() const noexcept
+{
+    return wordCharacters.capacity()
+        + wordStarts.capacity() * sizeof(std::uint32_t)
+        + bucketStarts.capacity() * sizeof(std::uint32_t)
+        + entries.capacity() * sizeof(std::uint32_t);
+}
+
+
+std::size_t SuggestionIndex::bucketOf(std::uint64_t hash) const noexcept
+{
+    return static_cast<std::size_t>((hash ^ (hash >> 32)) & bucketMask);
+}
@@ -0,0 +1,88 @@
+// SuggestionIndex.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SuggestionIndex finds the dictionary words that are one edit away from
+// a misspelled word, without generating and looking up every possible edit.
+// It's a "symmetric delete" index, the technique behind SymSpell: every
+// dictionary word is filed both under itself and under each of the strings
+// that deleting one of its characters leaves behind.  Two words are within
+// one insertion, deletion, replacement, or adjacent swap of each other only
+// if deleting at most one character from each leaves the same string, so
+// the candidates for a misspelled word of length m are the words filed
+// under it and under its m deletions -- m + 1 lookups, rather than the
+// 53m + 25 or so that generating every edit with the letters A-Z takes.
+//
+// The index doesn't store the deletions themselves, only their hashes, so
+// it's a hash table from 64-bit hashes to the words filed under them (laid
+// out as one array of word numbers, sorted by bucket, with the start of
+// each bucket recorded in another).  Words that merely share a bucket are
+// among the candidates, too, so every candidate is checked against the
+// misspelled word before it's returned.
+//
+// The edits checked for are exactly the ones WordChecker generates:
+//
+// * swapping two adjacent characters
+// * inserting a letter from 'A' through 'Z' anywhere
+// * deleting any character
+// * replacing any character with a letter from 'A' through 'Z'
+//
+// The index is built once and never changed afterward.
+
+#ifndef SUGGESTIONINDEX_HPP
+#define SUGGESTIONINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+class SuggestionIndex
+{
+public:
+    // Builds a SuggestionIndex for the given words (such as the ones
+    // returned by WordSetLoader::load).  Duplicates are ignored.  Words
+    // are found by 32-bit offsets, so a TooLargeException is thrown if the
+    // distinct words have more than 2^32 - 1 characters altogether.
+    explicit SuggestionIndex(const std::vector<std::string>& words);
+
+
+    // findOneEditAway() returns the words that are one of the edits above
+    // away from the given word, in ascending order, without duplicates.
+    // The word itself is never among them, even if it's in the index.
+    std::vector<std::string> findOneEditAway(const std::string& word) const;
+
+
+    // size() returns the number of distinct words in the index.
+    unsigned int size() const noexcept;
+
+
+    // memoryBytes() returns how much memory the index's arrays are using.
+    std::size_t memoryBytes() const noexcept;
+
+
+    class TooLargeException { };
+
+
+private:
+    // The words, in ascending order, stored back-to-back in wordCharacters;
+    // word i begins at wordStarts[i] and ends where word i + 1 begins.
+    std::string wordCharacters;
+    std::vector<std::uint32_t> wordStarts;
+
+    // The word numbers filed in bucket b are entries[bucketStarts[b]]
+    // through entries[bucketStarts[b + 1] - 1].
+    std::vector<std::uint32_t> bucketStarts;
+    std::vector<std::uint32_t> entries;
+    std::uint64_t bucketMask;
+
+private:
+    std::size_t bucketOf(std::uint64_t hash) const noexcept;
+};
+
+
+
+#endif // SUGGESTIONINDEX_HPP
@@ -6,29 +6,144 @@
 // Replace and/or augment the implementations below as needed to meet
 // the requirements.
 
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include "EditDistance.hpp"
 #include "WordChecker.hpp"
 
 
 
 WordChecker::WordChecker(const Set<std::string>& words)
-    : words{words}
+    : words{words}, suggestionIndex{nullptr}
 {
 }
 
 
-bool WordChecker::wordExists(const std::string& word) const
+WordChecker::WordChecker(const Set<std::string>& words, const SuggestionIndex& suggestionIndex)
+    : words{words}, suggestionIndex{&suggestionIndex}
 {
-    return false;
+}
+
+
+bool WordChecker::wordExists(std::string_view word) const
+{
+    return words.contains(word);
 }
 
 
 std::vector<std::string> WordChecker::findSuggestions(const std::string& word) const
 {
-    // Nonsensical code because the compiler requires the member variables
-    // 'words' to be used somewhere, or else it becomes a warning (which
-    // turns into an error).
-    words.isImplemented();
+    // The first four algorithms -- swapping, inserting, deleting, and
+    // replacing -- each change the word by one edit, so a SuggestionIndex
+    // can find all of their suggestions at once.  The fifth splits the
+    // word in two, which no index of single words can help with, so its
+    // suggestions are always found by looking both halves up.
+    std::vector<std::string> suggestions =
+        suggestionIndex != nullptr
+            ? suggestionIndex->findOneEditAway(word)
+            : generateOneEditAway(word);
+
+    std::string_view wordView{word};
+
+    for (std::size_t i = 1; i < word.length(); ++i)
+    {
+        std::string_view first = wordView.substr(0, i);
+        std::string_view second = wordView.substr(i);
+
+        if (words.contains(first) && words.contains(second))
+        {
+            suggestions.push_back(std::string{first} + " " + std::string{second});
+        }
+    }
 
-    return std::vector<std::string>{};
+    return rankSuggestions(word, std::move(suggestions));
 }
 
+
+std::vector<std::string> WordChecker::generateOneEditAway(const std::string& word) const
+{
+    std::vector<std::string> suggestions;
+    std::string candidate;
+
+    auto tryCandidate =
+        [&]()
+        {
+            if (candidate != word && words.contains(candidate))
+            {
+                suggestions.push_back(candidate);
+            }
+        };
+
+    for (std::size_t i = 0; i + 1 < word.length(); ++i)
+    {
+        candidate = word;
+        std::swap(candidate[i], candidate[i + 1]);
+        tryCandidate();
+    }
+
+    for (std::size_t i = 0; i <= word.length(); ++i)
+    {
+        for (char c = 'A'; c <= 'Z'; ++c)
+        {
+            candidate = word;
+            candidate.insert(candidate.begin() + i, c);
+            tryCandidate();
+        }
+    }
+
+    for (std::size_t i = 0; i < word.length(); ++i)
+    {
+        candidate = word;
+        candidate.erase(i, 1);
+        tryCandidate();
+    }
+
+    for (std::size_t i = 0; i < word.length(); ++i)
+    {
+        for (char c = 'A'; c <= 'Z'; ++c)
+        {
+            candidate = word;
+            candidate[i] = c;
+            tryCandidate();
+        }
+    }
+
+    // The same word can be reached by more than one edit (e.g., inserting
+    // an 'O' on either side of the 'O' in "BOK").
+    std::sort(suggestions.begin(), suggestions.end());
+    suggestions.erase(std::unique(suggestions.begin(), suggestions.end()), suggestions.end());
+
+    return suggestions;
+}
+
+
+std::vector<std::string> WordChecker::rankSuggestions(
+    const std::string& word, std::vector<std::string> suggestions) const
+{
+    // Every suggestion is compared against the same word, so its bit
+    // vectors are built once and reused for all of them.
+    EditDistancePattern pattern{word};
+
+    std::vector<std::tuple<unsigned int, unsigned int, std::string>> ranked;
+    ranked.reserve(suggestions.size());
+
+    for (std::string& suggestion : suggestions)
+    {
+        unsigned int damerau = pattern.damerauDistanceTo(suggestion);
+        unsigned int levenshtein = pattern.levenshteinDistanceTo(suggestion);
+        ranked.emplace_back(damerau, levenshtein, std::move(suggestion));
+    }
+
+    std::sort(ranked.begin(), ranked.end());
+
+    std::vector<std::string> result;
+    result.reserve(ranked.size());
+
+    for (auto& entry : ranked)
+    {
+        result.push_back(std::move(std::get<2>(entry)));
+    }
+
+    return result;
+}
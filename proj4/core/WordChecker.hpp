@@ -17,8 +17,10 @@
 #define WORDCHECKER_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include "Set.hpp"
+#include "SuggestionIndex.hpp"
 
 
 
@@ -30,20 +32,36 @@ public:
     // whenever it needs to look up a word.
     WordChecker(const Set<std::string>& words);
 
+    // This constructor also takes a SuggestionIndex built from the same
+    // words as the Set, which findSuggestions() will use in place of
+    // generating every possible edit and looking each one up.  As with the
+    // Set, the WordChecker stores a reference to it.
+    WordChecker(const Set<std::string>& words, const SuggestionIndex& suggestionIndex);
+
 
     // wordExists() returns true if the given word is spelled correctly,
-    // false otherwise.
-    bool wordExists(const std::string& word) const;
+    // false otherwise.  It takes a std::string_view, so that a word can be
+    // checked without being copied into a std::string first.
+    bool wordExists(std::string_view word) const;
 
 
     // findSuggestions() returns a vector containing suggested alternative
     // spellings for the given word, using the five algorithms described in
-    // the project write-up.
+    // the project write-up.  There are no duplicates, the word itself is
+    // never among them, and they're ranked closest first: by Damerau
+    // distance from the word, then by Levenshtein distance (so a suggestion
+    // that needs a swap comes after the others), then alphabetically.
     std::vector<std::string> findSuggestions(const std::string& word) const;
 
 
 private:
     const Set<std::string>& words;
+    const SuggestionIndex* suggestionIndex;
+
+private:
+    std::vector<std::string> generateOneEditAway(const std::string& word) const;
+    std::vector<std::string> rankSuggestions(
+        const std::string& word, std::vector<std::string> suggestions) const;
 };
 
 
@@ -0,0 +1,141 @@
+// BTreeSetBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares the ordered sets -- BTreeSet, SkipListSet, and AVLSet -- by
+// adding every dictionary word (in shuffled order) to an empty set, then
+// looking every dictionary word up again (in a different shuffled order),
+// then looking up the words of a text file, over several passes.  Since
+// these sets all keep their elements in order, the memory they use per
+// element is reported, too, as a rough measure of how many cache lines
+// each one has to touch.  A set that isn't implemented is skipped.
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "AVLSet.hpp"
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "BTreeSet.hpp"
+#include "SkipListSet.hpp"
+#include "Stopwatch.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class BTreeSetBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    // The lookups' results are counted, so that the compiler can't decide
+    // they're unnecessary and skip them.
+    double timeLookups(const Set<std::string>& set, const std::vector<std::string>& words, unsigned long& found)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (const std::string& word : words)
+        {
+            if (set.contains(word))
+            {
+                ++found;
+            }
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    void measure(
+        const std::string& label, std::unique_ptr<Set<std::string>> set,
+        const std::vector<std::string>& loadWords, const std::vector<std::string>& lookupWords,
+        const std::vector<std::string>& textWords)
+    {
+        if (!set->isImplemented())
+        {
+            std::cout << label << " (not implemented)" << std::endl;
+            return;
+        }
+
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (const std::string& word : loadWords)
+        {
+            set->add(word);
+        }
+
+        stopwatch.stop();
+        double loadDuration = stopwatch.lastDuration();
+
+        unsigned long found = 0;
+        double lookupDuration = timeLookups(*set, lookupWords, found);
+        double textDuration = timeLookups(*set, textWords, found);
+
+        double bytesPerElement =
+            static_cast<double>(set->memoryUsage().totalBytes()) / set->size();
+
+        printResultRow(
+            label,
+            {loadDuration, lookupDuration, lookupWords.size() / lookupDuration * 1000000.0,
+             textDuration, bytesPerElement, static_cast<double>(found)});
+    }
+
+
+    void BTreeSetBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        std::string textFilePath = readParameter("Text file", "biginput.txt");
+        unsigned int passes = readUnsignedParameter("Passes over the text", 100);
+
+        std::vector<std::string> loadWords = WordSetLoader{}.load(wordFilePath);
+        std::vector<std::string> text = loadTextWords(textFilePath);
+
+        if (loadWords.empty() || text.empty())
+        {
+            std::cout << "The word file and the text file must both have words in them" << std::endl;
+            return;
+        }
+
+        std::vector<std::string> lookupWords = loadWords;
+        std::shuffle(loadWords.begin(), loadWords.end(), std::mt19937{46});
+        std::shuffle(lookupWords.begin(), lookupWords.end(), std::mt19937{47});
+
+        std::vector<std::string> textWords;
+
+        for (unsigned int pass = 0; pass < passes; ++pass)
+        {
+            textWords.insert(textWords.end(), text.begin(), text.end());
+        }
+
+        std::cout << std::endl;
+        std::cout << loadWords.size() << " dictionary words, "
+                  << textWords.size() << " words of text (" << passes << " passes)" << std::endl;
+        std::cout << std::endl;
+
+        printResultHeader(
+            "Set",
+            {"Load (usec)", "Lookup (usec)", "Lookups/sec", "Text (usec)", "Bytes/element",
+             "Found"});
+
+        measure("BTreeSet", std::make_unique<BTreeSet<std::string>>(), loadWords, lookupWords, textWords);
+        measure("SkipListSet", std::make_unique<SkipListSet<std::string>>(), loadWords, lookupWords, textWords);
+        measure("AVLSet", std::make_unique<AVLSet<std::string>>(), loadWords, lookupWords, textWords);
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, BTreeSetBenchmark, "BTREE");
+
@@ -0,0 +1,34 @@
+// Benchmark.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmark is an abstract base class for the experiments that the exp
+// program knows how to run.  Each benchmark registers itself with the
+// DynamicFactory<Benchmark> under a display name, using the usual
+// ICS46_DYNAMIC_FACTORY_REGISTER macro in its source file, e.g.,
+//
+//     ICS46_DYNAMIC_FACTORY_REGISTER(
+//         Benchmark, ConcurrentHashSetBenchmark, "CONCURRENT HASH");
+//
+// expmain reads the name of a benchmark from the first line of the
+// standard input and runs it; the benchmark is then free to read any
+// further parameters it needs from the standard input itself.
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+
+
+class Benchmark
+{
+public:
+    virtual ~Benchmark() = default;
+
+    virtual void run() = 0;
+};
+
+
+
+#endif // BENCHMARK_HPP
+
@@ -0,0 +1,92 @@
+// BenchmarkUtilities.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <iomanip>
+#include <iostream>
+#include "BenchmarkUtilities.hpp"
+#include "TextFileReader.hpp"
+
+
+
+namespace
+{
+    constexpr int LABEL_WIDTH = 16;
+    constexpr int COLUMN_WIDTH = 16;
+}
+
+
+std::string readParameter(const std::string& prompt, const std::string& defaultValue)
+{
+    std::cout << prompt << " [" << defaultValue << "]: " << std::flush;
+
+    std::string line;
+
+    if (!std::getline(std::cin, line) || line.empty())
+    {
+        return defaultValue;
+    }
+    else
+    {
+        return line;
+    }
+}
+
+
+unsigned int readUnsignedParameter(const std::string& prompt, unsigned int defaultValue)
+{
+    std::string value = readParameter(prompt, std::to_string(defaultValue));
+
+    try
+    {
+        return static_cast<unsigned int>(std::stoul(value));
+    }
+    catch (...)
+    {
+        return defaultValue;
+    }
+}
+
+
+std::vector<std::string> loadTextWords(const std::string& textFilePath)
+{
+    std::vector<std::string> words;
+    TextFileReader reader{textFilePath};
+
+    while (!reader.noMoreWords())
+    {
+        words.push_back(reader.currentWord());
+        reader.advanceToNextWord();
+    }
+
+    return words;
+}
+
+
+void printResultHeader(const std::string& label, const std::vector<std::string>& columns)
+{
+    std::cout << std::left << std::setw(LABEL_WIDTH) << label;
+
+    for (const std::string& column : columns)
+    {
+        std::cout << std::right << std::setw(COLUMN_WIDTH) << column;
+    }
+
+    std::cout << std::endl;
+}
+
+
+void printResultRow(const std::string& label, const std::vector<double>& values)
+{
+    std::cout << std::left << std::setw(LABEL_WIDTH) << label;
+
+    for (double value : values)
+    {
+        std::cout << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(COLUMN_WIDTH) << value;
+    }
+
+    std::cout << std::endl;
+}
+
@@ -0,0 +1,40 @@
+// BenchmarkUtilities.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A handful of functions shared by the benchmarks in the exp directory:
+// reading parameters from the standard input (with defaults when a line
+// is left blank), loading the words of a text file into memory up front
+// so that file I/O doesn't pollute the timings, and printing rows of a
+// results table.
+
+#ifndef BENCHMARKUTILITIES_HPP
+#define BENCHMARKUTILITIES_HPP
+
+#include <string>
+#include <vector>
+
+
+
+// readParameter() prints a prompt describing a parameter, reads one line
+// from the standard input, and returns it, or returns the given default
+// value if the line was blank (or the input has run out).
+std::string readParameter(const std::string& prompt, const std::string& defaultValue);
+unsigned int readUnsignedParameter(const std::string& prompt, unsigned int defaultValue);
+
+
+// loadTextWords() returns every word in the given text file, in order,
+// exactly as a TextFileReader would return them to the SpellChecker.
+std::vector<std::string> loadTextWords(const std::string& textFilePath);
+
+
+// printResultRow() prints one row of a results table, with a left-aligned
+// label followed by right-aligned columns of values.
+void printResultRow(const std::string& label, const std::vector<double>& values);
+void printResultHeader(const std::string& label, const std::vector<std::string>& columns);
+
+
+
+#endif // BENCHMARKUTILITIES_HPP
+
@@ -0,0 +1,155 @@
+// ConcurrentHashSetBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures how lookup throughput on a ConcurrentHashSet scales with the
+// number of threads.  A dictionary is loaded into the set once; then,
+// for each thread count from 1 to 32, every thread spell-checks its own
+// copy of the words in a text file against the shared set, and adds a
+// small fraction of the misspelled words to it as "custom words," the
+// way a user would while spell-checking many documents at once.
+//
+// A plain HashSet, run on one thread, is included as a baseline, since
+// the locking in ConcurrentHashSet costs something even with no
+// contention at all.
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "ConcurrentHashSet.hpp"
+#include "HashSet.hpp"
+#include "Stopwatch.hpp"
+#include "StringHashing.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class ConcurrentHashSetBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    // Every misspelling whose position in the text is a multiple of this
+    // is added to the set as a custom word.
+    constexpr unsigned int CUSTOM_WORD_INTERVAL = 16;
+
+
+    unsigned int checkWords(Set<std::string>& set, const std::vector<std::string>& textWords)
+    {
+        unsigned int misspellings = 0;
+
+        for (unsigned int i = 0; i < textWords.size(); ++i)
+        {
+            if (!set.contains(textWords[i]))
+            {
+                ++misspellings;
+
+                if (i % CUSTOM_WORD_INTERVAL == 0)
+                {
+                    set.add(textWords[i]);
+                }
+            }
+        }
+
+        return misspellings;
+    }
+
+
+    template <typename SetType>
+    void loadDictionary(SetType& set, const std::vector<std::string>& dictionary)
+    {
+        for (const std::string& word : dictionary)
+        {
+            set.add(word);
+        }
+    }
+
+
+    void ConcurrentHashSetBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        std::string textFilePath = readParameter("Text file", "biginput.txt");
+        unsigned int repetitions = readUnsignedParameter("Passes over the text per thread", 20);
+
+        std::vector<std::string> dictionary = WordSetLoader{}.load(wordFilePath);
+        std::vector<std::string> textWords = loadTextWords(textFilePath);
+
+        std::cout << std::endl;
+        std::cout << dictionary.size() << " dictionary words, "
+                  << textWords.size() << " words of text" << std::endl;
+        std::cout << std::endl;
+
+        printResultHeader("Threads", {"Lookups", "Time (usec)", "Lookups/sec"});
+
+        Stopwatch stopwatch;
+
+        {
+            HashSet<std::string> set{hashStringAsProduct};
+            loadDictionary(set, dictionary);
+
+            stopwatch.start();
+
+            for (unsigned int r = 0; r < repetitions; ++r)
+            {
+                checkWords(set, textWords);
+            }
+
+            stopwatch.stop();
+
+            double lookups = static_cast<double>(textWords.size()) * repetitions;
+            printResultRow(
+                "HashSet",
+                {lookups, stopwatch.lastDuration(),
+                 lookups / stopwatch.lastDuration() * 1000000.0});
+        }
+
+        for (unsigned int threadCount = 1; threadCount <= 32; threadCount *= 2)
+        {
+            ConcurrentHashSet<std::string> set{hashStringAsProduct};
+            loadDictionary(set, dictionary);
+
+            std::vector<std::thread> threads;
+
+            stopwatch.start();
+
+            for (unsigned int t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back(
+                    [&]()
+                    {
+                        for (unsigned int r = 0; r < repetitions; ++r)
+                        {
+                            checkWords(set, textWords);
+                        }
+                    });
+            }
+
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            stopwatch.stop();
+
+            double lookups = static_cast<double>(textWords.size()) * repetitions * threadCount;
+            printResultRow(
+                std::to_string(threadCount),
+                {lookups, stopwatch.lastDuration(),
+                 lookups / stopwatch.lastDuration() * 1000000.0});
+        }
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, ConcurrentHashSetBenchmark, "CONCURRENT HASH");
+
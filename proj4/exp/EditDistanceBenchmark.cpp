@@ -0,0 +1,189 @@
+// EditDistanceBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares the dynamic programming edit distance functions against the
+// bit-parallel ones in EditDistancePattern, the way suggestion ranking
+// uses them: each of a number of words is compared against a batch of
+// dictionary words, building its EditDistancePattern once per batch.  The
+// distances are summed, so that the compiler can't skip computing them,
+// and so that the two ways can be checked against each other.
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "EditDistance.hpp"
+#include "Stopwatch.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class EditDistanceBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    template <typename Distance>
+    double timeDistances(
+        const std::vector<std::string>& words, const std::vector<std::string>& candidates,
+        unsigned int batchSize, Distance distance, unsigned long& total)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (std::size_t w = 0; w < words.size(); ++w)
+        {
+            total += distance(words[w], candidates, w * batchSize, batchSize);
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    void EditDistanceBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        unsigned int wordCount = readUnsignedParameter("Words", 2000);
+        unsigned int batchSize = readUnsignedParameter("Candidates per word", 100);
+
+        std::vector<std::string> dictionary = WordSetLoader{}.load(wordFilePath);
+
+        if (dictionary.empty())
+        {
+            std::cout << "The word file must have words in it" << std::endl;
+            return;
+        }
+
+        std::mt19937 random{46};
+        std::uniform_int_distribution<std::size_t> wordIndexes{0, dictionary.size() - 1};
+
+        std::vector<std::string> words;
+        std::vector<std::string> candidates;
+
+        for (unsigned int w = 0; w < wordCount; ++w)
+        {
+            words.push_back(dictionary[wordIndexes(random)]);
+
+            for (unsigned int c = 0; c < batchSize; ++c)
+            {
+                candidates.push_back(dictionary[wordIndexes(random)]);
+            }
+        }
+
+        auto dynamicLevenshtein =
+            [](const std::string& word, const std::vector<std::string>& candidates,
+               std::size_t first, unsigned int count)
+            {
+                unsigned long sum = 0;
+
+                for (std::size_t c = first; c < first + count; ++c)
+                {
+                    sum += levenshteinDistance(word, candidates[c]);
+                }
+
+                return sum;
+            };
+
+        auto dynamicDamerau =
+            [](const std::string& word, const std::vector<std::string>& candidates,
+               std::size_t first, unsigned int count)
+            {
+                unsigned long sum = 0;
+
+                for (std::size_t c = first; c < first + count; ++c)
+                {
+                    sum += damerauDistance(word, candidates[c]);
+                }
+
+                return sum;
+            };
+
+        auto bitParallelLevenshtein =
+            [](const std::string& word, const std::vector<std::string>& candidates,
+               std::size_t first, unsigned int count)
+            {
+                EditDistancePattern pattern{word};
+                unsigned long sum = 0;
+
+                for (std::size_t c = first; c < first + count; ++c)
+                {
+                    sum += pattern.levenshteinDistanceTo(candidates[c]);
+                }
+
+                return sum;
+            };
+
+        auto bitParallelDamerau =
+            [](const std::string& word, const std::vector<std::string>& candidates,
+               std::size_t first, unsigned int count)
+            {
+                EditDistancePattern pattern{word};
+                unsigned long sum = 0;
+
+                for (std::size_t c = first; c < first + count; ++c)
+                {
+                    sum += pattern.damerauDistanceTo(candidates[c]);
+                }
+
+                return sum;
+            };
+
+        unsigned long dynamicLevenshteinTotal = 0;
+        unsigned long dynamicDamerauTotal = 0;
+        unsigned long bitParallelLevenshteinTotal = 0;
+        unsigned long bitParallelDamerauTotal = 0;
+
+        double dynamicLevenshteinDuration = timeDistances(
+            words, candidates, batchSize, dynamicLevenshtein, dynamicLevenshteinTotal);
+
+        double bitParallelLevenshteinDuration = timeDistances(
+            words, candidates, batchSize, bitParallelLevenshtein, bitParallelLevenshteinTotal);
+
+        double dynamicDamerauDuration = timeDistances(
+            words, candidates, batchSize, dynamicDamerau, dynamicDamerauTotal);
+
+        double bitParallelDamerauDuration = timeDistances(
+            words, candidates, batchSize, bitParallelDamerau, bitParallelDamerauTotal);
+
+        std::cout << std::endl;
+        std::cout << candidates.size() << " comparisons (" << wordCount << " words, "
+                  << batchSize << " candidates each)" << std::endl;
+
+        if (dynamicLevenshteinTotal != bitParallelLevenshteinTotal
+            || dynamicDamerauTotal != bitParallelDamerauTotal)
+        {
+            std::cout << "WARNING: the distances disagree" << std::endl;
+        }
+
+        std::cout << std::endl;
+
+        printResultHeader("", {"Time (usec)", "Distances/sec", "Total distance"});
+
+        auto printRow =
+            [&](const std::string& label, double duration, unsigned long total)
+            {
+                printResultRow(
+                    label,
+                    {duration, candidates.size() / duration * 1000000.0, static_cast<double>(total)});
+            };
+
+        printRow("DP Levenshtein", dynamicLevenshteinDuration, dynamicLevenshteinTotal);
+        printRow("Bit Levenshtein", bitParallelLevenshteinDuration, bitParallelLevenshteinTotal);
+        printRow("DP Damerau", dynamicDamerauDuration, dynamicDamerauTotal);
+        printRow("Bit Damerau", bitParallelDamerauDuration, bitParallelDamerauTotal);
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, EditDistanceBenchmark, "EDIT DISTANCE");
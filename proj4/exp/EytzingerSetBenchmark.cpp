@@ -0,0 +1,184 @@
+// EytzingerSetBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares EytzingerSet against the other ways of searching a read-only
+// dictionary: an ordinary sorted vector searched with std::binary_search
+// (the same comparisons, in a cache-unfriendly order), a BTreeSet, and a
+// FrozenHashSet.  Each is built from the output of WordSetLoader::load,
+// then used to look up every dictionary word (in shuffled order, so that
+// consecutive searches don't share a path) and the words of a text file,
+// over several passes.
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "BTreeSet.hpp"
+#include "EytzingerSet.hpp"
+#include "FrozenHashSet.hpp"
+#include "Stopwatch.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class EytzingerSetBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    // The baseline: the dictionary, sorted, searched by binary search.
+    class SortedVectorSet : public Set<std::string>
+    {
+    public:
+        explicit SortedVectorSet(const std::vector<std::string>& words)
+            : words{words}
+        {
+            std::sort(this->words.begin(), this->words.end());
+            this->words.erase(std::unique(this->words.begin(), this->words.end()), this->words.end());
+        }
+
+        bool isImplemented() const noexcept override
+        {
+            return true;
+        }
+
+        void add(const std::string& element) override
+        {
+        }
+
+        bool contains(const std::string& element) const override
+        {
+            return std::binary_search(words.begin(), words.end(), element);
+        }
+
+        unsigned int size() const noexcept override
+        {
+            return words.size();
+        }
+
+    private:
+        std::vector<std::string> words;
+    };
+
+
+    std::unique_ptr<Set<std::string>> makeBTreeSet(const std::vector<std::string>& words)
+    {
+        std::unique_ptr<Set<std::string>> set = std::make_unique<BTreeSet<std::string>>();
+
+        for (const std::string& word : words)
+        {
+            set->add(word);
+        }
+
+        return set;
+    }
+
+
+    // The lookups' results are counted, so that the compiler can't decide
+    // they're unnecessary and skip them.
+    double timeLookups(const Set<std::string>& set, const std::vector<std::string>& words, unsigned long& found)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (const std::string& word : words)
+        {
+            if (set.contains(word))
+            {
+                ++found;
+            }
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    template <typename MakeSet>
+    void measure(
+        const std::string& label, MakeSet makeSet, const std::vector<std::string>& dictionary,
+        const std::vector<std::string>& lookupWords, const std::vector<std::string>& textWords)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+        std::unique_ptr<Set<std::string>> set = makeSet(dictionary);
+        stopwatch.stop();
+        double buildDuration = stopwatch.lastDuration();
+
+        unsigned long found = 0;
+        double lookupDuration = timeLookups(*set, lookupWords, found);
+        double textDuration = timeLookups(*set, textWords, found);
+
+        printResultRow(
+            label,
+            {buildDuration, lookupDuration, lookupWords.size() / lookupDuration * 1000000.0,
+             textDuration, static_cast<double>(found)});
+    }
+
+
+    void EytzingerSetBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        std::string textFilePath = readParameter("Text file", "biginput.txt");
+        unsigned int passes = readUnsignedParameter("Passes over the text", 100);
+
+        std::vector<std::string> dictionary = WordSetLoader{}.load(wordFilePath);
+        std::vector<std::string> text = loadTextWords(textFilePath);
+
+        if (dictionary.empty() || text.empty())
+        {
+            std::cout << "The word file and the text file must both have words in them" << std::endl;
+            return;
+        }
+
+        std::vector<std::string> lookupWords = dictionary;
+        std::shuffle(lookupWords.begin(), lookupWords.end(), std::mt19937{47});
+
+        std::vector<std::string> textWords;
+
+        for (unsigned int pass = 0; pass < passes; ++pass)
+        {
+            textWords.insert(textWords.end(), text.begin(), text.end());
+        }
+
+        std::cout << std::endl;
+        std::cout << dictionary.size() << " dictionary words, "
+                  << textWords.size() << " words of text (" << passes << " passes)" << std::endl;
+        std::cout << std::endl;
+
+        printResultHeader(
+            "Set", {"Build (usec)", "Lookup (usec)", "Lookups/sec", "Text (usec)", "Found"});
+
+        measure(
+            "SortedVector",
+            [](const std::vector<std::string>& words) { return std::make_unique<SortedVectorSet>(words); },
+            dictionary, lookupWords, textWords);
+
+        measure(
+            "EytzingerSet",
+            [](const std::vector<std::string>& words) { return std::make_unique<EytzingerSet>(words); },
+            dictionary, lookupWords, textWords);
+
+        measure("BTreeSet", makeBTreeSet, dictionary, lookupWords, textWords);
+
+        measure(
+            "FrozenHashSet",
+            [](const std::vector<std::string>& words) { return std::make_unique<FrozenHashSet>(words); },
+            dictionary, lookupWords, textWords);
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, EytzingerSetBenchmark, "EYTZINGER");
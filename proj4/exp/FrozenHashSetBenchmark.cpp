@@ -0,0 +1,124 @@
+// FrozenHashSetBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares FrozenHashSet against HashSet on the two things that matter
+// for a read-only dictionary: how long it takes to build the structure
+// from the output of WordSetLoader::load, and how long it takes to look
+// up every word of a text file (repeated some number of times, so the
+// lookups dominate the measurement).
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "FrozenHashSet.hpp"
+#include "HashSet.hpp"
+#include "Stopwatch.hpp"
+#include "StringHashing.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class FrozenHashSetBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    double timeLookups(
+        const Set<std::string>& set, const std::vector<std::string>& textWords,
+        unsigned int repetitions, unsigned int& found)
+    {
+        Stopwatch stopwatch;
+        found = 0;
+
+        stopwatch.start();
+
+        for (unsigned int r = 0; r < repetitions; ++r)
+        {
+            for (const std::string& word : textWords)
+            {
+                if (set.contains(word))
+                {
+                    ++found;
+                }
+            }
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    void FrozenHashSetBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        std::string textFilePath = readParameter("Text file", "biginput.txt");
+        unsigned int repetitions = readUnsignedParameter("Passes over the text", 100);
+
+        std::vector<std::string> dictionary = WordSetLoader{}.load(wordFilePath);
+        std::vector<std::string> textWords = loadTextWords(textFilePath);
+
+        Stopwatch stopwatch;
+
+        stopwatch.start();
+        HashSet<std::string> hashSet{hashStringAsProduct};
+
+        for (const std::string& word : dictionary)
+        {
+            hashSet.add(word);
+        }
+
+        stopwatch.stop();
+        double hashSetBuildDuration = stopwatch.lastDuration();
+
+        stopwatch.start();
+        FrozenHashSet frozenHashSet{dictionary};
+        stopwatch.stop();
+        double frozenHashSetBuildDuration = stopwatch.lastDuration();
+
+        unsigned int hashSetFound;
+        double hashSetLookupDuration = timeLookups(hashSet, textWords, repetitions, hashSetFound);
+
+        unsigned int frozenHashSetFound;
+        double frozenHashSetLookupDuration =
+            timeLookups(frozenHashSet, textWords, repetitions, frozenHashSetFound);
+
+        std::cout << std::endl;
+        std::cout << dictionary.size() << " dictionary words, "
+                  << textWords.size() * repetitions << " lookups" << std::endl;
+
+        if (hashSetFound != frozenHashSetFound)
+        {
+            std::cout << "WARNING: the sets disagree (" << hashSetFound << " vs. "
+                      << frozenHashSetFound << " words found)" << std::endl;
+        }
+
+        std::cout << std::endl;
+
+        printResultHeader("", {"Build (usec)", "Lookup (usec)", "Lookups/sec"});
+
+        printResultRow(
+            "HashSet",
+            {hashSetBuildDuration, hashSetLookupDuration,
+             textWords.size() * repetitions / hashSetLookupDuration * 1000000.0});
+
+        printResultRow(
+            "FrozenHashSet",
+            {frozenHashSetBuildDuration, frozenHashSetLookupDuration,
+             textWords.size() * repetitions / frozenHashSetLookupDuration * 1000000.0});
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, FrozenHashSetBenchmark, "FROZEN HASH");
+
@@ -0,0 +1,199 @@
+// LockFreeSkipListSetBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures how throughput on a LockFreeSkipListSet scales with the number
+// of threads.  For each thread count from 1 to 32, the threads first load
+// the dictionary into an empty set together (each adding an interleaved
+// share of the words, in shuffled order), and then each thread runs its
+// own mix of lookups, adds, and removes of dictionary words against the
+// shared set: three lookups for every add or remove, with the adds and
+// removes split evenly, so the set's size stays about the same.
+//
+// A SkipListSet protected by a single std::shared_mutex -- the obvious way
+// to share a SkipListSet between threads -- is measured the same way, as
+// a baseline.
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "LockFreeSkipListSet.hpp"
+#include "SkipListSet.hpp"
+#include "Stopwatch.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class LockFreeSkipListSetBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    // A LockedSkipListSet is a SkipListSet with one reader/writer lock
+    // around it.  SkipListSet has no remove(), so a removal is recorded
+    // as a lookup, which only flatters the baseline.
+    class LockedSkipListSet
+    {
+    public:
+        void add(const std::string& word)
+        {
+            std::unique_lock<std::shared_mutex> lock{mutex};
+            set.add(word);
+        }
+
+        bool contains(const std::string& word) const
+        {
+            std::shared_lock<std::shared_mutex> lock{mutex};
+            return set.contains(word);
+        }
+
+        bool remove(const std::string& word)
+        {
+            return contains(word);
+        }
+
+    private:
+        mutable std::shared_mutex mutex;
+        SkipListSet<std::string> set;
+    };
+
+
+    template <typename Function>
+    double timeThreads(unsigned int threadCount, Function function)
+    {
+        std::vector<std::thread> threads;
+        Stopwatch stopwatch;
+
+        stopwatch.start();
+
+        for (unsigned int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back(function, t);
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    template <typename SetType>
+    void measure(
+        const std::string& label, unsigned int threadCount,
+        const std::vector<std::string>& words, unsigned int operationsPerThread)
+    {
+        SetType set;
+
+        double loadDuration = timeThreads(
+            threadCount,
+            [&](unsigned int t)
+            {
+                for (std::size_t i = t; i < words.size(); i += threadCount)
+                {
+                    set.add(words[i]);
+                }
+            });
+
+        // The lookups' results are counted, so that the compiler can't
+        // decide they're unnecessary and skip them.
+        std::atomic<unsigned long> found{0};
+
+        double mixDuration = timeThreads(
+            threadCount,
+            [&](unsigned int t)
+            {
+                unsigned long foundByThread = 0;
+                std::mt19937 random{t};
+                std::uniform_int_distribution<std::size_t> indexes{0, words.size() - 1};
+
+                for (unsigned int i = 0; i < operationsPerThread; ++i)
+                {
+                    const std::string& word = words[indexes(random)];
+
+                    switch (i % 8)
+                    {
+                    case 0:
+                        set.add(word);
+                        break;
+
+                    case 4:
+                        set.remove(word);
+                        break;
+
+                    default:
+                        if (set.contains(word))
+                        {
+                            ++foundByThread;
+                        }
+                        break;
+                    }
+                }
+
+                found += foundByThread;
+            });
+
+        double operations = static_cast<double>(operationsPerThread) * threadCount;
+
+        printResultRow(
+            label,
+            {loadDuration, words.size() / loadDuration * 1000000.0,
+             mixDuration, operations / mixDuration * 1000000.0});
+    }
+
+
+    void LockFreeSkipListSetBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        unsigned int operationsPerThread =
+            readUnsignedParameter("Mixed operations per thread", 1000000);
+
+        std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+
+        if (words.empty())
+        {
+            std::cout << "The word file has no words in it" << std::endl;
+            return;
+        }
+
+        std::shuffle(words.begin(), words.end(), std::mt19937{46});
+
+        std::cout << std::endl;
+        std::cout << words.size() << " dictionary words, "
+                  << operationsPerThread << " mixed operations per thread" << std::endl;
+        std::cout << std::endl;
+
+        printResultHeader("Threads", {"Load (usec)", "Adds/sec", "Mix (usec)", "Ops/sec"});
+
+        for (unsigned int threadCount = 1; threadCount <= 32; threadCount *= 2)
+        {
+            measure<LockedSkipListSet>(
+                "Locked " + std::to_string(threadCount), threadCount, words, operationsPerThread);
+
+            measure<LockFreeSkipListSet<std::string>>(
+                "Lock-free " + std::to_string(threadCount), threadCount, words, operationsPerThread);
+        }
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, LockFreeSkipListSetBenchmark, "LOCK-FREE SKIPLIST");
+
@@ -0,0 +1,137 @@
+// ParallelSpellCheckBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Times SpellChecker::runParallel() checking a large text -- a smaller
+// text file (biginput.txt, by default) repeated as many times as asked --
+// on one thread, then on twice as many, and so on.  A listener counts the
+// misspellings and their suggestions, so that the runs can be checked
+// against each other.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "HashSet.hpp"
+#include "SpellChecker.hpp"
+#include "SpellCheckerListener.hpp"
+#include "Stopwatch.hpp"
+#include "StringHashing.hpp"
+#include "SuggestionIndex.hpp"
+#include "WordChecker.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class ParallelSpellCheckBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    class CountingListener : public SpellCheckerListener
+    {
+    public:
+        void misspellingFound(
+            const std::string& word, const std::string& line,
+            const std::vector<std::string>& suggestions) override
+        {
+            ++misspellings;
+            this->suggestions += suggestions.size();
+        }
+
+        unsigned long misspellings = 0;
+        unsigned long suggestions = 0;
+    };
+
+
+    void ParallelSpellCheckBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        std::string textFilePath = readParameter("Text file", "biginput.txt");
+        unsigned int repetitions = readUnsignedParameter("Repetitions", 20);
+
+        unsigned int maxThreadCount = readUnsignedParameter(
+            "Most threads", std::max(std::thread::hardware_concurrency(), 1u));
+
+        std::ostringstream text;
+        text << std::ifstream{textFilePath, std::ios::binary}.rdbuf();
+
+        std::string corpus;
+
+        for (unsigned int i = 0; i < repetitions; ++i)
+        {
+            corpus += text.str();
+        }
+
+        std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+
+        HashSet<std::string> set{hashStringAsProduct};
+
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+
+        SuggestionIndex suggestionIndex{words};
+        WordChecker wordChecker{set, suggestionIndex};
+
+        std::vector<unsigned int> threadCounts;
+
+        for (unsigned int threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+        {
+            threadCounts.push_back(threadCount);
+        }
+
+        threadCounts.push_back(std::max(maxThreadCount, 1u));
+
+        std::cout << std::endl;
+        std::cout << corpus.size() << " bytes of text, checked against " << set.size()
+                  << " words" << std::endl;
+        std::cout << std::endl;
+
+        printResultHeader("", {"Time (usec)", "Speedup (%)", "Misspellings", "Suggestions"});
+
+        double oneThreadDuration = 0.0;
+
+        for (unsigned int threadCount : threadCounts)
+        {
+            SpellChecker spellChecker;
+            std::shared_ptr<CountingListener> listener = std::make_shared<CountingListener>();
+            spellChecker.addObserver(listener);
+
+            Stopwatch stopwatch;
+            stopwatch.start();
+            spellChecker.runParallel(wordChecker, corpus, threadCount);
+            stopwatch.stop();
+
+            double duration = stopwatch.lastDuration();
+
+            if (threadCount == 1)
+            {
+                oneThreadDuration = duration;
+            }
+
+            printResultRow(
+                std::to_string(threadCount) + (threadCount == 1 ? " thread" : " threads"),
+                {duration, oneThreadDuration / duration * 100.0,
+                 static_cast<double>(listener->misspellings),
+                 static_cast<double>(listener->suggestions)});
+        }
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, ParallelSpellCheckBenchmark, "PARALLEL SPELL CHECK");
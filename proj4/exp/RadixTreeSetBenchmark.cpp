@@ -0,0 +1,167 @@
+// RadixTreeSetBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares RadixTreeSet against HashSet: how long it takes to add every
+// dictionary word, how long it takes to look them all up again (in
+// shuffled order) and to look up the words of a text file, over several
+// passes, and how much memory each uses per word.  Then it times prefix
+// queries -- the thing only the radix tree can do -- by visiting every
+// dictionary word that begins with each of the words' first few letters.
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "HashSet.hpp"
+#include "RadixTreeSet.hpp"
+#include "Stopwatch.hpp"
+#include "StringHashing.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class RadixTreeSetBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    // The lookups' results are counted, so that the compiler can't decide
+    // they're unnecessary and skip them.
+    double timeLookups(const Set<std::string>& set, const std::vector<std::string>& words, unsigned long& found)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (const std::string& word : words)
+        {
+            if (set.contains(word))
+            {
+                ++found;
+            }
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    void measure(
+        const std::string& label, Set<std::string>& set, const std::vector<std::string>& loadWords,
+        const std::vector<std::string>& lookupWords, const std::vector<std::string>& textWords)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (const std::string& word : loadWords)
+        {
+            set.add(word);
+        }
+
+        stopwatch.stop();
+        double loadDuration = stopwatch.lastDuration();
+
+        unsigned long found = 0;
+        double lookupDuration = timeLookups(set, lookupWords, found);
+        double textDuration = timeLookups(set, textWords, found);
+
+        double bytesPerElement =
+            static_cast<double>(set.memoryUsage().totalBytes()) / set.size();
+
+        printResultRow(
+            label,
+            {loadDuration, lookupDuration, lookupWords.size() / lookupDuration * 1000000.0,
+             textDuration, bytesPerElement, static_cast<double>(found)});
+    }
+
+
+    void RadixTreeSetBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        std::string textFilePath = readParameter("Text file", "biginput.txt");
+        unsigned int passes = readUnsignedParameter("Passes over the text", 100);
+        unsigned int prefixLength = readUnsignedParameter("Length of queried prefixes", 3);
+
+        std::vector<std::string> loadWords = WordSetLoader{}.load(wordFilePath);
+        std::vector<std::string> text = loadTextWords(textFilePath);
+
+        if (loadWords.empty() || text.empty())
+        {
+            std::cout << "The word file and the text file must both have words in them" << std::endl;
+            return;
+        }
+
+        std::vector<std::string> lookupWords = loadWords;
+        std::shuffle(loadWords.begin(), loadWords.end(), std::mt19937{46});
+        std::shuffle(lookupWords.begin(), lookupWords.end(), std::mt19937{47});
+
+        std::vector<std::string> textWords;
+
+        for (unsigned int pass = 0; pass < passes; ++pass)
+        {
+            textWords.insert(textWords.end(), text.begin(), text.end());
+        }
+
+        std::cout << std::endl;
+        std::cout << loadWords.size() << " dictionary words, "
+                  << textWords.size() << " words of text (" << passes << " passes)" << std::endl;
+        std::cout << std::endl;
+
+        printResultHeader(
+            "Set",
+            {"Load (usec)", "Lookup (usec)", "Lookups/sec", "Text (usec)", "Bytes/element",
+             "Found"});
+
+        HashSet<std::string> hashSet{hashStringAsProduct};
+        measure("HashSet", hashSet, loadWords, lookupWords, textWords);
+
+        RadixTreeSet radixTreeSet;
+        measure("RadixTreeSet", radixTreeSet, loadWords, lookupWords, textWords);
+
+        // One prefix query per distinct prefix, so the queries together
+        // visit every word that's at least prefixLength characters long
+        // exactly once.
+        std::vector<std::string> prefixes;
+
+        for (const std::string& word : lookupWords)
+        {
+            if (word.length() >= prefixLength)
+            {
+                prefixes.push_back(word.substr(0, prefixLength));
+            }
+        }
+
+        std::sort(prefixes.begin(), prefixes.end());
+        prefixes.erase(std::unique(prefixes.begin(), prefixes.end()), prefixes.end());
+        std::shuffle(prefixes.begin(), prefixes.end(), std::mt19937{48});
+
+        unsigned long visited = 0;
+
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (const std::string& prefix : prefixes)
+        {
+            radixTreeSet.forEachWithPrefix(prefix, [&](const std::string&) { ++visited; });
+        }
+
+        stopwatch.stop();
+
+        std::cout << std::endl;
+        std::cout << prefixes.size() << " prefix queries visited " << visited << " words in "
+                  << stopwatch.lastDuration() << " usec" << std::endl;
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, RadixTreeSetBenchmark, "RADIX TREE");
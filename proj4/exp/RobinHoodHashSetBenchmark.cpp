@@ -0,0 +1,212 @@
+// RobinHoodHashSetBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Runs a mixed stream of adds, removes, and lookups of dictionary words
+// against a RobinHoodHashSet and, for comparison, a std::unordered_set
+// using the same hash function.  (HashSet can't take part, since it has
+// no way to remove an element.)  The set starts out holding half of the
+// dictionary, and adds and removes are equally likely, so its size hovers
+// around that point throughout the run, which is the situation in which
+// tombstone-based deletion would slowly degrade.  The probe lengths of the
+// RobinHoodHashSet are reported at the end, to show they stay short.
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "RobinHoodHashSet.hpp"
+#include "Stopwatch.hpp"
+#include "StringHashing.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class RobinHoodHashSetBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    enum class Operation
+    {
+        add,
+        remove,
+        lookup
+    };
+
+
+    struct Step
+    {
+        Operation operation;
+        const std::string* word;
+    };
+
+
+    struct ProductHash
+    {
+        std::size_t operator()(const std::string& s) const
+        {
+            return hashStringAsProduct(s);
+        }
+    };
+
+
+    std::vector<Step> makeSteps(
+        const std::vector<std::string>& dictionary, unsigned int stepCount,
+        unsigned int lookupPercentage)
+    {
+        std::mt19937 random{46};
+        std::uniform_int_distribution<std::size_t> words{0, dictionary.size() - 1};
+        std::uniform_int_distribution<unsigned int> percentages{0, 99};
+
+        std::vector<Step> steps;
+        steps.reserve(stepCount);
+
+        for (unsigned int i = 0; i < stepCount; ++i)
+        {
+            unsigned int percentage = percentages(random);
+            Operation operation = Operation::lookup;
+
+            if (percentage >= lookupPercentage)
+            {
+                operation = percentage % 2 == 0 ? Operation::add : Operation::remove;
+            }
+
+            steps.push_back(Step{operation, &dictionary[words(random)]});
+        }
+
+        return steps;
+    }
+
+
+    template <typename SetType, typename AddFunction, typename RemoveFunction, typename ContainsFunction>
+    double timeSteps(
+        SetType& set, const std::vector<Step>& steps,
+        AddFunction add, RemoveFunction remove, ContainsFunction contains,
+        unsigned int& found)
+    {
+        Stopwatch stopwatch;
+        found = 0;
+
+        stopwatch.start();
+
+        for (const Step& step : steps)
+        {
+            switch (step.operation)
+            {
+            case Operation::add:
+                add(set, *step.word);
+                break;
+
+            case Operation::remove:
+                remove(set, *step.word);
+                break;
+
+            case Operation::lookup:
+                if (contains(set, *step.word))
+                {
+                    ++found;
+                }
+                break;
+            }
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    void RobinHoodHashSetBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        unsigned int stepCount = readUnsignedParameter("Operations", 5000000);
+        unsigned int lookupPercentage = readUnsignedParameter("Lookup percentage", 50);
+
+        if (lookupPercentage > 100)
+        {
+            lookupPercentage = 100;
+        }
+
+        std::vector<std::string> dictionary = WordSetLoader{}.load(wordFilePath);
+
+        if (dictionary.empty())
+        {
+            std::cout << "The word file has no words in it" << std::endl;
+            return;
+        }
+
+        std::vector<Step> steps = makeSteps(dictionary, stepCount, lookupPercentage);
+
+        RobinHoodHashSet<std::string> robinHoodSet{hashStringAsProduct};
+        std::unordered_set<std::string, ProductHash> unorderedSet;
+
+        for (std::size_t i = 0; i < dictionary.size(); i += 2)
+        {
+            robinHoodSet.add(dictionary[i]);
+            unorderedSet.insert(dictionary[i]);
+        }
+
+        unsigned int robinHoodFound;
+        double robinHoodDuration = timeSteps(
+            robinHoodSet, steps,
+            [](auto& s, const std::string& w) { s.add(w); },
+            [](auto& s, const std::string& w) { s.remove(w); },
+            [](const auto& s, const std::string& w) { return s.contains(w); },
+            robinHoodFound);
+
+        unsigned int unorderedFound;
+        double unorderedDuration = timeSteps(
+            unorderedSet, steps,
+            [](auto& s, const std::string& w) { s.insert(w); },
+            [](auto& s, const std::string& w) { s.erase(w); },
+            [](const auto& s, const std::string& w) { return s.count(w) != 0; },
+            unorderedFound);
+
+        std::cout << std::endl;
+        std::cout << dictionary.size() << " dictionary words, " << steps.size()
+                  << " operations (" << lookupPercentage << "% lookups)" << std::endl;
+
+        if (robinHoodFound != unorderedFound || robinHoodSet.size() != unorderedSet.size())
+        {
+            std::cout << "WARNING: the sets disagree (" << robinHoodFound << " vs. "
+                      << unorderedFound << " words found)" << std::endl;
+        }
+
+        std::cout << std::endl;
+
+        printResultHeader("", {"Time (usec)", "Ops/sec", "Final size"});
+
+        printResultRow(
+            "RobinHoodHashSet",
+            {robinHoodDuration, steps.size() / robinHoodDuration * 1000000.0,
+             static_cast<double>(robinHoodSet.size())});
+
+        printResultRow(
+            "unordered_set",
+            {unorderedDuration, steps.size() / unorderedDuration * 1000000.0,
+             static_cast<double>(unorderedSet.size())});
+
+        RobinHoodHashSet<std::string>::ProbeStatistics statistics =
+            robinHoodSet.probeStatistics();
+
+        std::cout << std::endl;
+        std::cout << "RobinHoodHashSet capacity: " << robinHoodSet.capacity() << std::endl;
+        std::cout << "Longest probe length: " << statistics.maxProbeLength
+                  << " (bound " << RobinHoodHashSet<std::string>::MAX_PROBE_LENGTH << ")" << std::endl;
+        std::cout << "Average probe length: " << statistics.averageProbeLength << std::endl;
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, RobinHoodHashSetBenchmark, "ROBIN HOOD HASH");
+
@@ -0,0 +1,211 @@
+// SkipListFingerBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures how much SkipListSet's finger searches help when the elements
+// being searched for arrive in sorted order.  The dictionary is loaded into
+// an empty SkipListSet twice -- once in sorted order (as it comes from the
+// word file) and once shuffled -- and then every dictionary word is looked
+// up, first in sorted order and then shuffled, followed by the words of a
+// text file, in the order they appear, over several passes.  Sorted lookups
+// move the finger only a short distance each time, while shuffled ones
+// jump all over the skip list; lookups without a finger, and std::set,
+// which always searches from its root, are measured the same way for
+// comparison.  (All times are in usec.)
+// Finally, forEachInRange() is used to count the dictionary words starting
+// with each letter.
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "SkipListSet.hpp"
+#include "Stopwatch.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class SkipListFingerBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    template <typename SetType>
+    double timeLoad(SetType& set, const std::vector<std::string>& words)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (const std::string& word : words)
+        {
+            set.insert(word);
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    // The lookups' results are counted, so that the compiler can't decide
+    // they're unnecessary and skip them.
+    template <typename SetType>
+    double timeLookups(const SetType& set, const std::vector<std::string>& words, unsigned long& found)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (const std::string& word : words)
+        {
+            if (set.count(word) != 0)
+            {
+                ++found;
+            }
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    // SkipListAdapter gives a SkipListSet the names that std::set uses, so
+    // both can be timed by the same functions.  Its lookups search from a
+    // Finger of its own, or, if UseFinger is false, from the top.
+    template <bool UseFinger>
+    class SkipListAdapter
+    {
+    public:
+        void insert(const std::string& word)
+        {
+            set.add(word);
+        }
+
+        unsigned int count(const std::string& word) const
+        {
+            if constexpr (UseFinger)
+            {
+                return set.containsFrom(finger, word) ? 1 : 0;
+            }
+            else
+            {
+                return set.contains(word) ? 1 : 0;
+            }
+        }
+
+    private:
+        SkipListSet<std::string> set;
+        mutable SkipListSet<std::string>::Finger finger;
+    };
+
+
+    template <typename SetType>
+    void measure(
+        const std::string& label, const std::vector<std::string>& sortedWords,
+        const std::vector<std::string>& shuffledWords, const std::vector<std::string>& textWords)
+    {
+        SetType fromSorted;
+        double sortedLoad = timeLoad(fromSorted, sortedWords);
+
+        SetType fromShuffled;
+        double shuffledLoad = timeLoad(fromShuffled, shuffledWords);
+
+        unsigned long found = 0;
+        double sortedLookups = timeLookups(fromSorted, sortedWords, found);
+        double shuffledLookups = timeLookups(fromSorted, shuffledWords, found);
+        double textLookups = timeLookups(fromSorted, textWords, found);
+
+        printResultRow(
+            label,
+            {sortedLoad, shuffledLoad, sortedLookups, shuffledLookups, textLookups,
+             static_cast<double>(found)});
+    }
+
+
+    void measureRanges(const std::vector<std::string>& sortedWords)
+    {
+        SkipListSet<std::string> set;
+
+        for (const std::string& word : sortedWords)
+        {
+            set.add(word);
+        }
+
+        Stopwatch stopwatch;
+        unsigned long visited = 0;
+
+        stopwatch.start();
+
+        for (char letter = 'A'; letter <= 'Z'; ++letter)
+        {
+            set.forEachInRange(
+                std::string(1, letter), std::string(1, letter + 1),
+                [&](const std::string&) { ++visited; });
+        }
+
+        stopwatch.stop();
+
+        std::cout << std::endl;
+        std::cout << "forEachInRange() visited " << visited << " words, one letter at a time, in "
+                  << stopwatch.lastDuration() << " usec" << std::endl;
+    }
+
+
+    void SkipListFingerBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        std::string textFilePath = readParameter("Text file", "biginput.txt");
+        unsigned int passes = readUnsignedParameter("Passes over the text", 100);
+
+        std::vector<std::string> sortedWords = WordSetLoader{}.load(wordFilePath);
+        std::vector<std::string> text = loadTextWords(textFilePath);
+
+        if (sortedWords.empty() || text.empty())
+        {
+            std::cout << "The word file and the text file must both have words in them" << std::endl;
+            return;
+        }
+
+        std::sort(sortedWords.begin(), sortedWords.end());
+
+        std::vector<std::string> shuffledWords = sortedWords;
+        std::shuffle(shuffledWords.begin(), shuffledWords.end(), std::mt19937{46});
+
+        std::vector<std::string> textWords;
+
+        for (unsigned int pass = 0; pass < passes; ++pass)
+        {
+            textWords.insert(textWords.end(), text.begin(), text.end());
+        }
+
+        std::cout << std::endl;
+        std::cout << sortedWords.size() << " dictionary words, "
+                  << textWords.size() << " words of text (" << passes << " passes)" << std::endl;
+        std::cout << std::endl;
+
+        printResultHeader(
+            "Set",
+            {"Sorted load", "Random load", "Sorted lookups", "Random lookups",
+             "Text lookups", "Found"});
+
+        measure<SkipListAdapter<true>>("SkipListSet", sortedWords, shuffledWords, textWords);
+        measure<SkipListAdapter<false>>(
+            "SkipListSet (no finger)", sortedWords, shuffledWords, textWords);
+        measure<std::set<std::string>>("std::set", sortedWords, shuffledWords, textWords);
+
+        measureRanges(sortedWords);
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, SkipListFingerBenchmark, "SKIPLIST FINGER");
+
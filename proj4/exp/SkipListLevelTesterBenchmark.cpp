@@ -0,0 +1,125 @@
+// SkipListLevelTesterBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares the level testers that a SkipListSet can use to decide how many
+// levels each new key occupies: RandomSkipListLevelTester, which flips one
+// std::bernoulli_distribution coin per level, and GeometricSkipListLevelTester,
+// which chooses the whole height from one random number (with a branching
+// probability of 1/2, and also of 1/4).  For each, it measures how long it
+// takes to choose a large number of heights on their own, and then how long
+// it takes to add every dictionary word (in shuffled order) to an empty
+// SkipListSet, along with the shape of the resulting skip list.
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "SkipListSet.hpp"
+#include "Stopwatch.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class SkipListLevelTesterBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    using LevelTesterFactory =
+        std::function<std::unique_ptr<SkipListLevelTester<std::string>>()>;
+
+
+    void measure(
+        const std::string& label, const LevelTesterFactory& makeLevelTester,
+        const std::vector<std::string>& words, unsigned int heightCount)
+    {
+        Stopwatch stopwatch;
+
+        std::unique_ptr<SkipListLevelTester<std::string>> levelTester = makeLevelTester();
+        unsigned long totalHeight = 0;
+        const std::string& word = words.front();
+
+        stopwatch.start();
+
+        for (unsigned int i = 0; i < heightCount; ++i)
+        {
+            totalHeight += levelTester->chooseHeight(word, 32);
+        }
+
+        stopwatch.stop();
+        double heightDuration = stopwatch.lastDuration();
+
+        SkipListSet<std::string> set{makeLevelTester()};
+
+        stopwatch.start();
+
+        for (const std::string& w : words)
+        {
+            set.add(w);
+        }
+
+        stopwatch.stop();
+        double addDuration = stopwatch.lastDuration();
+
+        printResultRow(
+            label,
+            {heightDuration, static_cast<double>(totalHeight) / heightCount * 1000.0,
+             addDuration, words.size() / addDuration * 1000000.0,
+             static_cast<double>(set.levelCount())});
+    }
+
+
+    void SkipListLevelTesterBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        unsigned int heightCount = readUnsignedParameter("Heights to choose", 10000000);
+
+        std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+
+        if (words.empty() || heightCount == 0)
+        {
+            std::cout << "Nothing to measure" << std::endl;
+            return;
+        }
+
+        std::shuffle(words.begin(), words.end(), std::mt19937{46});
+
+        std::cout << std::endl;
+        std::cout << heightCount << " heights, " << words.size() << " dictionary words" << std::endl;
+        std::cout << std::endl;
+
+        printResultHeader(
+            "", {"Heights (usec)", "Height x 1000", "Adds (usec)", "Adds/sec", "Levels"});
+
+        measure(
+            "Random 1/2",
+            []() { return std::make_unique<RandomSkipListLevelTester<std::string>>(); },
+            words, heightCount);
+
+        measure(
+            "Geometric 1/2",
+            []() { return std::make_unique<GeometricSkipListLevelTester<std::string>>(1); },
+            words, heightCount);
+
+        measure(
+            "Geometric 1/4",
+            []() { return std::make_unique<GeometricSkipListLevelTester<std::string>>(2); },
+            words, heightCount);
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, SkipListLevelTesterBenchmark, "LEVEL TESTER");
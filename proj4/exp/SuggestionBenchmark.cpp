@@ -0,0 +1,192 @@
+// SuggestionBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares the two ways WordChecker can find suggestions: generating every
+// possible edit of a misspelled word and looking each one up in a HashSet,
+// or asking a SuggestionIndex.  The misspellings are the words of a text
+// file (every word of biginput.txt is misspelled) plus dictionary words
+// with one random edit -- or two, for words that are harder to match --
+// applied to them.  Both ways have to agree on every suggestion.
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "HashSet.hpp"
+#include "Stopwatch.hpp"
+#include "StringHashing.hpp"
+#include "SuggestionIndex.hpp"
+#include "WordChecker.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    class SuggestionBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    // Applies one random swap, insertion, deletion, or replacement.
+    void misspell(std::string& word, std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> letters{'A', 'Z'};
+        std::uniform_int_distribution<std::size_t> positions{0, word.length()};
+        std::size_t position = positions(random);
+
+        switch (random() % 4)
+        {
+        case 0:
+            if (position + 1 < word.length())
+            {
+                std::swap(word[position], word[position + 1]);
+                break;
+            }
+
+            // Fall through, since there's nothing to swap at the end.
+            [[fallthrough]];
+
+        case 1:
+            word.insert(word.begin() + position, static_cast<char>(letters(random)));
+            break;
+
+        case 2:
+            if (position < word.length())
+            {
+                word.erase(position, 1);
+                break;
+            }
+
+            word.push_back(static_cast<char>(letters(random)));
+            break;
+
+        default:
+            if (position < word.length())
+            {
+                word[position] = static_cast<char>(letters(random));
+            }
+            else
+            {
+                word.push_back(static_cast<char>(letters(random)));
+            }
+
+            break;
+        }
+    }
+
+
+    double timeSuggestions(
+        const WordChecker& checker, const std::vector<std::string>& misspellings,
+        std::vector<std::vector<std::string>>& suggestions)
+    {
+        suggestions.clear();
+        suggestions.reserve(misspellings.size());
+
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (const std::string& misspelling : misspellings)
+        {
+            suggestions.push_back(checker.findSuggestions(misspelling));
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    void SuggestionBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        std::string textFilePath = readParameter("Text file", "biginput.txt");
+        unsigned int generatedCount = readUnsignedParameter("Generated misspellings", 20000);
+
+        std::vector<std::string> dictionary = WordSetLoader{}.load(wordFilePath);
+
+        if (dictionary.empty())
+        {
+            std::cout << "The word file must have words in it" << std::endl;
+            return;
+        }
+
+        std::vector<std::string> misspellings = loadTextWords(textFilePath);
+        std::mt19937 random{46};
+        std::uniform_int_distribution<std::size_t> wordIndexes{0, dictionary.size() - 1};
+
+        for (unsigned int i = 0; i < generatedCount; ++i)
+        {
+            std::string word = dictionary[wordIndexes(random)];
+            misspell(word, random);
+
+            if (i % 4 == 0)
+            {
+                misspell(word, random);
+            }
+
+            misspellings.push_back(word);
+        }
+
+        HashSet<std::string> set{hashStringAsProduct};
+
+        for (const std::string& word : dictionary)
+        {
+            set.add(word);
+        }
+
+        Stopwatch stopwatch;
+        stopwatch.start();
+        SuggestionIndex index{dictionary};
+        stopwatch.stop();
+        double buildDuration = stopwatch.lastDuration();
+
+        std::vector<std::vector<std::string>> generatedSuggestions;
+        double generatingDuration =
+            timeSuggestions(WordChecker{set}, misspellings, generatedSuggestions);
+
+        std::vector<std::vector<std::string>> indexedSuggestions;
+        double indexedDuration =
+            timeSuggestions(WordChecker{set, index}, misspellings, indexedSuggestions);
+
+        unsigned long suggestionCount = 0;
+
+        for (const std::vector<std::string>& suggestions : indexedSuggestions)
+        {
+            suggestionCount += suggestions.size();
+        }
+
+        std::cout << std::endl;
+        std::cout << dictionary.size() << " dictionary words, " << misspellings.size()
+                  << " misspellings, " << suggestionCount << " suggestions" << std::endl;
+        std::cout << "SuggestionIndex built in " << buildDuration << " usec, using "
+                  << index.memoryBytes() << " bytes" << std::endl;
+
+        if (generatedSuggestions != indexedSuggestions)
+        {
+            std::cout << "WARNING: the two ways found different suggestions" << std::endl;
+        }
+
+        std::cout << std::endl;
+
+        printResultHeader("", {"Total (usec)", "usec/word"});
+
+        printResultRow(
+            "Generating",
+            {generatingDuration, generatingDuration / misspellings.size()});
+
+        printResultRow(
+            "Indexed",
+            {indexedDuration, indexedDuration / misspellings.size()});
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, SuggestionBenchmark, "SUGGESTIONS");
@@ -0,0 +1,181 @@
+// TextFileReaderBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares how quickly TextFileReader and MappedTextFileReader split a
+// large text file into words, in megabytes per second.  The file is built
+// by repeating a smaller one (biginput.txt, by default) as many times as
+// asked, and written to the system's temporary directory.  Each word's
+// length and its line's length are added up, the way the SpellChecker
+// would use both, so that the compiler can't skip reading them, and so
+// that the two readers can be checked against each other.
+//
+// Separately, the WordTokenizer functions that both readers use are timed
+// splitting the same text, already in memory, into words: once classifying
+// and uppercasing a block at a time, and once a character at a time.
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "MappedTextFileReader.hpp"
+#include "Stopwatch.hpp"
+#include "TextFileReader.hpp"
+#include "WordTokenizer.hpp"
+
+
+
+namespace
+{
+    class TextFileReaderBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    struct ReadTotals
+    {
+        unsigned long words = 0;
+        unsigned long characters = 0;
+    };
+
+
+    template <typename Reader>
+    double timeReading(const std::string& filePath, ReadTotals& totals)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        Reader reader{filePath};
+
+        while (!reader.noMoreWords())
+        {
+            ++totals.words;
+            totals.characters += reader.currentWord().length() + reader.currentLine().length();
+            reader.advanceToNextWord();
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    template <typename FindNextWord, typename AssignUppercaseWord>
+    double timeTokenizing(
+        std::string_view text, FindNextWord findNextWord, AssignUppercaseWord assignUppercaseWord,
+        ReadTotals& totals)
+    {
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        std::string word;
+        WordBounds bounds;
+
+        for (std::size_t position = 0; findNextWord(text, position, bounds); position = bounds.next)
+        {
+            assignUppercaseWord(word, text, bounds);
+            ++totals.words;
+            totals.characters += word.length();
+        }
+
+        stopwatch.stop();
+        return stopwatch.lastDuration();
+    }
+
+
+    void TextFileReaderBenchmark::run()
+    {
+        std::string textFilePath = readParameter("Text file", "biginput.txt");
+        unsigned int repetitions = readUnsignedParameter("Repetitions", 2000);
+
+        std::ostringstream text;
+        text << std::ifstream{textFilePath, std::ios::binary}.rdbuf();
+
+        if (text.str().empty())
+        {
+            std::cout << "The text file must have text in it" << std::endl;
+            return;
+        }
+
+        std::string corpus;
+        corpus.reserve(text.str().size() * repetitions);
+
+        for (unsigned int i = 0; i < repetitions; ++i)
+        {
+            corpus += text.str();
+        }
+
+        std::string corpusPath =
+            (std::filesystem::temp_directory_path() / "TextFileReaderBenchmark.txt").string();
+
+        std::ofstream{corpusPath, std::ios::binary} << corpus;
+
+        double megabytes = corpus.size() / 1000000.0;
+
+        // The first read of the file brings it into the page cache, so
+        // neither reader is timed reading it from the disk.
+        ReadTotals warmupTotals;
+        timeReading<MappedTextFileReader>(corpusPath, warmupTotals);
+
+        ReadTotals streamTotals;
+        ReadTotals mappedTotals;
+
+        double streamDuration = timeReading<TextFileReader>(corpusPath, streamTotals);
+        double mappedDuration = timeReading<MappedTextFileReader>(corpusPath, mappedTotals);
+
+        std::filesystem::remove(corpusPath);
+
+        ReadTotals blockTotals;
+        ReadTotals scalarTotals;
+
+        double blockDuration = timeTokenizing(
+            corpus, findNextWord, assignUppercaseWord, blockTotals);
+
+        double scalarDuration = timeTokenizing(
+            corpus, findNextWordScalar, assignUppercaseWordScalar, scalarTotals);
+
+        std::cout << std::endl;
+        std::cout << megabytes << " MB, " << streamTotals.words << " words" << std::endl;
+
+        if (streamTotals.words != mappedTotals.words
+            || streamTotals.characters != mappedTotals.characters)
+        {
+            std::cout << "WARNING: the readers disagree" << std::endl;
+        }
+
+        if (blockTotals.words != scalarTotals.words
+            || blockTotals.characters != scalarTotals.characters)
+        {
+            std::cout << "WARNING: the tokenizers disagree" << std::endl;
+        }
+
+        std::cout << std::endl;
+
+        printResultHeader("", {"Time (usec)", "MB/sec", "Words/sec"});
+
+        auto printRow =
+            [&](const std::string& label, double duration, const ReadTotals& totals)
+            {
+                printResultRow(
+                    label,
+                    {duration, megabytes / duration * 1000000.0,
+                     totals.words / duration * 1000000.0});
+            };
+
+        printRow("TextFileReader", streamDuration, streamTotals);
+        printRow("Mapped", mappedDuration, mappedTotals);
+        printRow("Block tokens", blockDuration, blockTotals);
+        printRow("Scalar tokens", scalarDuration, scalarTotals);
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, TextFileReaderBenchmark, "TEXT READER");
@@ -0,0 +1,235 @@
+// WordSetLoaderBenchmark.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares the time it takes to load a large word file, and how many
+// allocations it takes, three ways: reading it a line at a time with
+// std::getline (the way WordSetLoader::load() used to), with
+// WordSetLoader::load(), and with WordSetLoader::loadWordList().  The
+// file is built from a smaller one (wordset.txt, by default), whose words
+// are repeated with suffixes until there are as many as asked, lowercased
+// so that each loader has uppercasing to do, and written to the system's
+// temporary directory.
+//
+// Allocations are counted by replacing the global operator new (for this
+// whole benchmark program) with one that counts its calls before handing
+// them on to std::malloc, which is what the one it replaces would do.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
+#include "BenchmarkUtilities.hpp"
+#include "Stopwatch.hpp"
+#include "WordList.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    std::atomic<unsigned long> allocationCount{0};
+
+
+    void* countedAllocate(std::size_t size)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        void* memory = std::malloc(size > 0 ? size : 1);
+
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc{};
+        }
+
+        return memory;
+    }
+
+
+    void countedFree(void* memory) noexcept
+    {
+        std::free(memory);
+    }
+}
+
+
+void* operator new(std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+
+void operator delete(void* memory) noexcept
+{
+    countedFree(memory);
+}
+
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    countedFree(memory);
+}
+
+
+namespace
+{
+    class WordSetLoaderBenchmark : public Benchmark
+    {
+    public:
+        void run() override;
+    };
+
+
+    std::vector<std::string> loadByLines(const std::string& wordFilePath)
+    {
+        std::vector<std::string> words;
+        std::ifstream wordFile{wordFilePath};
+        std::string word;
+
+        while (std::getline(wordFile, word))
+        {
+            std::transform(word.begin(), word.end(), word.begin(), ::toupper);
+            word.erase(
+                std::remove_if(
+                    word.begin(), word.end(),
+                    [](char c) { return c == '\r' || c == '\n'; }),
+                word.end());
+
+            words.push_back(word);
+        }
+
+        return words;
+    }
+
+
+    struct LoadResult
+    {
+        double duration;
+        unsigned long allocations;
+        unsigned long words;
+        unsigned long characters;
+    };
+
+
+    // The loaded words' lengths are added up, so that the loaders can be
+    // checked against each other.
+    template <typename Load>
+    LoadResult timeLoading(Load load)
+    {
+        Stopwatch stopwatch;
+        unsigned long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+
+        stopwatch.start();
+        auto words = load();
+        stopwatch.stop();
+
+        LoadResult result{
+            stopwatch.lastDuration(),
+            allocationCount.load(std::memory_order_relaxed) - allocationsBefore,
+            static_cast<unsigned long>(words.size()),
+            0};
+
+        for (std::size_t i = 0; i < words.size(); ++i)
+        {
+            result.characters += words[i].size();
+        }
+
+        return result;
+    }
+
+
+    std::string suffixFor(unsigned int round)
+    {
+        std::string suffix;
+
+        for (; round > 0; round /= 26)
+        {
+            suffix += static_cast<char>('a' + (round - 1) % 26);
+        }
+
+        return suffix;
+    }
+
+
+    void WordSetLoaderBenchmark::run()
+    {
+        std::string wordFilePath = readParameter("Word file", "wordset.txt");
+        unsigned int wordCount = readUnsignedParameter("Words", 500000);
+
+        std::vector<std::string> baseWords = WordSetLoader{}.load(wordFilePath);
+
+        if (baseWords.empty())
+        {
+            std::cout << "The word file must have words in it" << std::endl;
+            return;
+        }
+
+        std::string listPath =
+            (std::filesystem::temp_directory_path() / "WordSetLoaderBenchmark.txt").string();
+
+        {
+            std::ofstream listFile{listPath, std::ios::binary};
+
+            for (unsigned int i = 0; i < wordCount; ++i)
+            {
+                std::string word =
+                    baseWords[i % baseWords.size()] + suffixFor(i / baseWords.size());
+
+                std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+                listFile << word << '\n';
+            }
+        }
+
+        // The first load brings the file into the page cache, so none of
+        // the loaders is timed reading it from the disk.
+        WordSetLoader{}.loadWordList(listPath);
+
+        LoadResult byLines = timeLoading([&]() { return loadByLines(listPath); });
+        LoadResult asStrings = timeLoading([&]() { return WordSetLoader{}.load(listPath); });
+        LoadResult asList = timeLoading([&]() { return WordSetLoader{}.loadWordList(listPath); });
+
+        std::filesystem::remove(listPath);
+
+        std::cout << std::endl;
+        std::cout << byLines.words << " words, " << byLines.characters << " characters" << std::endl;
+
+        for (const LoadResult& result : {asStrings, asList})
+        {
+            if (result.words != byLines.words || result.characters != byLines.characters)
+            {
+                std::cout << "WARNING: the loaders disagree" << std::endl;
+                break;
+            }
+        }
+
+        std::cout << std::endl;
+
+        printResultHeader("", {"Time (usec)", "Allocations", "Words/sec"});
+
+        auto printRow =
+            [&](const std::string& label, const LoadResult& result)
+            {
+                printResultRow(
+                    label,
+                    {result.duration, static_cast<double>(result.allocations),
+                     result.words / result.duration * 1000000.0});
+            };
+
+        printRow("getline", byLines);
+        printRow("load()", asStrings);
+        printRow("loadWordList()", asList);
+    }
+}
+
+
+
+ICS46_DYNAMIC_FACTORY_REGISTER(Benchmark, WordSetLoaderBenchmark, "WORD LOADER");
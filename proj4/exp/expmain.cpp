@@ -6,11 +6,38 @@
 // Do whatever you'd like here.  This is intended to allow you to experiment
 // with your code, outside of the context of the broader program or Google
 // Test.
+//
+// The first line of the standard input names one of the benchmarks that
+// have registered themselves with the DynamicFactory<Benchmark>; that
+// benchmark is then run.  If the name is blank or unknown, the names of
+// all of the registered benchmarks are listed instead.
+
+#include <iostream>
+#include <string>
+#include <ics46/factory/DynamicFactory.hpp>
+#include "Benchmark.hpp"
 
 
 int main()
 {
+    using BenchmarkFactory = ics46::factory::DynamicFactory<Benchmark>;
+
+    std::string name;
+    std::getline(std::cin, name);
+
+    try
+    {
+        BenchmarkFactory::instance().make(name)->run();
+    }
+    catch (ics46::factory::UnregisteredNameException& e)
+    {
+        std::cout << "Available benchmarks:" << std::endl;
 
+        for (const auto& registeredType : BenchmarkFactory::instance().allRegisteredTypes())
+        {
+            std::cout << "    " << registeredType->name() << std::endl;
+        }
+    }
 
     return 0;
 }
@@ -0,0 +1,218 @@
+// AVLSet_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for AVLSet beyond the sanity checks: the shapes that each kind
+// of rotation leaves behind, how tall balanced and unbalanced trees get,
+// and traversals of trees far too deep to have been traversed recursively.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+
+
+namespace
+{
+    template <typename ElementType>
+    std::vector<ElementType> preorderOf(const AVLSet<ElementType>& s)
+    {
+        std::vector<ElementType> elements;
+        s.preorder([&](const ElementType& element) { elements.push_back(element); });
+        return elements;
+    }
+
+
+    template <typename ElementType>
+    std::vector<ElementType> inorderOf(const AVLSet<ElementType>& s)
+    {
+        std::vector<ElementType> elements;
+        s.inorder([&](const ElementType& element) { elements.push_back(element); });
+        return elements;
+    }
+
+
+    template <typename ElementType>
+    std::vector<ElementType> postorderOf(const AVLSet<ElementType>& s)
+    {
+        std::vector<ElementType> elements;
+        s.postorder([&](const ElementType& element) { elements.push_back(element); });
+        return elements;
+    }
+
+
+    AVLSet<int> makeSet(std::initializer_list<int> elements, bool shouldBalance = true)
+    {
+        AVLSet<int> s{shouldBalance};
+
+        for (int element : elements)
+        {
+            s.add(element);
+        }
+
+        return s;
+    }
+}
+
+
+TEST(AVLSet_Tests, everyKindOfRotationGivesTheSameShape)
+{
+    // Left-left, right-right, left-right, and right-left, in that order.
+    for (const AVLSet<int>& s :
+         {makeSet({3, 2, 1}), makeSet({1, 2, 3}), makeSet({3, 1, 2}), makeSet({1, 3, 2})})
+    {
+        EXPECT_EQ((std::vector<int>{2, 1, 3}), preorderOf(s));
+        EXPECT_EQ(1, s.height());
+    }
+}
+
+
+TEST(AVLSet_Tests, traversalsFollowTheShapeOfTheTree)
+{
+    AVLSet<int> s = makeSet({1, 2, 3, 4, 5, 6, 7});
+
+    EXPECT_EQ(2, s.height());
+    EXPECT_EQ((std::vector<int>{4, 2, 1, 3, 6, 5, 7}), preorderOf(s));
+    EXPECT_EQ((std::vector<int>{1, 2, 3, 4, 5, 6, 7}), inorderOf(s));
+    EXPECT_EQ((std::vector<int>{1, 3, 2, 5, 7, 6, 4}), postorderOf(s));
+}
+
+
+TEST(AVLSet_Tests, emptyTreesHaveNothingToTraverse)
+{
+    AVLSet<int> s;
+
+    EXPECT_TRUE(preorderOf(s).empty());
+    EXPECT_TRUE(inorderOf(s).empty());
+    EXPECT_TRUE(postorderOf(s).empty());
+}
+
+
+TEST(AVLSet_Tests, balancedTreesStayShortWhenAddingInOrder)
+{
+    constexpr int count = 1000000;
+    AVLSet<int> s;
+
+    for (int i = 0; i < count; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(count, s.size());
+    EXPECT_LE(s.height(), 1.45 * std::log2(count + 2));
+}
+
+
+TEST(AVLSet_Tests, deepUnbalancedTreesCanBeTraversed)
+{
+    // Elements added in ascending order without balancing form a single
+    // chain, far deeper than a recursive traversal could handle.
+    constexpr int count = 200000;
+    AVLSet<int> s{false};
+
+    for (int i = 0; i < count; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(count - 1, s.height());
+    EXPECT_TRUE(s.contains(count - 1));
+
+    std::vector<int> ascending(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        ascending[i] = i;
+    }
+
+    std::vector<int> descending{ascending.rbegin(), ascending.rend()};
+
+    EXPECT_EQ(ascending, preorderOf(s));
+    EXPECT_EQ(ascending, inorderOf(s));
+    EXPECT_EQ(descending, postorderOf(s));
+}
+
+
+TEST(AVLSet_Tests, unbalancedHeightIsDeepestNode)
+{
+    AVLSet<int> s = makeSet({50, 25, 75, 10, 30, 5}, false);
+    EXPECT_EQ(3, s.height());
+
+    s.add(1);
+    EXPECT_EQ(4, s.height());
+
+    s.add(80);
+    EXPECT_EQ(4, s.height());
+}
+
+
+TEST(AVLSet_Tests, containsMatchesStdSet)
+{
+    for (bool shouldBalance : {true, false})
+    {
+        AVLSet<std::string> s{shouldBalance};
+        std::set<std::string> expected;
+
+        std::mt19937 random{46};
+        std::uniform_int_distribution<int> keys{0, 9999};
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            std::string key = std::to_string(keys(random));
+            s.add(key);
+            expected.insert(key);
+        }
+
+        EXPECT_EQ(expected.size(), s.size());
+        EXPECT_EQ(std::vector<std::string>(expected.begin(), expected.end()), inorderOf(s));
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            std::string key = std::to_string(i);
+            EXPECT_EQ(expected.count(key) == 1, s.contains(key));
+        }
+    }
+}
+
+
+TEST(AVLSet_Tests, copiesHaveTheSameShapeAndAreIndependent)
+{
+    AVLSet<int> s1 = makeSet({5, 3, 8, 1, 4, 7, 9, 2, 6});
+    AVLSet<int> s2{s1};
+
+    EXPECT_EQ(preorderOf(s1), preorderOf(s2));
+    EXPECT_EQ(s1.height(), s2.height());
+
+    s2.add(10);
+    s2.add(11);
+    EXPECT_FALSE(s1.contains(10));
+    EXPECT_TRUE(s2.contains(11));
+    EXPECT_EQ(9, s1.size());
+
+    // Copies keep the original's choice about balancing, too.
+    AVLSet<int> unbalanced = makeSet({1, 2, 3}, false);
+    s1 = unbalanced;
+    s1.add(4);
+    EXPECT_EQ(3, s1.height());
+}
+
+
+TEST(AVLSet_Tests, movedAndAssignedSetsKeepWorking)
+{
+    AVLSet<int> s1 = makeSet({1, 2, 3});
+    AVLSet<int> s2 = makeSet({4, 5, 6, 7});
+
+    s1 = std::move(s2);
+    EXPECT_EQ(4, s1.size());
+    s1.add(8);
+    EXPECT_EQ((std::vector<int>{4, 5, 6, 7, 8}), inorderOf(s1));
+
+    AVLSet<int> s3{std::move(s1)};
+    EXPECT_EQ(5, s3.size());
+    EXPECT_TRUE(s3.contains(8));
+}
@@ -0,0 +1,307 @@
+// BTreeSet_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for BTreeSet, including its key prefixes, which have to agree
+// with the ordering of the keys for the in-node searches to be correct.
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BTreeSet.hpp"
+
+
+namespace
+{
+    template <typename ElementType>
+    std::vector<ElementType> elementsOf(const BTreeSet<ElementType>& s)
+    {
+        std::vector<ElementType> elements;
+        s.inorder([&](const ElementType& element) { elements.push_back(element); });
+        return elements;
+    }
+
+
+    // A Point has no BTreeKeyPrefix of its own, so every one of its
+    // prefixes is 0 and every in-node search compares keys in full.
+    struct Point
+    {
+        int x;
+        int y;
+    };
+
+
+    bool operator<(const Point& a, const Point& b)
+    {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+
+
+    bool operator==(const Point& a, const Point& b)
+    {
+        return a.x == b.x && a.y == b.y;
+    }
+}
+
+
+TEST(BTreeSet_Tests, inheritFromSet)
+{
+    BTreeSet<std::string> s;
+    Set<std::string>& ss = s;
+    EXPECT_EQ(0, ss.size());
+    EXPECT_TRUE(ss.isImplemented());
+    EXPECT_EQ(-1, s.height());
+}
+
+
+TEST(BTreeSet_Tests, containsOnlyElementsAdded)
+{
+    BTreeSet<int> s;
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        s.add(i);
+    }
+
+    for (int i = -10; i < 1010; ++i)
+    {
+        EXPECT_EQ(i >= 0 && i < 1000 && i % 2 == 0, s.contains(i));
+    }
+
+    EXPECT_EQ(500, s.size());
+}
+
+
+TEST(BTreeSet_Tests, addingDuplicatesHasNoEffect)
+{
+    BTreeSet<std::string> s;
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            s.add(std::to_string(i));
+        }
+    }
+
+    EXPECT_EQ(100, s.size());
+    EXPECT_EQ(100, elementsOf(s).size());
+}
+
+
+TEST(BTreeSet_Tests, heightGrowsOneLevelPerSplitRoot)
+{
+    BTreeSet<int> s;
+
+    for (int i = 0; i < static_cast<int>(BTreeSet<int>::NODE_CAPACITY); ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(0, s.height());
+
+    s.add(BTreeSet<int>::NODE_CAPACITY);
+    EXPECT_EQ(1, s.height());
+
+    // Every node but the root is at least half full, so a million
+    // elements take no more than about log8(1000000) levels.
+    for (int i = 0; i < 1000000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_LE(s.height(), 6);
+}
+
+
+TEST(BTreeSet_Tests, ascendingAddsFillEveryNode)
+{
+    // A root with 16 keys has 17 children, so when every leaf is full, a
+    // tree of height 1 holds 17 * 16 = 272 elements.
+    constexpr int capacity = BTreeSet<int>::NODE_CAPACITY;
+    BTreeSet<int> s;
+
+    for (int i = 0; i < (capacity + 1) * capacity; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(1, s.height());
+
+    s.add((capacity + 1) * capacity);
+    EXPECT_EQ(2, s.height());
+
+    for (int i = 0; i <= (capacity + 1) * capacity; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(BTreeSet_Tests, inorderVisitsElementsInAscendingOrder)
+{
+    std::vector<int> elements;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        elements.push_back(i);
+    }
+
+    std::vector<int> shuffled = elements;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{46});
+
+    BTreeSet<int> s;
+
+    for (int element : shuffled)
+    {
+        s.add(element);
+    }
+
+    EXPECT_EQ(elements, elementsOf(s));
+}
+
+
+TEST(BTreeSet_Tests, stringsSharingPrefixesMatchStdSet)
+{
+    // Many of these strings share their first four characters, and some
+    // are prefixes of others, so the in-node searches have to fall back
+    // to comparing whole keys often.
+    BTreeSet<std::string> s;
+    std::set<std::string> expected;
+
+    std::mt19937 random{46};
+    std::uniform_int_distribution<int> lengths{0, 8};
+    std::uniform_int_distribution<int> letters{'A', 'D'};
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string word(lengths(random), ' ');
+
+        for (char& c : word)
+        {
+            c = static_cast<char>(letters(random));
+        }
+
+        if (i % 2 == 0)
+        {
+            s.add(word);
+            expected.insert(word);
+        }
+        else
+        {
+            EXPECT_EQ(expected.count(word) == 1, s.contains(word));
+        }
+    }
+
+    EXPECT_EQ(expected.size(), s.size());
+    EXPECT_EQ(std::vector<std::string>(expected.begin(), expected.end()), elementsOf(s));
+}
+
+
+TEST(BTreeSet_Tests, keysWithoutPrefixesAreStillOrdered)
+{
+    BTreeSet<Point> s;
+
+    for (int x = 9; x >= 0; --x)
+    {
+        for (int y = 0; y < 10; ++y)
+        {
+            s.add(Point{x, y});
+        }
+    }
+
+    EXPECT_EQ(100, s.size());
+    EXPECT_TRUE(s.contains(Point{3, 7}));
+    EXPECT_FALSE(s.contains(Point{3, 10}));
+
+    std::vector<Point> elements = elementsOf(s);
+    EXPECT_TRUE(std::is_sorted(elements.begin(), elements.end()));
+}
+
+
+TEST(BTreeSet_Tests, prefixesPreserveOrder)
+{
+    EXPECT_LT(BTreeKeyPrefix<int>::of(-1), BTreeKeyPrefix<int>::of(0));
+    EXPECT_LT(BTreeKeyPrefix<int>::of(-2000000000), BTreeKeyPrefix<int>::of(-1));
+    EXPECT_LT(BTreeKeyPrefix<int>::of(0), BTreeKeyPrefix<int>::of(2000000000));
+    EXPECT_LE(BTreeKeyPrefix<long long>::of(-1), BTreeKeyPrefix<long long>::of(0));
+    EXPECT_LT(BTreeKeyPrefix<long long>::of(-(1LL << 40)), BTreeKeyPrefix<long long>::of(1LL << 40));
+    EXPECT_LT(BTreeKeyPrefix<unsigned int>::of(1), BTreeKeyPrefix<unsigned int>::of(4000000000u));
+
+    EXPECT_LT(BTreeKeyPrefix<std::string>::of("AB"), BTreeKeyPrefix<std::string>::of("ABC"));
+    EXPECT_EQ(BTreeKeyPrefix<std::string>::of("ABCD"), BTreeKeyPrefix<std::string>::of("ABCDE"));
+    EXPECT_LT(BTreeKeyPrefix<std::string>::of("Z"), BTreeKeyPrefix<std::string>::of("\xe9"));
+    EXPECT_EQ(0, BTreeKeyPrefix<std::string>::of(""));
+}
+
+
+TEST(BTreeSet_Tests, negativeAndLargeIntegersMatchStdSet)
+{
+    BTreeSet<long long> s;
+    std::set<long long> expected;
+
+    std::mt19937_64 random{46};
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        long long element = static_cast<long long>(random());
+        s.add(element);
+        expected.insert(element);
+    }
+
+    EXPECT_EQ(std::vector<long long>(expected.begin(), expected.end()), elementsOf(s));
+
+    for (long long element : expected)
+    {
+        EXPECT_TRUE(s.contains(element));
+        EXPECT_EQ(expected.count(element + 1) == 1, s.contains(element + 1));
+    }
+}
+
+
+TEST(BTreeSet_Tests, copiesAreIndependent)
+{
+    BTreeSet<std::string> s1;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s1.add(std::to_string(i));
+    }
+
+    BTreeSet<std::string> s2{s1};
+    s2.add("NEW");
+
+    EXPECT_EQ(1000, s1.size());
+    EXPECT_EQ(1001, s2.size());
+    EXPECT_FALSE(s1.contains("NEW"));
+    EXPECT_TRUE(s2.contains("NEW"));
+    EXPECT_EQ(s1.height(), s2.height());
+
+    s1 = s2;
+    EXPECT_EQ(elementsOf(s2), elementsOf(s1));
+}
+
+
+TEST(BTreeSet_Tests, movedAndAssignedSetsKeepWorking)
+{
+    BTreeSet<int> s1;
+    BTreeSet<int> s2;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s2.add(i);
+    }
+
+    s1 = std::move(s2);
+    EXPECT_EQ(100, s1.size());
+    s1.add(100);
+    EXPECT_TRUE(s1.contains(100));
+
+    BTreeSet<int> s3{std::move(s1)};
+    EXPECT_EQ(101, s3.size());
+    EXPECT_EQ(101, elementsOf(s3).size());
+}
@@ -0,0 +1,168 @@
+// ConcurrentHashSet_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for ConcurrentHashSet, including a couple that hammer one
+// set from several threads at once.
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentHashSet.hpp"
+#include "StringHashing.hpp"
+
+
+namespace
+{
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+}
+
+
+TEST(ConcurrentHashSet_Tests, inheritFromSet)
+{
+    ConcurrentHashSet<std::string> s{hashStringAsProduct};
+    Set<std::string>& ss = s;
+    EXPECT_EQ(0, ss.size());
+    EXPECT_TRUE(ss.isImplemented());
+}
+
+
+TEST(ConcurrentHashSet_Tests, shardCountIsRoundedUpToPowerOfTwo)
+{
+    ConcurrentHashSet<int> s1{identityHash, 1};
+    ConcurrentHashSet<int> s2{identityHash, 5};
+    ConcurrentHashSet<int> s3{identityHash};
+
+    EXPECT_EQ(1, s1.shardCount());
+    EXPECT_EQ(8, s2.shardCount());
+    EXPECT_EQ(ConcurrentHashSet<int>::DEFAULT_SHARD_COUNT, s3.shardCount());
+}
+
+
+TEST(ConcurrentHashSet_Tests, containsOnlyElementsAdded)
+{
+    ConcurrentHashSet<int> s{identityHash, 4};
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        s.add(i);
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, s.contains(i));
+    }
+
+    EXPECT_EQ(500, s.size());
+}
+
+
+TEST(ConcurrentHashSet_Tests, addingDuplicatesHasNoEffect)
+{
+    ConcurrentHashSet<std::string> s{hashStringAsSum};
+    s.add("HELLO");
+    s.add("HELLO");
+    s.add("THERE");
+
+    EXPECT_EQ(2, s.size());
+}
+
+
+TEST(ConcurrentHashSet_Tests, shardSizesAddUpToSize)
+{
+    ConcurrentHashSet<int> s{identityHash, 8};
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        s.add(i);
+    }
+
+    unsigned int total = 0;
+
+    for (unsigned int shard = 0; shard < s.shardCount(); ++shard)
+    {
+        EXPECT_LT(0, s.elementsInShard(shard));
+        total += s.elementsInShard(shard);
+    }
+
+    EXPECT_EQ(5000, total);
+    EXPECT_EQ(0, s.elementsInShard(s.shardCount()));
+}
+
+
+TEST(ConcurrentHashSet_Tests, concurrentAddsAreAllKept)
+{
+    constexpr int threadCount = 8;
+    constexpr int perThread = 2000;
+
+    ConcurrentHashSet<int> s{identityHash, 4};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&s, t]()
+            {
+                // Half of each thread's elements overlap with the next
+                // thread's, so duplicates race with one another, too.
+                for (int i = 0; i < perThread; ++i)
+                {
+                    s.add(t * perThread / 2 + i);
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    int expectedSize = (threadCount + 1) * perThread / 2;
+    EXPECT_EQ(expectedSize, s.size());
+
+    for (int i = 0; i < expectedSize; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(ConcurrentHashSet_Tests, readersSeeEverythingAddedBeforeThemWhileWritersRun)
+{
+    ConcurrentHashSet<int> s{identityHash, 4};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i);
+    }
+
+    std::thread writer{
+        [&s]()
+        {
+            for (int i = 1000; i < 20000; ++i)
+            {
+                s.add(i);
+            }
+        }};
+
+    bool allFound = true;
+
+    for (int pass = 0; pass < 20; ++pass)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            allFound = allFound && s.contains(i);
+        }
+    }
+
+    writer.join();
+
+    EXPECT_TRUE(allFound);
+    EXPECT_EQ(20000, s.size());
+}
+
@@ -0,0 +1,124 @@
+// EditDistance_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the edit distance functions and EditDistancePattern, whose
+// bit-parallel algorithms have to agree with dynamic programming exactly,
+// and for the ranking of WordChecker's suggestions that depends on them.
+
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "EditDistance.hpp"
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::string randomString(std::mt19937& random, unsigned int maxLength, char lastLetter)
+    {
+        std::uniform_int_distribution<unsigned int> lengths{0, maxLength};
+        std::uniform_int_distribution<int> letters{'A', lastLetter};
+
+        std::string s(lengths(random), ' ');
+
+        for (char& c : s)
+        {
+            c = static_cast<char>(letters(random));
+        }
+
+        return s;
+    }
+}
+
+
+TEST(EditDistance_Tests, knownLevenshteinDistances)
+{
+    EXPECT_EQ(0, levenshteinDistance("", ""));
+    EXPECT_EQ(5, levenshteinDistance("", "HELLO"));
+    EXPECT_EQ(5, levenshteinDistance("HELLO", ""));
+    EXPECT_EQ(0, levenshteinDistance("HELLO", "HELLO"));
+    EXPECT_EQ(3, levenshteinDistance("KITTEN", "SITTING"));
+    EXPECT_EQ(2, levenshteinDistance("TEH", "THE"));
+}
+
+
+TEST(EditDistance_Tests, knownDamerauDistances)
+{
+    EXPECT_EQ(0, damerauDistance("", ""));
+    EXPECT_EQ(1, damerauDistance("TEH", "THE"));
+    EXPECT_EQ(3, damerauDistance("KITTEN", "SITTING"));
+
+    // Once two characters have been swapped, neither can be edited again,
+    // so this takes three edits rather than two.
+    EXPECT_EQ(3, damerauDistance("CA", "ABC"));
+}
+
+
+TEST(EditDistance_Tests, patternsAgreeWithDynamicProgramming)
+{
+    std::mt19937 random{46};
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        // Small alphabets produce many matches, swaps, and ties.
+        char lastLetter = static_cast<char>('A' + i % 4);
+        std::string a = randomString(random, 12, lastLetter);
+        std::string b = randomString(random, 12, lastLetter);
+
+        EditDistancePattern pattern{a};
+        ASSERT_EQ(levenshteinDistance(a, b), pattern.levenshteinDistanceTo(b)) << a << " " << b;
+        ASSERT_EQ(damerauDistance(a, b), pattern.damerauDistanceTo(b)) << a << " " << b;
+    }
+}
+
+
+TEST(EditDistance_Tests, patternsOfEveryLengthAgreeWithDynamicProgramming)
+{
+    // Patterns up to 64 characters fill the bit vectors; longer ones fall
+    // back to dynamic programming.
+    std::mt19937 random{47};
+
+    for (unsigned int length = 60; length <= 70; ++length)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            std::string a = randomString(random, 0, 'C');
+
+            while (a.length() < length)
+            {
+                a += randomString(random, 1, 'C');
+            }
+
+            std::string b = randomString(random, 75, 'C');
+            EditDistancePattern pattern{a};
+
+            ASSERT_EQ(levenshteinDistance(a, b), pattern.levenshteinDistanceTo(b));
+            ASSERT_EQ(damerauDistance(a, b), pattern.damerauDistanceTo(b));
+        }
+    }
+}
+
+
+TEST(EditDistance_Tests, wordCheckerRanksClosestSuggestionsFirst)
+{
+    HashSet<std::string> set{hashStringAsProduct};
+
+    for (const char* word : {"THE", "TEN", "TEE", "TE"})
+    {
+        set.add(word);
+    }
+
+    WordChecker checker{set};
+
+    // Every suggestion is one edit away, but "THE" takes a swap -- two
+    // edits, as far as the Levenshtein distance is concerned -- so it
+    // comes after the others, which are in alphabetical order.
+    EXPECT_EQ(
+        (std::vector<std::string>{"TE", "TEE", "TEN", "THE"}),
+        checker.findSuggestions("TEH"));
+}
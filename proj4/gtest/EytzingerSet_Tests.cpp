@@ -0,0 +1,167 @@
+// EytzingerSet_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for EytzingerSet.  Since its search recovers its answer from
+// the bits of the index where it ran off the bottom of the tree, sets of
+// every size near a power of two are worth trying.
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "EytzingerSet.hpp"
+
+
+namespace
+{
+    std::vector<std::string> makeWords(unsigned int count)
+    {
+        std::vector<std::string> words;
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            words.push_back("WORD" + std::to_string(i * 7919));
+        }
+
+        return words;
+    }
+
+
+    std::string randomWord(std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> lengths{0, 10};
+        std::uniform_int_distribution<int> letters{'A', 'C'};
+
+        std::string word(lengths(random), ' ');
+
+        for (char& c : word)
+        {
+            c = static_cast<char>(letters(random));
+        }
+
+        return word;
+    }
+}
+
+
+TEST(EytzingerSet_Tests, inheritFromSet)
+{
+    EytzingerSet s{std::vector<std::string>{}};
+    Set<std::string>& ss = s;
+    EXPECT_EQ(0, ss.size());
+    EXPECT_TRUE(ss.isImplemented());
+}
+
+
+TEST(EytzingerSet_Tests, emptySetContainsNothing)
+{
+    EytzingerSet s{std::vector<std::string>{}};
+    EXPECT_FALSE(s.contains(""));
+    EXPECT_FALSE(s.contains("HELLO"));
+}
+
+
+TEST(EytzingerSet_Tests, containsExactlyTheWordsItWasBuiltFrom)
+{
+    EytzingerSet s{std::vector<std::string>{"HELLO", "THERE", "BOO", "BO", "B"}};
+
+    EXPECT_EQ(5, s.size());
+    EXPECT_TRUE(s.contains("HELLO"));
+    EXPECT_TRUE(s.contains("THERE"));
+    EXPECT_TRUE(s.contains("BOO"));
+    EXPECT_TRUE(s.contains("BO"));
+    EXPECT_TRUE(s.contains("B"));
+
+    EXPECT_FALSE(s.contains("BOOO"));
+    EXPECT_FALSE(s.contains("HELL"));
+    EXPECT_FALSE(s.contains("A"));
+    EXPECT_FALSE(s.contains("ZZZ"));
+    EXPECT_FALSE(s.contains(""));
+}
+
+
+TEST(EytzingerSet_Tests, wordsSharingTheirFirstEightCharactersAreDistinguished)
+{
+    EytzingerSet s{std::vector<std::string>{
+        "INTERNATIONAL", "INTERNATIONALLY", "INTERNAL", "INTERNALLY", "INTERNALS"}};
+
+    EXPECT_TRUE(s.contains("INTERNATIONAL"));
+    EXPECT_TRUE(s.contains("INTERNATIONALLY"));
+    EXPECT_TRUE(s.contains("INTERNAL"));
+    EXPECT_TRUE(s.contains("INTERNALLY"));
+    EXPECT_TRUE(s.contains("INTERNALS"));
+
+    EXPECT_FALSE(s.contains("INTERNA"));
+    EXPECT_FALSE(s.contains("INTERNALL"));
+    EXPECT_FALSE(s.contains("INTERNATIONALS"));
+    EXPECT_FALSE(s.contains("INTERNALZ"));
+}
+
+
+TEST(EytzingerSet_Tests, duplicatesAreIgnored)
+{
+    EytzingerSet s{std::vector<std::string>{"A", "B", "A", "C", "B"}};
+    EXPECT_EQ(3, s.size());
+}
+
+
+TEST(EytzingerSet_Tests, everySizeNearAPowerOfTwoFindsOnlyItsWords)
+{
+    for (unsigned int count = 1; count <= 70; ++count)
+    {
+        std::vector<std::string> words = makeWords(count);
+        std::set<std::string> expected{words.begin(), words.end()};
+        EytzingerSet s{words};
+
+        for (const std::string& word : words)
+        {
+            std::string shorter = word.substr(0, word.length() - 1);
+
+            EXPECT_TRUE(s.contains(word));
+            EXPECT_FALSE(s.contains(word + "X"));
+            EXPECT_EQ(expected.count(shorter) == 1, s.contains(shorter));
+        }
+    }
+}
+
+
+TEST(EytzingerSet_Tests, randomWordsMatchStdSet)
+{
+    std::mt19937 random{46};
+    std::vector<std::string> words;
+    std::set<std::string> expected;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        std::string word = randomWord(random);
+        words.push_back(word);
+        expected.insert(word);
+    }
+
+    EytzingerSet s{words};
+    EXPECT_EQ(expected.size(), s.size());
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string word = randomWord(random);
+        EXPECT_EQ(expected.count(word) == 1, s.contains(word));
+    }
+}
+
+
+TEST(EytzingerSet_Tests, addingExistingElementHasNoEffect)
+{
+    EytzingerSet s{std::vector<std::string>{"HELLO"}};
+    s.add("HELLO");
+    EXPECT_EQ(1, s.size());
+}
+
+
+TEST(EytzingerSet_Tests, addingNewElementThrows)
+{
+    EytzingerSet s{std::vector<std::string>{"HELLO"}};
+    EXPECT_THROW(s.add("GOODBYE"), EytzingerSet::FrozenException);
+}
@@ -0,0 +1,178 @@
+// FrozenHashSet_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for FrozenHashSet.
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "FrozenHashSet.hpp"
+
+
+namespace
+{
+    std::vector<std::string> makeWords(unsigned int count)
+    {
+        std::vector<std::string> words;
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            words.push_back("WORD" + std::to_string(i * 7919));
+        }
+
+        return words;
+    }
+}
+
+
+TEST(FrozenHashSet_Tests, inheritFromSet)
+{
+    FrozenHashSet s{std::vector<std::string>{}};
+    Set<std::string>& ss = s;
+    EXPECT_EQ(0, ss.size());
+    EXPECT_TRUE(ss.isImplemented());
+}
+
+
+TEST(FrozenHashSet_Tests, emptySetContainsNothing)
+{
+    FrozenHashSet s{std::vector<std::string>{}};
+    EXPECT_FALSE(s.contains(""));
+    EXPECT_FALSE(s.contains("HELLO"));
+}
+
+
+TEST(FrozenHashSet_Tests, containsExactlyTheWordsItWasBuiltFrom)
+{
+    FrozenHashSet s{std::vector<std::string>{"HELLO", "THERE", "BOO", "BO", "B"}};
+
+    EXPECT_EQ(5, s.size());
+    EXPECT_TRUE(s.contains("HELLO"));
+    EXPECT_TRUE(s.contains("THERE"));
+    EXPECT_TRUE(s.contains("BOO"));
+    EXPECT_TRUE(s.contains("BO"));
+    EXPECT_TRUE(s.contains("B"));
+
+    EXPECT_FALSE(s.contains("BOOO"));
+    EXPECT_FALSE(s.contains("HELL"));
+    EXPECT_FALSE(s.contains(""));
+}
+
+
+TEST(FrozenHashSet_Tests, duplicatesAreIgnored)
+{
+    FrozenHashSet s{std::vector<std::string>{"A", "B", "A", "C", "B"}};
+    EXPECT_EQ(3, s.size());
+}
+
+
+TEST(FrozenHashSet_Tests, hashIsMinimalAndPerfect)
+{
+    std::vector<std::string> words = makeWords(20000);
+    FrozenHashSet s{words};
+
+    std::vector<bool> used(words.size(), false);
+
+    for (const std::string& word : words)
+    {
+        unsigned int index = s.indexOf(word);
+        ASSERT_LT(index, words.size());
+        ASSERT_FALSE(used[index]);
+        used[index] = true;
+    }
+
+    EXPECT_TRUE(std::all_of(used.begin(), used.end(), [](bool b) { return b; }));
+    EXPECT_LT(s.bucketCount(), words.size());
+}
+
+
+TEST(FrozenHashSet_Tests, largeSetContainsOnlyItsWords)
+{
+    std::vector<std::string> words = makeWords(20000);
+    FrozenHashSet s{words};
+
+    for (const std::string& word : words)
+    {
+        EXPECT_TRUE(s.contains(word));
+        EXPECT_FALSE(s.contains(word + "X"));
+    }
+}
+
+
+TEST(FrozenHashSet_Tests, addingExistingElementHasNoEffect)
+{
+    FrozenHashSet s{std::vector<std::string>{"HELLO"}};
+    s.add("HELLO");
+    EXPECT_EQ(1, s.size());
+}
+
+
+TEST(FrozenHashSet_Tests, addingNewElementThrows)
+{
+    FrozenHashSet s{std::vector<std::string>{"HELLO"}};
+    EXPECT_THROW(s.add("GOODBYE"), FrozenHashSet::FrozenException);
+}
+
+
+
+TEST(FrozenHashSet_Tests, mappedSetMatchesSavedSet)
+{
+    std::vector<std::string> words = makeWords(5000);
+    std::string filePath = testing::TempDir() + "FrozenHashSet_Tests.fhs";
+
+    FrozenHashSet{words}.save(filePath);
+    FrozenHashSet mapped = FrozenHashSet::map(filePath);
+
+    EXPECT_EQ(words.size(), mapped.size());
+
+    for (const std::string& word : words)
+    {
+        EXPECT_TRUE(mapped.contains(word));
+        EXPECT_FALSE(mapped.contains(word + "X"));
+    }
+}
+
+
+TEST(FrozenHashSet_Tests, copiesOfMappedSetOutliveTheOriginal)
+{
+    std::string filePath = testing::TempDir() + "FrozenHashSet_Tests.fhs";
+    FrozenHashSet{std::vector<std::string>{"HELLO", "THERE"}}.save(filePath);
+
+    std::unique_ptr<FrozenHashSet> original =
+        std::make_unique<FrozenHashSet>(FrozenHashSet::map(filePath));
+
+    FrozenHashSet copy{*original};
+    original.reset();
+
+    EXPECT_TRUE(copy.contains("HELLO"));
+    EXPECT_TRUE(copy.contains("THERE"));
+    EXPECT_FALSE(copy.contains("BOO"));
+}
+
+
+TEST(FrozenHashSet_Tests, movedSetStillFindsShortWords)
+{
+    // Short arenas live inside the std::string itself, so moving the set
+    // has to re-point its views at the new object's storage.
+    FrozenHashSet original{std::vector<std::string>{"A", "B"}};
+    FrozenHashSet moved{std::move(original)};
+
+    EXPECT_TRUE(moved.contains("A"));
+    EXPECT_TRUE(moved.contains("B"));
+}
+
+
+TEST(FrozenHashSet_Tests, mappingSomethingElseThrows)
+{
+    std::string filePath = testing::TempDir() + "FrozenHashSet_Tests.txt";
+    std::ofstream{filePath} << "HELLO\nTHERE\n";
+
+    EXPECT_THROW(FrozenHashSet::map(filePath), FrozenHashSet::FileFormatException);
+    EXPECT_THROW(
+        FrozenHashSet::map(filePath + ".missing"), MappedFile::OpenException);
+}
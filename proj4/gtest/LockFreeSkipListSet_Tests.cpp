@@ -0,0 +1,302 @@
+// LockFreeSkipListSet_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for LockFreeSkipListSet, including several that have many
+// threads adding, removing, and looking up elements in one set at once.
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "LockFreeSkipListSet.hpp"
+
+
+namespace
+{
+    class NeverGrowLevelTester : public SkipListLevelTester<int>
+    {
+    public:
+        bool shouldOccupyNextLevel(const int&) override
+        {
+            return false;
+        }
+
+        std::unique_ptr<SkipListLevelTester<int>> clone() override
+        {
+            return std::make_unique<NeverGrowLevelTester>();
+        }
+    };
+
+
+    class AlwaysGrowLevelTester : public SkipListLevelTester<int>
+    {
+    public:
+        bool shouldOccupyNextLevel(const int&) override
+        {
+            return true;
+        }
+
+        std::unique_ptr<SkipListLevelTester<int>> clone() override
+        {
+            return std::make_unique<AlwaysGrowLevelTester>();
+        }
+    };
+
+
+    template <typename Function>
+    void runThreads(unsigned int threadCount, Function function)
+    {
+        std::vector<std::thread> threads;
+
+        for (unsigned int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back(function, t);
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+
+    std::vector<int> elementsOf(const LockFreeSkipListSet<int>& s)
+    {
+        std::vector<int> elements;
+        s.forEach([&](const int& element) { elements.push_back(element); });
+        return elements;
+    }
+}
+
+
+TEST(LockFreeSkipListSet_Tests, inheritFromSet)
+{
+    LockFreeSkipListSet<std::string> s;
+    Set<std::string>& ss = s;
+    EXPECT_EQ(0, ss.size());
+    EXPECT_TRUE(ss.isImplemented());
+}
+
+
+TEST(LockFreeSkipListSet_Tests, containsOnlyElementsAdded)
+{
+    LockFreeSkipListSet<int> s;
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        s.add(i);
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, s.contains(i));
+    }
+
+    EXPECT_EQ(500, s.size());
+}
+
+
+TEST(LockFreeSkipListSet_Tests, addingDuplicatesHasNoEffect)
+{
+    LockFreeSkipListSet<std::string> s;
+    s.add("HELLO");
+    s.add("HELLO");
+    s.add("THERE");
+
+    EXPECT_EQ(2, s.size());
+}
+
+
+TEST(LockFreeSkipListSet_Tests, levelCountFollowsTheLevelTester)
+{
+    LockFreeSkipListSet<int> s1{std::make_unique<NeverGrowLevelTester>()};
+    LockFreeSkipListSet<int> s2{std::make_unique<AlwaysGrowLevelTester>()};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s1.add(i);
+        s2.add(i);
+    }
+
+    EXPECT_EQ(1, s1.levelCount());
+    EXPECT_EQ(LockFreeSkipListSet<int>::MAX_LEVEL_COUNT, s2.levelCount());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(s1.contains(i));
+        EXPECT_TRUE(s2.contains(i));
+    }
+}
+
+
+TEST(LockFreeSkipListSet_Tests, removeReportsWhetherElementWasPresent)
+{
+    LockFreeSkipListSet<std::string> s;
+    s.add("BOO");
+    s.add("HOO");
+
+    EXPECT_TRUE(s.remove("BOO"));
+    EXPECT_FALSE(s.remove("BOO"));
+    EXPECT_FALSE(s.remove("NEVER"));
+
+    EXPECT_FALSE(s.contains("BOO"));
+    EXPECT_TRUE(s.contains("HOO"));
+    EXPECT_EQ(1, s.size());
+
+    s.add("BOO");
+    EXPECT_TRUE(s.contains("BOO"));
+}
+
+
+TEST(LockFreeSkipListSet_Tests, forEachVisitsElementsInAscendingOrder)
+{
+    LockFreeSkipListSet<int> s;
+
+    for (int i : {5, 3, 9, 1, 7, 3, 8})
+    {
+        s.add(i);
+    }
+
+    s.remove(7);
+
+    std::vector<int> expected{1, 3, 5, 8, 9};
+    EXPECT_EQ(expected, elementsOf(s));
+}
+
+
+TEST(LockFreeSkipListSet_Tests, concurrentAddsAreAllKept)
+{
+    constexpr int threadCount = 8;
+    constexpr int perThread = 5000;
+
+    LockFreeSkipListSet<int> s;
+
+    runThreads(
+        threadCount,
+        [&s](unsigned int t)
+        {
+            // Half of each thread's elements overlap with the next
+            // thread's, so duplicates race with one another, too.
+            for (int i = 0; i < perThread; ++i)
+            {
+                s.add(t * perThread / 2 + i);
+            }
+        });
+
+    int expectedSize = (threadCount + 1) * perThread / 2;
+    EXPECT_EQ(expectedSize, s.size());
+
+    std::vector<int> elements = elementsOf(s);
+    ASSERT_EQ(expectedSize, elements.size());
+
+    for (int i = 0; i < expectedSize; ++i)
+    {
+        EXPECT_EQ(i, elements[i]);
+    }
+}
+
+
+TEST(LockFreeSkipListSet_Tests, eachElementIsRemovedByExactlyOneThread)
+{
+    constexpr int elementCount = 20000;
+
+    LockFreeSkipListSet<int> s;
+
+    for (int i = 0; i < elementCount; ++i)
+    {
+        s.add(i);
+    }
+
+    std::atomic<int> removals{0};
+
+    runThreads(
+        8,
+        [&](unsigned int)
+        {
+            for (int i = 0; i < elementCount; ++i)
+            {
+                if (s.remove(i))
+                {
+                    ++removals;
+                }
+            }
+        });
+
+    EXPECT_EQ(elementCount, removals.load());
+    EXPECT_EQ(0, s.size());
+    EXPECT_TRUE(elementsOf(s).empty());
+}
+
+
+TEST(LockFreeSkipListSet_Tests, readersAlwaysSeeStableElementsWhileOthersChurn)
+{
+    // Even elements are added up front and never removed; odd elements are
+    // added and removed over and over by the writers.  Readers must always
+    // find every even element, and forEach() must always be in order.
+    constexpr int elementCount = 2000;
+
+    LockFreeSkipListSet<int> s;
+
+    for (int i = 0; i < elementCount; i += 2)
+    {
+        s.add(i);
+    }
+
+    std::atomic<bool> failed{false};
+
+    runThreads(
+        8,
+        [&](unsigned int t)
+        {
+            if (t % 2 == 0)
+            {
+                for (int round = 0; round < 20; ++round)
+                {
+                    for (int i = 1; i < elementCount; i += 2)
+                    {
+                        s.add(i);
+                    }
+
+                    for (int i = 1; i < elementCount; i += 2)
+                    {
+                        s.remove(i);
+                    }
+                }
+            }
+            else
+            {
+                for (int round = 0; round < 20; ++round)
+                {
+                    for (int i = 0; i < elementCount; i += 2)
+                    {
+                        if (!s.contains(i))
+                        {
+                            failed = true;
+                        }
+                    }
+
+                    std::vector<int> elements = elementsOf(s);
+
+                    for (unsigned int i = 1; i < elements.size(); ++i)
+                    {
+                        if (elements[i - 1] >= elements[i])
+                        {
+                            failed = true;
+                        }
+                    }
+                }
+            }
+        });
+
+    EXPECT_FALSE(failed.load());
+    EXPECT_EQ(elementCount / 2, s.size());
+
+    for (int i = 1; i < elementCount; i += 2)
+    {
+        EXPECT_FALSE(s.contains(i));
+    }
+}
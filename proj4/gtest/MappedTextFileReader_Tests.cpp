@@ -0,0 +1,131 @@
+// MappedTextFileReader_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for MappedTextFileReader, which has to split a file into
+// exactly the same words and lines that TextFileReader does.
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "MappedFile.hpp"
+#include "MappedTextFileReader.hpp"
+#include "TextFileReader.hpp"
+
+
+namespace
+{
+    std::string writeTextFile(const std::string& contents)
+    {
+        std::string filePath = testing::TempDir() + "MappedTextFileReader_Tests.txt";
+        std::ofstream{filePath, std::ios::binary} << contents;
+        return filePath;
+    }
+
+
+    template <typename Reader>
+    std::vector<std::pair<std::string, std::string>> readWordsAndLines(const std::string& filePath)
+    {
+        std::vector<std::pair<std::string, std::string>> wordsAndLines;
+        Reader reader{filePath};
+
+        while (!reader.noMoreWords())
+        {
+            wordsAndLines.emplace_back(reader.currentWord(), reader.currentLine());
+            reader.advanceToNextWord();
+        }
+
+        wordsAndLines.emplace_back(reader.currentWord(), reader.currentLine());
+        return wordsAndLines;
+    }
+
+
+    void expectSameAsTextFileReader(const std::string& contents)
+    {
+        std::string filePath = writeTextFile(contents);
+
+        EXPECT_EQ(
+            readWordsAndLines<TextFileReader>(filePath),
+            readWordsAndLines<MappedTextFileReader>(filePath))
+            << "contents: " << contents;
+    }
+}
+
+
+TEST(MappedTextFileReader_Tests, readsWordsUppercasedAlongWithTheirLines)
+{
+    MappedTextFileReader reader{writeTextFile("Hello there,\nBoo!\n")};
+
+    ASSERT_FALSE(reader.noMoreWords());
+    EXPECT_EQ("HELLO", reader.currentWord());
+    EXPECT_EQ("Hello there,", reader.currentLine());
+
+    reader.advanceToNextWord();
+    ASSERT_FALSE(reader.noMoreWords());
+    EXPECT_EQ("THERE", reader.currentWord());
+    EXPECT_EQ("Hello there,", reader.currentLine());
+
+    reader.advanceToNextWord();
+    ASSERT_FALSE(reader.noMoreWords());
+    EXPECT_EQ("BOO", reader.currentWord());
+    EXPECT_EQ("Boo!", reader.currentLine());
+
+    reader.advanceToNextWord();
+    EXPECT_TRUE(reader.noMoreWords());
+    EXPECT_EQ("", reader.currentWord());
+    EXPECT_EQ("", reader.currentLine());
+}
+
+
+TEST(MappedTextFileReader_Tests, emptyFilesHaveNoWords)
+{
+    MappedTextFileReader reader{writeTextFile("")};
+    EXPECT_TRUE(reader.noMoreWords());
+    EXPECT_EQ("", reader.currentWord());
+    EXPECT_EQ("", reader.currentLine());
+}
+
+
+TEST(MappedTextFileReader_Tests, trimsTheSameTrailingCharactersAsTextFileReader)
+{
+    // Only one trailing hyphen or apostrophe is trimmed, and leading
+    // ones are skipped along with everything else that isn't a letter
+    // or digit.
+    expectSameAsTextFileReader("don't dogs' well-known x-- --y 'quoted' a'-b 4ever\n");
+}
+
+
+TEST(MappedTextFileReader_Tests, splitsLinesTheSameAsTextFileReader)
+{
+    expectSameAsTextFileReader("no final newline");
+    expectSameAsTextFileReader("one\n\n\ntwo\n\n");
+    expectSameAsTextFileReader("carriage\r\nreturns\r\n");
+    expectSameAsTextFileReader("\n\n\n");
+    expectSameAsTextFileReader("   ...   \n!!!");
+    expectSameAsTextFileReader("tabs\tand\vother\fspace");
+}
+
+
+TEST(MappedTextFileReader_Tests, readsTheSameAsTextFileReaderOnLargerInputs)
+{
+    std::string contents;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        contents += "Line " + std::to_string(i) + ": the quick-brown fox's "
+            + std::string(i % 7, '-') + "jumped" + std::string(i % 3, '\'') + " over\n";
+    }
+
+    expectSameAsTextFileReader(contents);
+}
+
+
+TEST(MappedTextFileReader_Tests, missingFilesThrow)
+{
+    EXPECT_THROW(
+        MappedTextFileReader{testing::TempDir() + "MappedTextFileReader_Tests.missing"},
+        MappedFile::OpenException);
+}
@@ -0,0 +1,77 @@
+// PerformanceCounters_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for PerformanceCounters.  Whether there are any counters to
+// count with depends on the machine (and the kernel's settings), so the
+// tests check that the counts are sensible when there are, and that their
+// absence is explained when there aren't.
+
+#include <gtest/gtest.h>
+#include "PerformanceCounters.hpp"
+
+
+namespace
+{
+    volatile unsigned long sink;
+
+
+    void doSomeWork()
+    {
+        unsigned long sum = 0;
+
+        for (unsigned long i = 0; i < 1000000; ++i)
+        {
+            sum += i * i;
+            sink = sum;
+        }
+    }
+}
+
+
+TEST(PerformanceCounters_Tests, countsAreMissingBeforeTheFirstStop)
+{
+    PerformanceCounters counters;
+
+    EXPECT_FALSE(counters.lastCounts().cycles.has_value());
+    EXPECT_FALSE(counters.lastCounts().instructions.has_value());
+    EXPECT_FALSE(counters.lastCounts().branchMisses.has_value());
+}
+
+
+TEST(PerformanceCounters_Tests, unavailabilityIsExplained)
+{
+    PerformanceCounters counters;
+    EXPECT_EQ(counters.available(), counters.unavailableReason().empty());
+}
+
+
+TEST(PerformanceCounters_Tests, countsWorkWhenAvailable)
+{
+    PerformanceCounters counters;
+
+    counters.start();
+    doSomeWork();
+    counters.stop();
+
+    if (!counters.available())
+    {
+        EXPECT_FALSE(counters.lastCounts().instructions.has_value());
+        return;
+    }
+
+    if (counters.lastCounts().instructions)
+    {
+        EXPECT_GE(*counters.lastCounts().instructions, 1000000);
+    }
+
+    // Counting again starts over from zero.
+    counters.start();
+    counters.stop();
+
+    if (counters.lastCounts().instructions)
+    {
+        EXPECT_LT(*counters.lastCounts().instructions, 1000000);
+    }
+}
@@ -0,0 +1,258 @@
+// RadixTreeSet_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for RadixTreeSet.  Small alphabets produce long shared
+// prefixes (and so many splits), while large ones push nodes through
+// every size, up to one with a child for every character.
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "RadixTreeSet.hpp"
+
+
+namespace
+{
+    std::vector<std::string> elementsOf(const RadixTreeSet& s, const std::string& prefix = "")
+    {
+        std::vector<std::string> elements;
+        s.forEachWithPrefix(prefix, [&](const std::string& element) { elements.push_back(element); });
+        return elements;
+    }
+
+
+    std::string randomWord(std::mt19937& random, unsigned int alphabetSize)
+    {
+        std::uniform_int_distribution<int> lengths{0, 7};
+        std::uniform_int_distribution<unsigned int> characters{0, alphabetSize - 1};
+
+        std::string word(lengths(random), ' ');
+
+        for (char& c : word)
+        {
+            c = static_cast<char>(characters(random));
+        }
+
+        return word;
+    }
+}
+
+
+TEST(RadixTreeSet_Tests, inheritFromSet)
+{
+    RadixTreeSet s;
+    Set<std::string>& ss = s;
+    EXPECT_EQ(0, ss.size());
+    EXPECT_TRUE(ss.isImplemented());
+}
+
+
+TEST(RadixTreeSet_Tests, emptySetContainsNothing)
+{
+    RadixTreeSet s;
+    EXPECT_FALSE(s.contains(""));
+    EXPECT_FALSE(s.contains("HELLO"));
+    EXPECT_TRUE(elementsOf(s).empty());
+}
+
+
+TEST(RadixTreeSet_Tests, wordsThatArePrefixesOfOthersAreDistinguished)
+{
+    RadixTreeSet s;
+    s.add("BOOK");
+    s.add("BO");
+    s.add("BOOKS");
+    s.add("BOOKKEEPER");
+
+    EXPECT_EQ(4, s.size());
+    EXPECT_TRUE(s.contains("BO"));
+    EXPECT_TRUE(s.contains("BOOK"));
+    EXPECT_TRUE(s.contains("BOOKS"));
+    EXPECT_TRUE(s.contains("BOOKKEEPER"));
+
+    EXPECT_FALSE(s.contains(""));
+    EXPECT_FALSE(s.contains("B"));
+    EXPECT_FALSE(s.contains("BOO"));
+    EXPECT_FALSE(s.contains("BOOKKEEP"));
+    EXPECT_FALSE(s.contains("BOOKKEEPERS"));
+    EXPECT_FALSE(s.contains("BOAT"));
+}
+
+
+TEST(RadixTreeSet_Tests, emptyStringCanBeAnElement)
+{
+    RadixTreeSet s;
+    s.add("HELLO");
+    EXPECT_FALSE(s.contains(""));
+
+    s.add("");
+    EXPECT_TRUE(s.contains(""));
+    EXPECT_TRUE(s.contains("HELLO"));
+    EXPECT_EQ(2, s.size());
+}
+
+
+TEST(RadixTreeSet_Tests, addingDuplicatesHasNoEffect)
+{
+    RadixTreeSet s;
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            s.add(std::to_string(i));
+        }
+    }
+
+    EXPECT_EQ(100, s.size());
+    EXPECT_EQ(100, elementsOf(s).size());
+}
+
+
+TEST(RadixTreeSet_Tests, forEachWithPrefixVisitsMatchingWordsInOrder)
+{
+    RadixTreeSet s;
+
+    for (const char* word : {"CART", "CAR", "CARTON", "CAT", "DOG", "CA", "CARS", "CARD"})
+    {
+        s.add(word);
+    }
+
+    EXPECT_EQ(
+        (std::vector<std::string>{"CAR", "CARD", "CARS", "CART", "CARTON"}),
+        elementsOf(s, "CAR"));
+
+    EXPECT_EQ((std::vector<std::string>{"CART", "CARTON"}), elementsOf(s, "CART"));
+    EXPECT_EQ((std::vector<std::string>{"CARTON"}), elementsOf(s, "CARTO"));
+    EXPECT_EQ((std::vector<std::string>{"DOG"}), elementsOf(s, "D"));
+
+    EXPECT_TRUE(elementsOf(s, "CARTONS").empty());
+    EXPECT_TRUE(elementsOf(s, "CB").empty());
+    EXPECT_TRUE(elementsOf(s, "E").empty());
+
+    EXPECT_EQ(
+        (std::vector<std::string>{"CA", "CAR", "CARD", "CARS", "CART", "CARTON", "CAT", "DOG"}),
+        elementsOf(s));
+}
+
+
+TEST(RadixTreeSet_Tests, everyNodeSizeMatchesStdSet)
+{
+    for (unsigned int alphabetSize : {2u, 5u, 20u, 60u, 256u})
+    {
+        std::mt19937 random{alphabetSize};
+        RadixTreeSet s;
+        std::set<std::string> expected;
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            std::string word = randomWord(random, alphabetSize);
+            s.add(word);
+            expected.insert(word);
+        }
+
+        EXPECT_EQ(expected.size(), s.size());
+        EXPECT_EQ(std::vector<std::string>(expected.begin(), expected.end()), elementsOf(s));
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            std::string word = randomWord(random, alphabetSize);
+            EXPECT_EQ(expected.count(word) == 1, s.contains(word));
+        }
+    }
+}
+
+
+TEST(RadixTreeSet_Tests, prefixQueriesMatchStdSet)
+{
+    std::mt19937 random{46};
+    RadixTreeSet s;
+    std::set<std::string> expected;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        std::string word = randomWord(random, 4);
+        s.add(word);
+        expected.insert(word);
+    }
+
+    for (int i = 0; i < 200; ++i)
+    {
+        std::string prefix = randomWord(random, 4).substr(0, 3);
+        std::vector<std::string> matching;
+
+        for (auto j = expected.lower_bound(prefix);
+             j != expected.end() && j->compare(0, prefix.length(), prefix) == 0; ++j)
+        {
+            matching.push_back(*j);
+        }
+
+        EXPECT_EQ(matching, elementsOf(s, prefix));
+    }
+}
+
+
+TEST(RadixTreeSet_Tests, sharedPrefixesUseLessMemoryThanTheWords)
+{
+    // A thousand words that differ only in their last four characters
+    // share one path through the tree, so their long common prefix is
+    // only stored once.
+    RadixTreeSet s;
+    std::size_t characters = 0;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string word = std::string(100, 'A') + std::to_string(1000 + i);
+        characters += word.length();
+        s.add(word);
+    }
+
+    EXPECT_LT(s.memoryUsage().nodeBytes, characters);
+}
+
+
+TEST(RadixTreeSet_Tests, copiesAreIndependent)
+{
+    RadixTreeSet s1;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s1.add(std::to_string(i));
+    }
+
+    RadixTreeSet s2{s1};
+    s2.add("NEW");
+
+    EXPECT_EQ(1000, s1.size());
+    EXPECT_EQ(1001, s2.size());
+    EXPECT_FALSE(s1.contains("NEW"));
+    EXPECT_TRUE(s2.contains("NEW"));
+
+    s1 = s2;
+    EXPECT_EQ(elementsOf(s2), elementsOf(s1));
+}
+
+
+TEST(RadixTreeSet_Tests, movedAndAssignedSetsKeepWorking)
+{
+    RadixTreeSet s1;
+    RadixTreeSet s2;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s2.add(std::to_string(i));
+    }
+
+    s1 = std::move(s2);
+    EXPECT_EQ(100, s1.size());
+    s1.add("100");
+    EXPECT_TRUE(s1.contains("100"));
+
+    RadixTreeSet s3{std::move(s1)};
+    EXPECT_EQ(101, s3.size());
+    EXPECT_EQ(101, elementsOf(s3).size());
+}
@@ -0,0 +1,298 @@
+// RobinHoodHashSet_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for RobinHoodHashSet, with particular attention to remove()
+// and to what the table looks like after many removals.
+
+#include <random>
+#include <set>
+#include <string>
+#include <gtest/gtest.h>
+#include "RobinHoodHashSet.hpp"
+#include "StringHashing.hpp"
+
+
+namespace
+{
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+
+
+    unsigned int constantHash(const int&)
+    {
+        return 0;
+    }
+}
+
+
+TEST(RobinHoodHashSet_Tests, inheritFromSet)
+{
+    RobinHoodHashSet<std::string> s{hashStringAsProduct};
+    Set<std::string>& ss = s;
+    EXPECT_EQ(0, ss.size());
+    EXPECT_TRUE(ss.isImplemented());
+}
+
+
+TEST(RobinHoodHashSet_Tests, containsOnlyElementsAdded)
+{
+    RobinHoodHashSet<int> s{identityHash};
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        s.add(i);
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, s.contains(i));
+    }
+
+    EXPECT_EQ(500, s.size());
+}
+
+
+TEST(RobinHoodHashSet_Tests, addingDuplicatesHasNoEffect)
+{
+    RobinHoodHashSet<std::string> s{hashStringAsSum};
+    s.add("HELLO");
+    s.add("HELLO");
+    s.add("THERE");
+
+    EXPECT_EQ(2, s.size());
+}
+
+
+TEST(RobinHoodHashSet_Tests, capacityIsAlwaysAPowerOfTwo)
+{
+    RobinHoodHashSet<int> s{identityHash};
+    EXPECT_EQ(RobinHoodHashSet<int>::DEFAULT_CAPACITY, s.capacity());
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        s.add(i);
+
+        EXPECT_EQ(0, s.capacity() & (s.capacity() - 1));
+        EXPECT_LE(s.size(), s.capacity() * 0.9);
+    }
+}
+
+
+TEST(RobinHoodHashSet_Tests, removeReportsWhetherElementWasPresent)
+{
+    RobinHoodHashSet<std::string> s{hashStringAsProduct};
+    s.add("BOO");
+    s.add("HOO");
+
+    EXPECT_TRUE(s.remove("BOO"));
+    EXPECT_FALSE(s.remove("BOO"));
+    EXPECT_FALSE(s.remove("NEVER"));
+
+    EXPECT_FALSE(s.contains("BOO"));
+    EXPECT_TRUE(s.contains("HOO"));
+    EXPECT_EQ(1, s.size());
+}
+
+
+TEST(RobinHoodHashSet_Tests, removingFromTheMiddleOfAClusterKeepsTheRest)
+{
+    // With every element hashing to the same home, they all sit in one
+    // long cluster, so every removal shifts everything after it.
+    RobinHoodHashSet<int> s{constantHash};
+
+    for (int i = 0; i < 10; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_TRUE(s.remove(3));
+    EXPECT_TRUE(s.remove(0));
+    EXPECT_TRUE(s.remove(9));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(i != 0 && i != 3 && i != 9, s.contains(i));
+    }
+
+    EXPECT_EQ(7, s.size());
+    EXPECT_EQ(7, s.probeStatistics().maxProbeLength);
+}
+
+
+TEST(RobinHoodHashSet_Tests, probeLengthsStayBoundedWithPoorHashing)
+{
+    // Sixteen elements share every hash value, so there are long runs of
+    // collisions, but growing the table still spreads them out.
+    RobinHoodHashSet<int> s{[](const int& i) { return static_cast<unsigned int>(i / 16); }};
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_LE(s.probeStatistics().maxProbeLength, RobinHoodHashSet<int>::MAX_PROBE_LENGTH);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(RobinHoodHashSet_Tests, tableStopsGrowingWhenTheHashFunctionCantBeHelped)
+{
+    // When every element hashes to the same value, no capacity brings
+    // probe lengths down, so the table mustn't keep doubling.
+    RobinHoodHashSet<int> s{constantHash};
+
+    for (int i = 0; i < 500; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_LE(s.capacity(), 2048);
+    EXPECT_EQ(500, s.probeStatistics().maxProbeLength);
+
+    for (int i = 0; i < 500; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(RobinHoodHashSet_Tests, probeStatisticsOfAnEmptySetAreZero)
+{
+    RobinHoodHashSet<int> s{identityHash};
+
+    RobinHoodHashSet<int>::ProbeStatistics statistics = s.probeStatistics();
+    EXPECT_EQ(0, statistics.maxProbeLength);
+    EXPECT_EQ(0.0, statistics.averageProbeLength);
+
+    s.add(1);
+    s.remove(1);
+
+    statistics = s.probeStatistics();
+    EXPECT_EQ(0, statistics.maxProbeLength);
+    EXPECT_EQ(0.0, statistics.averageProbeLength);
+}
+
+
+TEST(RobinHoodHashSet_Tests, mixedAddsAndRemovesMatchStdSet)
+{
+    RobinHoodHashSet<std::string> s{hashStringAsProduct};
+    std::set<std::string> expected;
+
+    std::mt19937 random{46};
+    std::uniform_int_distribution<int> keys{0, 2999};
+    std::uniform_int_distribution<int> operations{0, 2};
+
+    for (int i = 0; i < 50000; ++i)
+    {
+        std::string key = "KEY" + std::to_string(keys(random));
+
+        switch (operations(random))
+        {
+        case 0:
+            s.add(key);
+            expected.insert(key);
+            break;
+
+        case 1:
+            EXPECT_EQ(expected.erase(key) == 1, s.remove(key));
+            break;
+
+        default:
+            EXPECT_EQ(expected.count(key) == 1, s.contains(key));
+            break;
+        }
+    }
+
+    EXPECT_EQ(expected.size(), s.size());
+
+    for (const std::string& key : expected)
+    {
+        EXPECT_TRUE(s.contains(key));
+    }
+}
+
+
+TEST(RobinHoodHashSet_Tests, averageProbeLengthStaysShortAfterManyRemovals)
+{
+    RobinHoodHashSet<int> s{identityHash};
+
+    for (int round = 0; round < 20; ++round)
+    {
+        for (int i = 0; i < 5000; ++i)
+        {
+            s.add(round * 5000 + i);
+        }
+
+        for (int i = 0; i < 5000; i += 2)
+        {
+            s.remove(round * 5000 + i);
+        }
+    }
+
+    // Backward-shift deletion leaves no tombstones behind, so the table
+    // looks just as though the survivors had been inserted on their own.
+    EXPECT_EQ(50000, s.size());
+    EXPECT_LT(s.probeStatistics().averageProbeLength, 3.0);
+}
+
+
+TEST(RobinHoodHashSet_Tests, copiesAndMovesAreIndependent)
+{
+    RobinHoodHashSet<std::string> s1{hashStringAsProduct};
+    s1.add("ALPHA");
+    s1.add("BETA");
+
+    RobinHoodHashSet<std::string> s2{s1};
+    s2.remove("ALPHA");
+    s2.add("GAMMA");
+
+    EXPECT_TRUE(s1.contains("ALPHA"));
+    EXPECT_FALSE(s1.contains("GAMMA"));
+    EXPECT_FALSE(s2.contains("ALPHA"));
+
+    RobinHoodHashSet<std::string> s3{std::move(s2)};
+    EXPECT_TRUE(s3.contains("GAMMA"));
+    EXPECT_EQ(2, s3.size());
+
+    s3 = s1;
+    EXPECT_TRUE(s3.contains("ALPHA"));
+    EXPECT_FALSE(s3.contains("GAMMA"));
+
+    s1 = std::move(s3);
+    EXPECT_EQ(2, s1.size());
+}
+
+
+TEST(RobinHoodHashSet_Tests, movedFromSetsAreEmptyAndUsable)
+{
+    RobinHoodHashSet<std::string> s1{hashStringAsProduct};
+    s1.add("ALPHA");
+
+    RobinHoodHashSet<std::string> s2{std::move(s1)};
+
+    EXPECT_EQ(0, s1.size());
+    EXPECT_FALSE(s1.contains("ALPHA"));
+    EXPECT_FALSE(s1.remove("ALPHA"));
+
+    RobinHoodHashSet<std::string> s3{s1};
+    EXPECT_FALSE(s3.contains("ALPHA"));
+
+    for (const char* element : {"ALPHA", "BETA", "GAMMA"})
+    {
+        s1.add(element);
+        s3.add(element);
+    }
+
+    EXPECT_EQ(3, s1.size());
+    EXPECT_TRUE(s1.contains("BETA"));
+    EXPECT_EQ(3, s3.size());
+    EXPECT_TRUE(s3.contains("GAMMA"));
+}
@@ -0,0 +1,145 @@
+// SetElementView_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for searching sets of strings for std::string_views, both in
+// the sets that compare views with their elements directly (HashSet,
+// AVLSet, SkipListSet, and ListSet) and in one that copies them into
+// strings instead (BTreeSet), along with WordChecker, which passes the
+// views it's given along to its set.  String literals can be searched for
+// directly, too, whether through a Set or one of its derived classes.
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "BTreeSet.hpp"
+#include "HashSet.hpp"
+#include "ListSet.hpp"
+#include "SkipListSet.hpp"
+#include "StringHashing.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::vector<std::unique_ptr<Set<std::string>>> makeSets()
+    {
+        std::vector<std::unique_ptr<Set<std::string>>> sets;
+        sets.push_back(
+            std::make_unique<HashSet<std::string>>(hashStringAsProduct, hashStringAsProduct));
+        sets.push_back(std::make_unique<HashSet<std::string>>(hashStringAsProduct));
+        sets.push_back(std::make_unique<AVLSet<std::string>>());
+        sets.push_back(std::make_unique<SkipListSet<std::string>>());
+        sets.push_back(std::make_unique<ListSet<std::string>>());
+        sets.push_back(std::make_unique<BTreeSet<std::string>>());
+
+        for (auto& set : sets)
+        {
+            for (const char* word : {"BOO", "BOOK", "HOO", "PERFECT"})
+            {
+                set->add(word);
+            }
+        }
+
+        return sets;
+    }
+}
+
+
+TEST(SetElementView_Tests, viewsAreFoundJustAsStringsAre)
+{
+    for (auto& set : makeSets())
+    {
+        for (const char* word : {"BOO", "BOOK", "HOO", "PERFECT", "", "BO", "BOOKS", "ZOO"})
+        {
+            EXPECT_EQ(set->contains(std::string{word}), set->contains(std::string_view{word}))
+                << word;
+        }
+    }
+}
+
+
+TEST(SetElementView_Tests, viewsCanBePartsOfLargerStrings)
+{
+    std::string_view text = "THE BOOKSHELF IS PERFECTLY FULL";
+
+    for (auto& set : makeSets())
+    {
+        EXPECT_TRUE(set->contains(text.substr(4, 3)));
+        EXPECT_TRUE(set->contains(text.substr(4, 4)));
+        EXPECT_FALSE(set->contains(text.substr(4, 5)));
+        EXPECT_TRUE(set->contains(text.substr(17, 7)));
+        EXPECT_FALSE(set->contains(text.substr(17, 9)));
+    }
+}
+
+
+TEST(SetElementView_Tests, copiedSetsSearchViewsTheSameWay)
+{
+    HashSet<std::string> s1{hashStringAsProduct, hashStringAsProduct};
+    s1.add("BOO");
+
+    HashSet<std::string> s2{s1};
+    HashSet<std::string> s3{std::move(s1)};
+
+    EXPECT_TRUE(s2.contains("BOO"));
+    EXPECT_TRUE(s3.contains("BOO"));
+    EXPECT_FALSE(s3.contains("HOO"));
+}
+
+
+TEST(SetElementView_Tests, stringLiteralsAreFoundJustAsStringsAre)
+{
+    for (auto& set : makeSets())
+    {
+        EXPECT_TRUE(set->contains("BOO"));
+        EXPECT_TRUE(set->contains("PERFECT"));
+        EXPECT_FALSE(set->contains("BOOKS"));
+        EXPECT_FALSE(set->contains(""));
+    }
+
+    AVLSet<std::string> avlSet;
+    avlSet.add("BOO");
+    EXPECT_TRUE(avlSet.contains("BOO"));
+
+    BTreeSet<std::string> bTreeSet;
+    bTreeSet.add("BOO");
+    EXPECT_TRUE(bTreeSet.contains("BOO"));
+
+    ListSet<std::string> listSet;
+    listSet.add("BOO");
+    EXPECT_FALSE(listSet.contains("HOO"));
+
+    SkipListSet<std::string> skipListSet;
+    skipListSet.add("BOO");
+    EXPECT_TRUE(skipListSet.contains("BOO"));
+}
+
+
+TEST(SetElementView_Tests, setsOfOtherTypesStillSearchForElements)
+{
+    AVLSet<int> s;
+    s.add(11);
+
+    EXPECT_TRUE(s.contains(11));
+    EXPECT_FALSE(s.contains(12));
+}
+
+
+TEST(SetElementView_Tests, wordCheckerChecksViews)
+{
+    for (auto& set : makeSets())
+    {
+        WordChecker checker{*set};
+        std::string_view text = "BOOKHOO";
+
+        EXPECT_TRUE(checker.wordExists(text.substr(0, 4)));
+        EXPECT_TRUE(checker.wordExists(text.substr(4)));
+        EXPECT_FALSE(checker.wordExists(text));
+        EXPECT_TRUE(checker.wordExists(std::string{"PERFECT"}));
+    }
+}
@@ -0,0 +1,359 @@
+// SetMemoryUsage_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Checks each set's memoryUsage() against a counting allocator: the global
+// operator new and operator delete are replaced (for this whole test
+// program) with versions that keep a running total of the bytes currently
+// allocated, so the memory a set reports can be compared with the memory
+// it actually asked for.
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "BTreeSet.hpp"
+#include "ConcurrentHashSet.hpp"
+#include "EytzingerSet.hpp"
+#include "FrozenHashSet.hpp"
+#include "HashSet.hpp"
+#include "ListSet.hpp"
+#include "RadixTreeSet.hpp"
+#include "RobinHoodHashSet.hpp"
+#include "SkipListSet.hpp"
+#include "StringHashing.hpp"
+
+
+namespace
+{
+    std::atomic<std::size_t> liveBytes{0};
+
+
+    // Every allocation is prefixed with a header recording its size, so
+    // that operator delete knows how many bytes are being given back.
+    constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+
+    void* countedAllocate(std::size_t size, std::size_t alignment)
+    {
+        std::size_t headerSize = alignment > HEADER_SIZE ? alignment : HEADER_SIZE;
+        std::size_t totalSize = (size + headerSize + alignment - 1) / alignment * alignment;
+
+        char* block = static_cast<char*>(std::aligned_alloc(alignment, totalSize));
+
+        if (block == nullptr)
+        {
+            throw std::bad_alloc{};
+        }
+
+        char* memory = block + headerSize;
+        reinterpret_cast<std::size_t*>(memory)[-1] = size;
+        reinterpret_cast<std::size_t*>(memory)[-2] = headerSize;
+
+        liveBytes += size;
+        return memory;
+    }
+
+
+    void countedFree(void* memory) noexcept
+    {
+        if (memory != nullptr)
+        {
+            std::size_t size = static_cast<std::size_t*>(memory)[-1];
+            std::size_t headerSize = static_cast<std::size_t*>(memory)[-2];
+
+            liveBytes -= size;
+            std::free(static_cast<char*>(memory) - headerSize);
+        }
+    }
+}
+
+
+void* operator new(std::size_t size)
+{
+    return countedAllocate(size, HEADER_SIZE);
+}
+
+
+void* operator new[](std::size_t size)
+{
+    return countedAllocate(size, HEADER_SIZE);
+}
+
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+
+void operator delete(void* memory) noexcept
+{
+    countedFree(memory);
+}
+
+
+void operator delete[](void* memory) noexcept
+{
+    countedFree(memory);
+}
+
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    countedFree(memory);
+}
+
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    countedFree(memory);
+}
+
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    countedFree(memory);
+}
+
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    countedFree(memory);
+}
+
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    countedFree(memory);
+}
+
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    countedFree(memory);
+}
+
+
+
+namespace
+{
+    // A mixture of short words (which fit inside a std::string) and long
+    // ones (which don't), so that keyBytes is exercised, too.
+    std::vector<std::string> makeWords()
+    {
+        std::vector<std::string> words;
+
+        for (unsigned int i = 0; i < 3000; ++i)
+        {
+            std::string word = "W" + std::to_string(i);
+
+            if (i % 3 == 0)
+            {
+                word += "-WITH-A-SUFFIX-LONG-ENOUGH-TO-NEED-THE-HEAP";
+            }
+
+            words.push_back(word);
+        }
+
+        return words;
+    }
+
+
+    template <typename ElementType>
+    class NeverGrowSkipListLevelTester : public SkipListLevelTester<ElementType>
+    {
+    public:
+        bool shouldOccupyNextLevel(const ElementType& element) override
+        {
+            return false;
+        }
+
+        std::unique_ptr<SkipListLevelTester<ElementType>> clone() override
+        {
+            return std::make_unique<NeverGrowSkipListLevelTester<ElementType>>();
+        }
+    };
+
+
+    // Adds the words to the set and returns how many bytes were allocated
+    // (and not yet freed) along the way.
+    std::size_t addAndCount(Set<std::string>& set, const std::vector<std::string>& words)
+    {
+        std::size_t before = liveBytes;
+
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+
+        return liveBytes - before;
+    }
+
+
+    std::size_t allocatedBytes(const SetMemoryUsage& usage)
+    {
+        return usage.totalBytes() - usage.objectBytes;
+    }
+}
+
+
+TEST(SetMemoryUsage_Tests, listSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+    ListSet<std::string> set;
+
+    std::size_t allocated = addAndCount(set, words);
+
+    EXPECT_EQ(allocated, allocatedBytes(set.memoryUsage()));
+    EXPECT_LT(0, set.memoryUsage().keyBytes);
+}
+
+
+TEST(SetMemoryUsage_Tests, hashSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+
+    std::size_t before = liveBytes;
+    HashSet<std::string> set{hashStringAsProduct};
+    std::size_t allocated = liveBytes - before + addAndCount(set, words);
+
+    SetMemoryUsage usage = set.memoryUsage();
+
+    EXPECT_EQ(allocated, allocatedBytes(usage));
+    EXPECT_LT(0, usage.bucketBytes);
+    EXPECT_LT(0, usage.nodeBytes);
+}
+
+
+TEST(SetMemoryUsage_Tests, skipListSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+    std::unique_ptr<SkipListLevelTester<std::string>> levelTester =
+        std::make_unique<NeverGrowSkipListLevelTester<std::string>>();
+
+    std::size_t before = liveBytes;
+    SkipListSet<std::string> set{std::move(levelTester)};
+    std::size_t allocated = liveBytes - before + addAndCount(set, words);
+
+    SetMemoryUsage usage = set.memoryUsage();
+
+    EXPECT_EQ(allocated, allocatedBytes(usage));
+    ASSERT_EQ(1, usage.nodesPerLevel.size());
+    EXPECT_EQ(words.size(), usage.nodesPerLevel[0]);
+}
+
+
+TEST(SetMemoryUsage_Tests, skipListSetCountsNodesOnEveryLevel)
+{
+    SkipListSet<int> set;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        set.add(i);
+    }
+
+    SetMemoryUsage usage = set.memoryUsage();
+    ASSERT_EQ(set.levelCount(), usage.nodesPerLevel.size());
+
+    for (unsigned int level = 0; level < set.levelCount(); ++level)
+    {
+        EXPECT_EQ(set.elementsOnLevel(level), usage.nodesPerLevel[level]);
+    }
+}
+
+
+TEST(SetMemoryUsage_Tests, concurrentHashSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+
+    std::size_t before = liveBytes;
+    ConcurrentHashSet<std::string> set{hashStringAsProduct, 8};
+    std::size_t allocated = liveBytes - before + addAndCount(set, words);
+
+    EXPECT_EQ(allocated, allocatedBytes(set.memoryUsage()));
+}
+
+
+TEST(SetMemoryUsage_Tests, radixTreeSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+    RadixTreeSet set;
+
+    std::size_t allocated = addAndCount(set, words);
+
+    EXPECT_EQ(allocated, allocatedBytes(set.memoryUsage()));
+    EXPECT_EQ(0, set.memoryUsage().keyBytes);
+}
+
+
+TEST(SetMemoryUsage_Tests, robinHoodHashSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+
+    std::size_t before = liveBytes;
+    RobinHoodHashSet<std::string> set{hashStringAsProduct};
+    std::size_t allocated = liveBytes - before + addAndCount(set, words);
+
+    EXPECT_EQ(allocated, allocatedBytes(set.memoryUsage()));
+}
+
+
+TEST(SetMemoryUsage_Tests, avlSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+
+    std::size_t before = liveBytes;
+    AVLSet<std::string> set;
+    std::size_t allocated = liveBytes - before + addAndCount(set, words);
+
+    EXPECT_EQ(allocated, allocatedBytes(set.memoryUsage()));
+}
+
+
+TEST(SetMemoryUsage_Tests, bTreeSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+
+    std::size_t before = liveBytes;
+    BTreeSet<std::string> set;
+    std::size_t allocated = liveBytes - before + addAndCount(set, words);
+
+    EXPECT_EQ(allocated, allocatedBytes(set.memoryUsage()));
+}
+
+
+TEST(SetMemoryUsage_Tests, eytzingerSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+
+    std::size_t before = liveBytes;
+    EytzingerSet set{words};
+    std::size_t allocated = liveBytes - before;
+
+    EXPECT_EQ(allocated, allocatedBytes(set.memoryUsage()));
+}
+
+
+TEST(SetMemoryUsage_Tests, frozenHashSetMatchesAllocations)
+{
+    std::vector<std::string> words = makeWords();
+
+    std::size_t before = liveBytes;
+    FrozenHashSet set{words};
+    std::size_t allocated = liveBytes - before;
+
+    EXPECT_EQ(allocated, allocatedBytes(set.memoryUsage()));
+}
+
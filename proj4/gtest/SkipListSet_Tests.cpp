@@ -0,0 +1,527 @@
+// SkipListSet_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SkipListSet beyond the sanity checks, mostly concerned
+// with the shape of the skip list: which elements end up on which levels,
+// whether copies and moves preserve that shape, and the level testers that
+// decide it.  There are also tests of the ordered searches (lowerBound()
+// and forEachInRange()) and of finger searches in every direction, and
+// that searches from many threads at once don't interfere with each other.
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    // A TrailingZerosLevelTester puts a positive integer i on one level
+    // more than the number of trailing zero bits in i, so 1 is only on
+    // level 0, 2 is on levels 0 and 1, 4 is on levels 0 through 2, and
+    // so on.  That makes the shape of the skip list predictable.
+    class TrailingZerosLevelTester : public SkipListLevelTester<int>
+    {
+    public:
+        bool shouldOccupyNextLevel(const int& element) override
+        {
+            if (element > 0 && ((element >> flips) & 1) == 0)
+            {
+                ++flips;
+                return true;
+            }
+
+            flips = 0;
+            return false;
+        }
+
+        std::unique_ptr<SkipListLevelTester<int>> clone() override
+        {
+            return std::make_unique<TrailingZerosLevelTester>();
+        }
+
+    private:
+        unsigned int flips = 0;
+    };
+
+
+    SkipListSet<int> makeTrailingZerosSet(int count)
+    {
+        SkipListSet<int> s{std::make_unique<TrailingZerosLevelTester>()};
+
+        for (int i = 1; i <= count; ++i)
+        {
+            s.add(i);
+        }
+
+        return s;
+    }
+
+
+    std::vector<int> elementsInRange(const SkipListSet<int>& s, int low, int high)
+    {
+        std::vector<int> elements;
+        s.forEachInRange(low, high, [&](const int& element) { elements.push_back(element); });
+        return elements;
+    }
+}
+
+
+TEST(SkipListSet_Tests, levelsFollowTheLevelTester)
+{
+    SkipListSet<int> s = makeTrailingZerosSet(64);
+
+    EXPECT_EQ(7, s.levelCount());
+
+    for (unsigned int level = 0; level < 7; ++level)
+    {
+        EXPECT_EQ(64u >> level, s.elementsOnLevel(level));
+    }
+
+    EXPECT_EQ(0, s.elementsOnLevel(7));
+
+    EXPECT_TRUE(s.isElementOnLevel(12, 2));
+    EXPECT_FALSE(s.isElementOnLevel(12, 3));
+    EXPECT_TRUE(s.isElementOnLevel(64, 6));
+    EXPECT_FALSE(s.isElementOnLevel(65, 0));
+}
+
+
+TEST(SkipListSet_Tests, addingInAnyOrderGivesTheSameShape)
+{
+    std::vector<int> elements;
+
+    for (int i = 1; i <= 1000; ++i)
+    {
+        elements.push_back(i);
+    }
+
+    std::shuffle(elements.begin(), elements.end(), std::mt19937{46});
+
+    SkipListSet<int> s{std::make_unique<TrailingZerosLevelTester>()};
+
+    for (int element : elements)
+    {
+        s.add(element);
+    }
+
+    SkipListSet<int> sorted = makeTrailingZerosSet(1000);
+
+    ASSERT_EQ(sorted.levelCount(), s.levelCount());
+
+    for (unsigned int level = 0; level < s.levelCount(); ++level)
+    {
+        EXPECT_EQ(sorted.elementsOnLevel(level), s.elementsOnLevel(level));
+    }
+}
+
+
+TEST(SkipListSet_Tests, addingDuplicatesHasNoEffectOnAnyLevel)
+{
+    SkipListSet<int> s = makeTrailingZerosSet(16);
+
+    for (int i = 1; i <= 16; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(16, s.size());
+    EXPECT_EQ(16, s.elementsOnLevel(0));
+    EXPECT_EQ(1, s.elementsOnLevel(4));
+}
+
+
+TEST(SkipListSet_Tests, containsMatchesStdSet)
+{
+    SkipListSet<std::string> s;
+    std::set<std::string> expected;
+
+    std::mt19937 random{46};
+    std::uniform_int_distribution<int> keys{0, 9999};
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        std::string key = std::to_string(keys(random));
+        s.add(key);
+        expected.insert(key);
+    }
+
+    EXPECT_EQ(expected.size(), s.size());
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        std::string key = std::to_string(i);
+        EXPECT_EQ(expected.count(key) == 1, s.contains(key));
+    }
+}
+
+
+TEST(SkipListSet_Tests, copiesHaveTheSameShapeAndAreIndependent)
+{
+    SkipListSet<int> s1 = makeTrailingZerosSet(100);
+    SkipListSet<int> s2{s1};
+
+    ASSERT_EQ(s1.levelCount(), s2.levelCount());
+
+    for (unsigned int level = 0; level < s1.levelCount(); ++level)
+    {
+        EXPECT_EQ(s1.elementsOnLevel(level), s2.elementsOnLevel(level));
+    }
+
+    // The copy gets its own clone of the level tester, so adding to it
+    // still follows the same rule.
+    s2.add(128);
+    EXPECT_TRUE(s2.isElementOnLevel(128, 7));
+    EXPECT_FALSE(s1.contains(128));
+    EXPECT_EQ(7, s1.levelCount());
+    EXPECT_EQ(8, s2.levelCount());
+}
+
+
+TEST(SkipListSet_Tests, movedAndAssignedSetsKeepWorking)
+{
+    SkipListSet<int> s1 = makeTrailingZerosSet(10);
+    SkipListSet<int> s2 = makeTrailingZerosSet(20);
+
+    s1 = std::move(s2);
+    EXPECT_EQ(20, s1.size());
+    s1.add(32);
+    EXPECT_TRUE(s1.isElementOnLevel(32, 5));
+
+    SkipListSet<int> s3 = makeTrailingZerosSet(5);
+    s3 = s1;
+    EXPECT_EQ(21, s3.size());
+    s3.add(64);
+    EXPECT_TRUE(s3.isElementOnLevel(64, 6));
+    EXPECT_FALSE(s1.contains(64));
+}
+
+
+TEST(SkipListSet_Tests, movedFromSetsAreEmptyAndUsable)
+{
+    SkipListSet<int> s1 = makeTrailingZerosSet(10);
+    SkipListSet<int> s2{std::move(s1)};
+
+    EXPECT_EQ(0, s1.size());
+    EXPECT_FALSE(s1.contains(5));
+    EXPECT_FALSE(s1.isElementOnLevel(5, 0));
+    EXPECT_EQ(nullptr, s1.lowerBound(0));
+    EXPECT_TRUE(elementsInRange(s1, 0, 100).empty());
+    EXPECT_EQ(0, s1.memoryUsage().nodeBytes);
+
+    SkipListSet<int> s3{s1};
+    EXPECT_FALSE(s3.contains(5));
+
+    s1.add(5);
+    s1.add(3);
+    EXPECT_EQ(2, s1.size());
+    EXPECT_TRUE(s1.contains(5));
+    EXPECT_EQ((std::vector<int>{3, 5}), elementsInRange(s1, 0, 100));
+
+    s3.add(7);
+    EXPECT_TRUE(s3.contains(7));
+}
+
+
+TEST(SkipListSet_Tests, geometricLevelTesterHasTheRequestedBranching)
+{
+    for (unsigned int log2Branching : {1u, 2u})
+    {
+        GeometricSkipListLevelTester<int> levelTester{log2Branching, 32, 46};
+        std::vector<unsigned int> atLeast(4, 0);
+
+        for (int i = 0; i < 100000; ++i)
+        {
+            unsigned int height = levelTester.chooseHeight(i, 32);
+
+            for (unsigned int level = 0; level < height && level < atLeast.size(); ++level)
+            {
+                ++atLeast[level];
+            }
+        }
+
+        // Each level should hold about 1 / 2^log2Branching of the keys on
+        // the level below it.
+        double expected = 1.0 / (1u << log2Branching);
+
+        for (unsigned int level = 1; level < atLeast.size(); ++level)
+        {
+            double ratio = static_cast<double>(atLeast[level]) / atLeast[level - 1];
+            EXPECT_NEAR(expected, ratio, 0.03);
+        }
+    }
+}
+
+
+TEST(SkipListSet_Tests, geometricLevelTesterRespectsMaxHeight)
+{
+    GeometricSkipListLevelTester<int> levelTester{1, 3, 46};
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        unsigned int height = levelTester.chooseHeight(i, 32);
+        EXPECT_LE(1, height);
+        EXPECT_LE(height, 3);
+
+        EXPECT_LE(levelTester.chooseHeight(i, 2), 2);
+    }
+
+    SkipListSet<int> s{std::make_unique<GeometricSkipListLevelTester<int>>(1, 3, 46)};
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(3, s.levelCount());
+}
+
+
+TEST(SkipListSet_Tests, geometricLevelTesterFlipsAgreeWithHeights)
+{
+    // Asking for flips one at a time gives the same heights as asking
+    // for whole heights, given the same seed.
+    GeometricSkipListLevelTester<int> byHeight{2, 32, 46};
+    GeometricSkipListLevelTester<int> byFlip{2, 32, 46};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        unsigned int height = 1;
+
+        while (byFlip.shouldOccupyNextLevel(i))
+        {
+            ++height;
+        }
+
+        EXPECT_EQ(byHeight.chooseHeight(i, 32), height);
+    }
+}
+
+
+TEST(SkipListSet_Tests, lowerBoundFindsSmallestElementNotLessThanGiven)
+{
+    SkipListSet<int> s;
+
+    for (int i = 10; i <= 100; i += 10)
+    {
+        s.add(i);
+    }
+
+    ASSERT_NE(nullptr, s.lowerBound(5));
+    EXPECT_EQ(10, *s.lowerBound(5));
+    EXPECT_EQ(10, *s.lowerBound(10));
+    EXPECT_EQ(20, *s.lowerBound(11));
+    EXPECT_EQ(100, *s.lowerBound(91));
+    EXPECT_EQ(nullptr, s.lowerBound(101));
+
+    EXPECT_EQ(nullptr, SkipListSet<int>{}.lowerBound(0));
+}
+
+
+TEST(SkipListSet_Tests, forEachInRangeVisitsHalfOpenRangeInOrder)
+{
+    SkipListSet<int> s;
+
+    for (int i : {50, 20, 80, 10, 40, 70, 30, 60, 90})
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ((std::vector<int>{30, 40, 50}), elementsInRange(s, 25, 60));
+    EXPECT_EQ((std::vector<int>{30, 40, 50, 60}), elementsInRange(s, 30, 61));
+    EXPECT_EQ((std::vector<int>{10, 20, 30, 40, 50, 60, 70, 80, 90}), elementsInRange(s, 0, 100));
+    EXPECT_TRUE(elementsInRange(s, 41, 50).empty());
+    EXPECT_TRUE(elementsInRange(s, 95, 200).empty());
+    EXPECT_TRUE(elementsInRange(s, 60, 30).empty());
+}
+
+
+TEST(SkipListSet_Tests, sortedAndReverseSortedLookupsFindEverything)
+{
+    SkipListSet<int> s;
+
+    for (int i = 0; i < 10000; i += 2)
+    {
+        s.add(i);
+    }
+
+    SkipListSet<int>::Finger finger;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, s.contains(i));
+        EXPECT_EQ(i % 2 == 0, s.containsFrom(finger, i));
+    }
+
+    for (int i = 10000; i-- > 0; )
+    {
+        EXPECT_EQ(i % 2 == 0, s.contains(i));
+        EXPECT_EQ(i % 2 == 0, s.containsFrom(finger, i));
+    }
+
+    // Adding in reverse order has to search to the left of the finger
+    // every time.
+    SkipListSet<int> reversed;
+
+    for (int i = 10000; i-- > 0; )
+    {
+        reversed.add(i);
+    }
+
+    EXPECT_EQ(10000, reversed.size());
+    EXPECT_EQ(10000, reversed.elementsOnLevel(0));
+    EXPECT_EQ((std::vector<int>{0, 1, 2}), elementsInRange(reversed, -5, 3));
+}
+
+
+TEST(SkipListSet_Tests, interleavedSearchesMatchStdSet)
+{
+    // Mixing adds, lookups, and ordered searches, with elements jumping
+    // back and forth by distances both small and large, leaves the fingers
+    // (add()'s and the one searched from here) in every kind of position
+    // before a search.
+    SkipListSet<int> s;
+    SkipListSet<int>::Finger finger;
+    std::set<int> expected;
+
+    std::mt19937 random{46};
+    std::uniform_int_distribution<int> keys{0, 19999};
+    std::uniform_int_distribution<int> steps{-20, 20};
+    int key = 10000;
+
+    for (int i = 0; i < 50000; ++i)
+    {
+        key = (i % 3 == 0) ? keys(random) : std::max(0, std::min(19999, key + steps(random)));
+
+        switch (i % 4)
+        {
+        case 0:
+            s.add(key);
+            expected.insert(key);
+            break;
+
+        case 1:
+            ASSERT_EQ(expected.count(key) == 1, s.contains(key));
+            ASSERT_EQ(expected.count(key) == 1, s.containsFrom(finger, key));
+            break;
+
+        case 2:
+        {
+            auto expectedBound = expected.lower_bound(key);
+            const int* bound = i % 8 == 2 ? s.lowerBound(key) : s.lowerBound(finger, key);
+
+            if (expectedBound == expected.end())
+            {
+                ASSERT_EQ(nullptr, bound);
+            }
+            else
+            {
+                ASSERT_NE(nullptr, bound);
+                ASSERT_EQ(*expectedBound, *bound);
+            }
+
+            break;
+        }
+
+        default:
+            ASSERT_EQ(
+                std::vector<int>(expected.lower_bound(key), expected.lower_bound(key + 50)),
+                elementsInRange(s, key, key + 50));
+            break;
+        }
+    }
+
+    EXPECT_EQ(expected.size(), s.size());
+}
+
+
+TEST(SkipListSet_Tests, copiesAndMovesHaveUsableFingers)
+{
+    SkipListSet<int>::Finger finger;
+
+    SkipListSet<int> s1 = makeTrailingZerosSet(100);
+    EXPECT_TRUE(s1.containsFrom(finger, 50));
+
+    SkipListSet<int> s2{s1};
+    EXPECT_TRUE(s2.containsFrom(finger, 1));
+    EXPECT_TRUE(s2.containsFrom(finger, 100));
+    EXPECT_FALSE(s2.containsFrom(finger, 101));
+
+    SkipListSet<int> s3{std::move(s2)};
+    s3.add(0);
+    EXPECT_EQ((std::vector<int>{0, 1, 2}), elementsInRange(s3, 0, 3));
+    EXPECT_TRUE(s3.containsFrom(finger, 0));
+
+    // The finger was last used with s3, whose nodes are replaced by the
+    // assignment, so it starts over rather than following freed nodes.
+    s3 = makeTrailingZerosSet(10);
+    EXPECT_FALSE(s3.containsFrom(finger, 50));
+    EXPECT_TRUE(s3.containsFrom(finger, 10));
+
+    s2 = s3;
+    EXPECT_EQ((std::vector<int>{9, 10}), elementsInRange(s2, 9, 1000));
+    EXPECT_EQ(1, *s2.lowerBound(finger, -1));
+}
+
+
+TEST(SkipListSet_Tests, fingersKeepWorkingAsLevelsAreAdded)
+{
+    SkipListSet<int> s{std::make_unique<TrailingZerosLevelTester>()};
+    SkipListSet<int>::Finger finger;
+
+    for (int i = 1; i <= 1024; ++i)
+    {
+        s.add(i);
+
+        ASSERT_TRUE(s.containsFrom(finger, i));
+        ASSERT_TRUE(s.containsFrom(finger, (i + 1) / 2));
+        ASSERT_FALSE(s.containsFrom(finger, i + 1));
+    }
+
+    EXPECT_EQ(11, s.levelCount());
+}
+
+
+TEST(SkipListSet_Tests, searchesFromManyThreadsAtOnceFindEverything)
+{
+    SkipListSet<int> s;
+
+    for (int i = 0; i < 20000; i += 2)
+    {
+        s.add(i);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<unsigned int> mistakes(4, 0);
+
+    for (unsigned int t = 0; t < mistakes.size(); ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                SkipListSet<int>::Finger finger;
+
+                for (int i = static_cast<int>(t); i < 20000; i += 3)
+                {
+                    if (s.contains(i) != (i % 2 == 0) || s.containsFrom(finger, i) != (i % 2 == 0))
+                    {
+                        ++mistakes[t];
+                    }
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(std::vector<unsigned int>(4, 0), mistakes);
+}
@@ -0,0 +1,167 @@
+// SpellCheckServer_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SpellCheckServer's responses, both directly and through
+// a SpellCheckClient connected to a running server.
+
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+#include "SpellCheckClient.hpp"
+#include "SpellCheckServer.hpp"
+#include "StringHashing.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    class SpellCheckServerTest : public testing::Test
+    {
+    protected:
+        SpellCheckServerTest()
+            : set{hashStringAsProduct, hashStringAsProduct}, wordChecker{set},
+              socketPath{testing::TempDir() + "SpellCheckServer_Tests.sock"}
+        {
+            for (const char* word : {"THE", "CAT", "SAT", "ON", "MAT"})
+            {
+                set.add(word);
+            }
+        }
+
+
+        HashSet<std::string> set;
+        WordChecker wordChecker;
+        std::string socketPath;
+    };
+}
+
+
+TEST_F(SpellCheckServerTest, checkAnswersEveryWordInOrder)
+{
+    SpellCheckServer server{wordChecker, socketPath};
+
+    EXPECT_EQ("OK 1 0 1 1", server.respond("CHECK THE CTA sat   ON"));
+    EXPECT_EQ("OK", server.respond("CHECK"));
+}
+
+
+TEST_F(SpellCheckServerTest, suggestAnswersEveryWordInOrder)
+{
+    SpellCheckServer server{wordChecker, socketPath};
+
+    EXPECT_EQ("OK CAT -", server.respond("SUGGEST cta XYZZY"));
+
+    // The second time, the suggestions come from the cache.
+    EXPECT_EQ("OK CAT", server.respond("SUGGEST CTA"));
+}
+
+
+TEST_F(SpellCheckServerTest, unknownRequestsAreErrors)
+{
+    SpellCheckServer server{wordChecker, socketPath};
+
+    EXPECT_EQ("ERROR Unknown request: LOOKUP", server.respond("LOOKUP CAT"));
+    EXPECT_EQ(0, server.statistics().requests);
+}
+
+
+TEST_F(SpellCheckServerTest, clientsAreAnsweredOverTheSocket)
+{
+    SpellCheckServer server{wordChecker, socketPath};
+    std::thread serverThread{[&]() { server.run(); }};
+
+    {
+        SpellCheckClient first{socketPath};
+        SpellCheckClient second{socketPath};
+
+        EXPECT_EQ("OK 1 0", first.request("CHECK CAT CTA"));
+
+        // Requests sent together are answered in order, even when they
+        // arrive split in the middle of one.
+        second.send("CHECK MAT\nSUGGEST CTA\nCHE");
+        second.send("CK XYZZY\r\nHELLO\n");
+
+        EXPECT_EQ("OK 1", second.receive());
+        EXPECT_EQ("OK CAT", second.receive());
+        EXPECT_EQ("OK 0", second.receive());
+        EXPECT_EQ("ERROR Unknown request: HELLO", second.receive());
+
+        EXPECT_EQ("OK 1", first.request("CHECK THE"));
+    }
+
+    server.stop();
+    serverThread.join();
+
+    EXPECT_EQ(2, server.statistics().connections);
+    EXPECT_EQ(5, server.statistics().requests);
+    EXPECT_EQ(6, server.statistics().words);
+}
+
+
+TEST_F(SpellCheckServerTest, largeBatchesAreAnsweredCompletely)
+{
+    SpellCheckServer server{wordChecker, socketPath};
+    std::thread serverThread{[&]() { server.run(); }};
+
+    std::string requests;
+
+    for (unsigned int i = 0; i < 20000; ++i)
+    {
+        requests += "CHECK THE CTA ON\n";
+    }
+
+    {
+        SpellCheckClient client{socketPath};
+        client.send(requests);
+
+        for (unsigned int i = 0; i < 20000; ++i)
+        {
+            ASSERT_EQ("OK 1 0 1", client.receive());
+        }
+    }
+
+    server.stop();
+    serverThread.join();
+}
+
+
+TEST_F(SpellCheckServerTest, sendingMoreThanTheServerWillBufferDoesNotDeadlock)
+{
+    // The responses to these add up to several times what the server will
+    // buffer for a connection before it stops reading from it, so they
+    // can only all be sent if the client reads responses while it sends.
+    SpellCheckServer server{wordChecker, socketPath};
+    std::thread serverThread{[&]() { server.run(); }};
+
+    constexpr unsigned int REQUEST_COUNT = 200000;
+    std::string requests;
+
+    for (unsigned int i = 0; i < REQUEST_COUNT; ++i)
+    {
+        requests += "CHECK THE CTA ON SAT MAT XYZZY CAT\n";
+    }
+
+    {
+        SpellCheckClient client{socketPath};
+        client.send(requests);
+
+        for (unsigned int i = 0; i < REQUEST_COUNT; ++i)
+        {
+            ASSERT_EQ("OK 1 0 1 1 1 0 1", client.receive());
+        }
+    }
+
+    server.stop();
+    serverThread.join();
+
+    EXPECT_EQ(REQUEST_COUNT, server.statistics().requests);
+}
+
+
+TEST_F(SpellCheckServerTest, connectingWithoutAServerFails)
+{
+    EXPECT_THROW(SpellCheckClient{socketPath}, SpellCheckClient::ConnectionException);
+}
@@ -0,0 +1,224 @@
+// SpellChecker_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SpellChecker, mainly that checking text in parallel
+// notifies its observers of exactly the same misspellings, in exactly the
+// same order, as checking it on one thread does.
+
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+#include "MappedTextFileReader.hpp"
+#include "OutputSpellCheckerListener.hpp"
+#include "SpellChecker.hpp"
+#include "StringHashing.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    class ThrowingListener : public SpellCheckerListener
+    {
+    public:
+        void misspellingFound(
+            const std::string&, const std::string&, const std::vector<std::string>&) override
+        {
+            throw std::runtime_error{"listener failed"};
+        }
+    };
+
+
+    // Lines of words, some of them in the set (and some of them not, with
+    // suggestions), separated by punctuation, with the occasional blank
+    // line, and no newline at the end.
+    std::string makeText(unsigned int lineCount)
+    {
+        static const std::vector<std::string> words{
+            "the", "teh", "cat", "cta", "sat", "on", "mat", "mta", "dog's", "well-known", "xyzzy"};
+
+        std::mt19937 random{46};
+        std::string text;
+
+        for (unsigned int line = 0; line < lineCount; ++line)
+        {
+            for (unsigned int w = random() % 12; w > 0; --w)
+            {
+                text += words[random() % words.size()];
+                text += (random() % 4 == 0 ? ", " : " ");
+            }
+
+            if (line + 1 < lineCount)
+            {
+                text += '\n';
+            }
+        }
+
+        return text;
+    }
+
+
+    class SpellCheckerTest : public testing::Test
+    {
+    protected:
+        SpellCheckerTest()
+            : set{hashStringAsProduct, hashStringAsProduct}
+        {
+            for (const char* word : {"THE", "CAT", "SAT", "ON", "MAT", "DOG'S"})
+            {
+                set.add(word);
+            }
+        }
+
+
+        std::string checkSerially(const std::string& text)
+        {
+            std::string filePath = testing::TempDir() + "SpellChecker_Tests.txt";
+            std::ofstream{filePath, std::ios::binary} << text;
+
+            std::ostringstream out;
+            SpellChecker spellChecker;
+            std::shared_ptr<SpellCheckerListener> output =
+                std::make_shared<OutputSpellCheckerListener>(out);
+
+            spellChecker.addObserver(output);
+
+            WordChecker wordChecker{set};
+            MappedTextFileReader reader{filePath};
+            spellChecker.run(wordChecker, reader);
+
+            return out.str();
+        }
+
+
+        std::string checkInParallel(
+            std::string_view text, unsigned int threadCount, std::size_t chunkBytes)
+        {
+            std::ostringstream out;
+            SpellChecker spellChecker;
+            std::shared_ptr<SpellCheckerListener> output =
+                std::make_shared<OutputSpellCheckerListener>(out);
+
+            spellChecker.addObserver(output);
+            spellChecker.runParallel(WordChecker{set}, text, threadCount, chunkBytes);
+
+            return out.str();
+        }
+
+
+        HashSet<std::string> set;
+    };
+}
+
+
+TEST_F(SpellCheckerTest, parallelOutputIsTheSameAsSerialOutput)
+{
+    std::string text = makeText(500);
+    std::string expected = checkSerially(text);
+
+    ASSERT_FALSE(expected.empty());
+
+    for (unsigned int threadCount : {1, 2, 3, 8})
+    {
+        for (std::size_t chunkBytes : {1, 7, 64, 1000, 100000})
+        {
+            EXPECT_EQ(expected, checkInParallel(text, threadCount, chunkBytes))
+                << threadCount << " threads, " << chunkBytes << "-byte chunks";
+        }
+    }
+}
+
+
+TEST_F(SpellCheckerTest, automaticallySizedChunksAreTheSameAsSerialOutput)
+{
+    std::string text = makeText(2000);
+    std::string expected = checkSerially(text);
+
+    for (unsigned int threadCount : {1, 4})
+    {
+        std::ostringstream out;
+        SpellChecker spellChecker;
+        std::shared_ptr<SpellCheckerListener> output =
+            std::make_shared<OutputSpellCheckerListener>(out);
+
+        spellChecker.addObserver(output);
+        spellChecker.runParallel(WordChecker{set}, text, threadCount);
+
+        EXPECT_EQ(expected, out.str());
+    }
+}
+
+
+TEST_F(SpellCheckerTest, correctlySpelledTextsFindNothing)
+{
+    EXPECT_EQ("", checkSerially("the cat sat\non the mat\n"));
+    EXPECT_EQ("", checkInParallel("the cat sat\non the mat\n", 4, 1));
+}
+
+
+TEST_F(SpellCheckerTest, parallelChecksOfEmptyAndWordlessTextsFindNothing)
+{
+    EXPECT_EQ("", checkInParallel("", 4, 16));
+    EXPECT_EQ("", checkInParallel("\n\n  ...\n--\n", 4, 1));
+}
+
+
+TEST_F(SpellCheckerTest, listenerExceptionsReachTheCaller)
+{
+    std::string text = makeText(500);
+
+    SpellChecker spellChecker;
+    std::shared_ptr<SpellCheckerListener> listener = std::make_shared<ThrowingListener>();
+    spellChecker.addObserver(listener);
+
+    EXPECT_THROW(spellChecker.runParallel(WordChecker{set}, text, 4, 64), std::runtime_error);
+}
+
+
+TEST_F(SpellCheckerTest, repeatedMisspellingsHitTheCache)
+{
+    std::string text = makeText(500);
+
+    SpellChecker spellChecker;
+    spellChecker.runParallel(WordChecker{set}, text, 1, text.size());
+
+    // The text has only eleven distinct words, so the suggestions for each
+    // misspelled one are only found the first time; every other time it's
+    // misspelled is a hit.
+    const SuggestionCache::Statistics& statistics = spellChecker.cacheStatistics();
+    EXPECT_LE(statistics.misses, 11);
+    EXPECT_GT(statistics.hits, 100 * statistics.misses);
+}
+
+
+TEST_F(SpellCheckerTest, outputIsTheSameWithoutTheCache)
+{
+    std::string text = makeText(500);
+    std::string expected = checkSerially(text);
+
+    for (unsigned int cacheCapacity : {0, 1, 2, 3})
+    {
+        std::ostringstream out;
+        SpellChecker spellChecker{cacheCapacity};
+        std::shared_ptr<SpellCheckerListener> output =
+            std::make_shared<OutputSpellCheckerListener>(out);
+
+        spellChecker.addObserver(output);
+        spellChecker.runParallel(WordChecker{set}, text, 4, 64);
+
+        EXPECT_EQ(expected, out.str()) << cacheCapacity;
+
+        if (cacheCapacity == 0)
+        {
+            EXPECT_EQ(0, spellChecker.cacheStatistics().hits);
+        }
+    }
+}
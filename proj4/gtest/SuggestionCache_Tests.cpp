@@ -0,0 +1,106 @@
+// SuggestionCache_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SuggestionCache.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SuggestionCache.hpp"
+
+
+namespace
+{
+    std::vector<std::string> suggestionsFor(const std::string& word)
+    {
+        return std::vector<std::string>{word + "S", word + "Y"};
+    }
+}
+
+
+TEST(SuggestionCache_Tests, findsWhatWasAdded)
+{
+    SuggestionCache cache{10};
+    EXPECT_EQ(nullptr, cache.find("BOO"));
+
+    cache.add("BOO", suggestionsFor("BOO"));
+
+    const std::vector<std::string>* found = cache.find("BOO");
+    ASSERT_NE(nullptr, found);
+    EXPECT_EQ(suggestionsFor("BOO"), *found);
+    EXPECT_EQ(nullptr, cache.find("BOOS"));
+}
+
+
+TEST(SuggestionCache_Tests, countsHitsAndMisses)
+{
+    SuggestionCache cache{10};
+    cache.find("BOO");
+    cache.add("BOO", suggestionsFor("BOO"));
+    cache.find("BOO");
+    cache.find("BOO");
+    cache.find("HOO");
+
+    EXPECT_EQ(2, cache.statistics().hits);
+    EXPECT_EQ(2, cache.statistics().misses);
+    EXPECT_DOUBLE_EQ(50.0, cache.statistics().hitRate());
+}
+
+
+TEST(SuggestionCache_Tests, neverHoldsMoreThanItsCapacity)
+{
+    SuggestionCache cache{16};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string word = "WORD" + std::to_string(i);
+        cache.add(word, suggestionsFor(word));
+        ASSERT_LE(cache.size(), 16);
+
+        // The word just added is always there, with its own suggestions,
+        // even after its slot has been reused many times over.
+        const std::vector<std::string>* found = cache.find(word);
+        ASSERT_NE(nullptr, found);
+        ASSERT_EQ(suggestionsFor(word), *found);
+    }
+
+    EXPECT_EQ(16, cache.size());
+}
+
+
+TEST(SuggestionCache_Tests, wordsFoundAgainSurviveEviction)
+{
+    SuggestionCache cache{4};
+
+    for (const char* word : {"A", "B", "C", "D"})
+    {
+        cache.add(word, suggestionsFor(word));
+    }
+
+    // "B" is found again, so the hand skips it (once) and evicts "A",
+    // then "C", rather than evicting in the order the words were added.
+    cache.find("B");
+    cache.add("E", suggestionsFor("E"));
+    cache.add("F", suggestionsFor("F"));
+
+    EXPECT_EQ(nullptr, cache.find("A"));
+    EXPECT_NE(nullptr, cache.find("B"));
+    EXPECT_EQ(nullptr, cache.find("C"));
+    EXPECT_NE(nullptr, cache.find("D"));
+    EXPECT_NE(nullptr, cache.find("E"));
+    EXPECT_NE(nullptr, cache.find("F"));
+}
+
+
+TEST(SuggestionCache_Tests, zeroCapacityCachesNothing)
+{
+    SuggestionCache cache{0};
+    cache.add("BOO", suggestionsFor("BOO"));
+
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(nullptr, cache.find("BOO"));
+    EXPECT_EQ(0, cache.statistics().hits);
+    EXPECT_EQ(1, cache.statistics().misses);
+}
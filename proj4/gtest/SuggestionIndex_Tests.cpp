@@ -0,0 +1,126 @@
+// SuggestionIndex_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SuggestionIndex, including that a WordChecker finds the
+// same suggestions with one as it does by generating every edit.
+
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+#include "SuggestionIndex.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::string randomWord(std::mt19937& random, const std::string& alphabet)
+    {
+        std::uniform_int_distribution<int> lengths{1, 6};
+        std::uniform_int_distribution<std::size_t> characters{0, alphabet.length() - 1};
+
+        std::string word(lengths(random), ' ');
+
+        for (char& c : word)
+        {
+            c = alphabet[characters(random)];
+        }
+
+        return word;
+    }
+}
+
+
+TEST(SuggestionIndex_Tests, findsEveryKindOfEdit)
+{
+    SuggestionIndex index{std::vector<std::string>{
+        "BOOK", "BOOKS", "BOK", "BOOT", "OBOK", "LOOK", "BOOKKEEPER"}};
+
+    EXPECT_EQ(
+        (std::vector<std::string>{"BOK", "BOOKS", "BOOT", "LOOK", "OBOK"}),
+        index.findOneEditAway("BOOK"));
+}
+
+
+TEST(SuggestionIndex_Tests, wordItselfIsNeverFound)
+{
+    SuggestionIndex index{std::vector<std::string>{"HELLO", "HELLOS"}};
+    EXPECT_EQ((std::vector<std::string>{"HELLOS"}), index.findOneEditAway("HELLO"));
+}
+
+
+TEST(SuggestionIndex_Tests, onlyLettersAreInsertedOrReplaced)
+{
+    // Any character can be deleted or swapped, but only 'A' through 'Z'
+    // are ever inserted or used as replacements.
+    SuggestionIndex index{std::vector<std::string>{"CAN'T", "CANT", "CAN", "CA'NT"}};
+
+    EXPECT_EQ((std::vector<std::string>{"CAN", "CANT"}), index.findOneEditAway("CANX"));
+    EXPECT_EQ((std::vector<std::string>{"CA'NT", "CANT"}), index.findOneEditAway("CAN'T"));
+}
+
+
+TEST(SuggestionIndex_Tests, duplicatesAreIgnored)
+{
+    SuggestionIndex index{std::vector<std::string>{"A", "B", "A", "C", "B"}};
+    EXPECT_EQ(3, index.size());
+    EXPECT_EQ((std::vector<std::string>{"A", "B", "C"}), index.findOneEditAway("D"));
+}
+
+
+TEST(SuggestionIndex_Tests, emptyIndexFindsNothing)
+{
+    SuggestionIndex index{std::vector<std::string>{}};
+    EXPECT_EQ(0, index.size());
+    EXPECT_TRUE(index.findOneEditAway("HELLO").empty());
+    EXPECT_TRUE(index.findOneEditAway("").empty());
+}
+
+
+TEST(SuggestionIndex_Tests, wordCheckerFindsTheSameSuggestionsEitherWay)
+{
+    // A small alphabet makes neighbors common, and the apostrophe is only
+    // ever reachable by deleting or swapping.
+    std::mt19937 random{46};
+    std::vector<std::string> words;
+    HashSet<std::string> set{hashStringAsProduct};
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string word = randomWord(random, "ABCE'");
+        words.push_back(word);
+        set.add(word);
+    }
+
+    SuggestionIndex index{words};
+    WordChecker generating{set};
+    WordChecker indexed{set, index};
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string word = randomWord(random, "ABCDE'");
+        ASSERT_EQ(generating.findSuggestions(word), indexed.findSuggestions(word)) << word;
+    }
+}
+
+
+TEST(SuggestionIndex_Tests, wordCheckerSuggestsSplitsWithAnIndex)
+{
+    std::vector<std::string> words{"ABDC", "ZZZZZ", "HELLO", "THERE"};
+    HashSet<std::string> set{hashStringAsProduct};
+
+    for (const std::string& word : words)
+    {
+        set.add(word);
+    }
+
+    SuggestionIndex index{words};
+    WordChecker checker{set, index};
+
+    EXPECT_EQ((std::vector<std::string>{"ABDC"}), checker.findSuggestions("ABCD"));
+    EXPECT_EQ((std::vector<std::string>{"HELLO THERE"}), checker.findSuggestions("HELLOTHERE"));
+}
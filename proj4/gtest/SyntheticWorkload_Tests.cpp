@@ -0,0 +1,169 @@
+// SyntheticWorkload_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for generateWorkload().
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SyntheticWorkload.hpp"
+
+
+namespace
+{
+    WorkloadOptions makeOptions(unsigned int keyCount, unsigned int lookupCount)
+    {
+        WorkloadOptions options;
+        options.keyCount = keyCount;
+        options.lookupCount = lookupCount;
+        return options;
+    }
+
+
+    unsigned int countHits(const Workload& workload)
+    {
+        std::unordered_set<std::string> keys{workload.keys.begin(), workload.keys.end()};
+
+        return static_cast<unsigned int>(
+            std::count_if(
+                workload.lookups.begin(), workload.lookups.end(),
+                [&](const std::string& lookup) { return keys.count(lookup) > 0; }));
+    }
+}
+
+
+TEST(SyntheticWorkload_Tests, sameOptionsGiveTheSameWorkload)
+{
+    WorkloadOptions options = makeOptions(1000, 1000);
+
+    Workload first = generateWorkload(options);
+    Workload second = generateWorkload(options);
+
+    EXPECT_EQ(first.keys, second.keys);
+    EXPECT_EQ(first.lookups, second.lookups);
+
+    options.seed = 47;
+    EXPECT_NE(first.keys, generateWorkload(options).keys);
+}
+
+
+TEST(SyntheticWorkload_Tests, keysAreDistinctUppercaseStrings)
+{
+    Workload workload = generateWorkload(makeOptions(20000, 0));
+
+    ASSERT_EQ(20000, workload.keys.size());
+
+    std::unordered_set<std::string> distinct{workload.keys.begin(), workload.keys.end()};
+    EXPECT_EQ(workload.keys.size(), distinct.size());
+
+    for (const std::string& key : workload.keys)
+    {
+        ASSERT_FALSE(key.empty());
+        ASSERT_TRUE(
+            std::all_of(key.begin(), key.end(), [](char c) { return c >= 'A' && c <= 'Z'; }))
+            << key;
+    }
+}
+
+
+TEST(SyntheticWorkload_Tests, randomOrderIsNotSorted)
+{
+    Workload workload = generateWorkload(makeOptions(1000, 0));
+    EXPECT_FALSE(std::is_sorted(workload.keys.begin(), workload.keys.end()));
+}
+
+
+TEST(SyntheticWorkload_Tests, sortedAndAdversarialOrdersAreSorted)
+{
+    WorkloadOptions options = makeOptions(1000, 1000);
+
+    options.keyOrder = KeyOrder::Sorted;
+    Workload sorted = generateWorkload(options);
+    EXPECT_TRUE(std::is_sorted(sorted.keys.begin(), sorted.keys.end()));
+
+    options.keyOrder = KeyOrder::Adversarial;
+    Workload adversarial = generateWorkload(options);
+    EXPECT_TRUE(std::is_sorted(adversarial.keys.begin(), adversarial.keys.end()));
+
+    // Every key, including the ones looked up that weren't added, shares
+    // the same long prefix.
+    for (const std::vector<std::string>* keys : {&adversarial.keys, &adversarial.lookups})
+    {
+        for (const std::string& key : *keys)
+        {
+            ASSERT_EQ(adversarial.keys.front().substr(0, 32), key.substr(0, 32));
+        }
+    }
+
+    EXPECT_EQ(adversarial.hitCount, countHits(adversarial));
+}
+
+
+TEST(SyntheticWorkload_Tests, hitCountIsTheNumberOfLookupsOfAddedKeys)
+{
+    WorkloadOptions options = makeOptions(5000, 20000);
+    options.hitRatio = 0.25;
+
+    Workload workload = generateWorkload(options);
+
+    ASSERT_EQ(20000, workload.lookups.size());
+    EXPECT_EQ(workload.hitCount, countHits(workload));
+    EXPECT_NEAR(5000, workload.hitCount, 500);
+}
+
+
+TEST(SyntheticWorkload_Tests, allOrNothingHitRatios)
+{
+    WorkloadOptions options = makeOptions(100, 1000);
+
+    options.hitRatio = 1.0;
+    EXPECT_EQ(1000, countHits(generateWorkload(options)));
+
+    options.hitRatio = 0.0;
+    EXPECT_EQ(0, countHits(generateWorkload(options)));
+}
+
+
+TEST(SyntheticWorkload_Tests, zipfianLookupsFavorAFewKeys)
+{
+    WorkloadOptions options = makeOptions(10000, 100000);
+    options.hitRatio = 1.0;
+    options.lookupDistribution = LookupDistribution::Zipfian;
+
+    Workload workload = generateWorkload(options);
+
+    std::map<std::string, unsigned int> frequencies;
+
+    for (const std::string& lookup : workload.lookups)
+    {
+        ++frequencies[lookup];
+    }
+
+    unsigned int mostFrequent = 0;
+
+    for (const auto& [key, frequency] : frequencies)
+    {
+        mostFrequent = std::max(mostFrequent, frequency);
+    }
+
+    // Uniformly, each key would be looked up about 10 times; the most
+    // popular key under a Zipfian distribution with an exponent of 0.99
+    // is looked up roughly a tenth of the time.
+    EXPECT_GT(mostFrequent, 5000);
+    EXPECT_LT(frequencies.size(), 10000);
+}
+
+
+TEST(SyntheticWorkload_Tests, workloadsWithoutKeysOnlyMiss)
+{
+    Workload workload = generateWorkload(makeOptions(0, 100));
+
+    EXPECT_TRUE(workload.keys.empty());
+    EXPECT_EQ(100, workload.lookups.size());
+    EXPECT_EQ(0, workload.hitCount);
+}
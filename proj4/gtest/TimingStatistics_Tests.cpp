@@ -0,0 +1,94 @@
+// TimingStatistics_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for summarizeTimings().
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "TimingStatistics.hpp"
+
+
+TEST(TimingStatistics_Tests, noDurationsSummarizeAsZero)
+{
+    TimingStatistics statistics = summarizeTimings({});
+
+    EXPECT_EQ(0, statistics.count);
+    EXPECT_DOUBLE_EQ(0.0, statistics.median);
+    EXPECT_DOUBLE_EQ(0.0, statistics.p95);
+    EXPECT_DOUBLE_EQ(0.0, statistics.standardDeviation);
+}
+
+
+TEST(TimingStatistics_Tests, oneDurationIsEveryStatistic)
+{
+    TimingStatistics statistics = summarizeTimings({42.0});
+
+    EXPECT_EQ(1, statistics.count);
+    EXPECT_DOUBLE_EQ(42.0, statistics.minimum);
+    EXPECT_DOUBLE_EQ(42.0, statistics.maximum);
+    EXPECT_DOUBLE_EQ(42.0, statistics.mean);
+    EXPECT_DOUBLE_EQ(42.0, statistics.median);
+    EXPECT_DOUBLE_EQ(42.0, statistics.p95);
+    EXPECT_DOUBLE_EQ(0.0, statistics.standardDeviation);
+}
+
+
+TEST(TimingStatistics_Tests, durationsNeedNotBeSorted)
+{
+    TimingStatistics statistics = summarizeTimings({9.0, 2.0, 4.0, 4.0, 5.0, 4.0, 7.0, 5.0});
+
+    EXPECT_DOUBLE_EQ(2.0, statistics.minimum);
+    EXPECT_DOUBLE_EQ(9.0, statistics.maximum);
+    EXPECT_DOUBLE_EQ(5.0, statistics.mean);
+    EXPECT_DOUBLE_EQ(4.5, statistics.median);
+    EXPECT_DOUBLE_EQ(9.0, statistics.p95);
+    EXPECT_DOUBLE_EQ(std::sqrt(32.0 / 7.0), statistics.standardDeviation);
+}
+
+
+TEST(TimingStatistics_Tests, medianOfAnOddCountIsTheMiddleDuration)
+{
+    EXPECT_DOUBLE_EQ(3.0, summarizeTimings({5.0, 1.0, 3.0}).median);
+}
+
+
+TEST(TimingStatistics_Tests, p95IsTheNearestRank)
+{
+    std::vector<double> durations;
+
+    for (int i = 1; i <= 20; ++i)
+    {
+        durations.push_back(i);
+    }
+
+    EXPECT_DOUBLE_EQ(19.0, summarizeTimings(durations).p95);
+
+    durations.push_back(21.0);
+    EXPECT_DOUBLE_EQ(20.0, summarizeTimings(durations).p95);
+
+    for (int i = 22; i <= 100; ++i)
+    {
+        durations.push_back(i);
+    }
+
+    EXPECT_DOUBLE_EQ(95.0, summarizeTimings(durations).p95);
+}
+
+
+TEST(TimingStatistics_Tests, p99IsTheNearestRank)
+{
+    std::vector<double> durations;
+
+    for (int i = 1; i <= 200; ++i)
+    {
+        durations.push_back(i);
+    }
+
+    EXPECT_DOUBLE_EQ(198.0, summarizeTimings(durations).p99);
+
+    durations.resize(10);
+    EXPECT_DOUBLE_EQ(10.0, summarizeTimings(durations).p99);
+}
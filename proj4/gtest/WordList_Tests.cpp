@@ -0,0 +1,159 @@
+// WordList_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for WordList, and for WordSetLoader, which makes them from
+// word files.
+
+#if defined(__linux__)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "WordList.hpp"
+#include "WordSetLoader.hpp"
+
+
+namespace
+{
+    std::vector<std::string> wordsIn(const WordList& list)
+    {
+        std::vector<std::string> words;
+
+        for (std::size_t i = 0; i < list.size(); ++i)
+        {
+            words.emplace_back(list[i]);
+        }
+
+        return words;
+    }
+
+
+    std::string writeWordFile(const std::string& contents)
+    {
+        std::string filePath = testing::TempDir() + "WordList_Tests.txt";
+        std::ofstream{filePath, std::ios::binary} << contents;
+        return filePath;
+    }
+}
+
+
+TEST(WordList_Tests, emptyListsHaveNoWords)
+{
+    EXPECT_EQ(0, WordList{}.size());
+    EXPECT_EQ(0, WordList::parse("").size());
+}
+
+
+TEST(WordList_Tests, parsesOneUppercasedWordPerLine)
+{
+    WordList list = WordList::parse("boo\nPerfect\nhow-to's\n");
+
+    ASSERT_EQ(3, list.size());
+    EXPECT_EQ("BOO", list[0]);
+    EXPECT_EQ("PERFECT", list[1]);
+    EXPECT_EQ("HOW-TO'S", list[2]);
+}
+
+
+TEST(WordList_Tests, lastLineNeedNotEndWithANewline)
+{
+    EXPECT_EQ(
+        (std::vector<std::string>{"BOO", "HOO"}),
+        wordsIn(WordList::parse("boo\nhoo")));
+}
+
+
+TEST(WordList_Tests, carriageReturnsAreRemoved)
+{
+    EXPECT_EQ(
+        (std::vector<std::string>{"BOO", "HOO", "AB"}),
+        wordsIn(WordList::parse("boo\r\nhoo\r\na\rb\r\n")));
+}
+
+
+TEST(WordList_Tests, emptyLinesAreEmptyWords)
+{
+    EXPECT_EQ(
+        (std::vector<std::string>{"", "BOO", "", "", "HOO"}),
+        wordsIn(WordList::parse("\nboo\n\n\r\nhoo\n")));
+}
+
+
+TEST(WordList_Tests, toStringsCopiesTheWords)
+{
+    WordList list = WordList::parse("boo\nhoo\n");
+    EXPECT_EQ(wordsIn(list), list.toStrings());
+}
+
+
+TEST(WordList_Tests, loaderReadsTheSameWordsEitherWay)
+{
+    std::string filePath = writeWordFile("zebra\r\napple\n\nMango\nkiwi");
+
+    WordSetLoader loader;
+    WordList list = loader.loadWordList(filePath);
+
+    EXPECT_EQ(
+        (std::vector<std::string>{"ZEBRA", "APPLE", "", "MANGO", "KIWI"}),
+        wordsIn(list));
+
+    EXPECT_EQ(wordsIn(list), loader.load(filePath));
+}
+
+
+TEST(WordList_Tests, missingFilesHaveNoWords)
+{
+    std::string filePath = testing::TempDir() + "WordList_Tests.missing";
+
+    EXPECT_EQ(0, WordSetLoader{}.loadWordList(filePath).size());
+    EXPECT_TRUE(WordSetLoader{}.load(filePath).empty());
+}
+
+
+TEST(WordList_Tests, directoriesHaveNoWords)
+{
+    EXPECT_EQ(0, WordSetLoader{}.loadWordList(testing::TempDir()).size());
+}
+
+
+#if defined(__linux__)
+
+TEST(WordList_Tests, loaderReadsNamedPipesUntilTheyEnd)
+{
+    // A pipe has no size, so the words can only be found by reading until
+    // the writer closes it.  There are enough of them to take more than
+    // one read.
+    std::string fifoPath = testing::TempDir() + "WordList_Tests.fifo";
+    ::unlink(fifoPath.c_str());
+    ASSERT_EQ(0, ::mkfifo(fifoPath.c_str(), 0600));
+
+    std::string contents;
+    std::vector<std::string> expected;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        contents += "word" + std::to_string(i) + "\n";
+        expected.push_back("WORD" + std::to_string(i));
+    }
+
+    std::thread writer{
+        [&]()
+        {
+            std::ofstream{fifoPath, std::ios::binary} << contents;
+        }};
+
+    WordList list = WordSetLoader{}.loadWordList(fifoPath);
+    writer.join();
+    ::unlink(fifoPath.c_str());
+
+    EXPECT_EQ(expected, wordsIn(list));
+}
+
+#endif
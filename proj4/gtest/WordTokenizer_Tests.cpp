@@ -0,0 +1,229 @@
+// WordTokenizer_Tests.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the WordTokenizer functions, whose block-at-a-time
+// versions have to agree exactly with the scalar ones, which in turn have
+// to agree with the character-at-a-time rules TextFileReader always had.
+
+#include <cctype>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "WordTokenizer.hpp"
+
+
+namespace
+{
+    using FindNextWord = bool (*)(std::string_view, std::size_t, WordBounds&) noexcept;
+    using AssignUppercaseWord = void (*)(std::string&, std::string_view, const WordBounds&);
+
+
+    std::vector<std::string> tokenize(
+        std::string_view text, FindNextWord findNextWord, AssignUppercaseWord assignUppercaseWord)
+    {
+        std::vector<std::string> words;
+        std::string word;
+        WordBounds bounds;
+
+        for (std::size_t position = 0; findNextWord(text, position, bounds); position = bounds.next)
+        {
+            assignUppercaseWord(word, text, bounds);
+            words.push_back(word);
+        }
+
+        return words;
+    }
+
+
+    bool isAlnum(char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c));
+    }
+
+
+    // This is how TextFileReader split a line into words before there was
+    // a WordTokenizer.
+    std::vector<std::string> tokenizeOriginally(const std::string& line)
+    {
+        std::vector<std::string> words;
+        std::size_t lineIndex = 0;
+
+        while (true)
+        {
+            std::string word;
+
+            while (lineIndex < line.length() && !isAlnum(line[lineIndex]))
+            {
+                ++lineIndex;
+            }
+
+            if (lineIndex >= line.length())
+            {
+                return words;
+            }
+
+            while (lineIndex < line.length() &&
+                (isAlnum(line[lineIndex]) || line[lineIndex] == '-' || line[lineIndex] == '\''))
+            {
+                word.push_back(std::toupper(static_cast<unsigned char>(line[lineIndex++])));
+            }
+
+            if (!isAlnum(word[word.length() - 1]))
+            {
+                word.pop_back();
+            }
+
+            words.push_back(word);
+        }
+    }
+
+
+    // Mostly word characters, but with plenty of the characters on either
+    // side of the ranges the vectorized classification checks for, and
+    // some that aren't ASCII at all.
+    std::string randomText(std::mt19937& random, unsigned int maxLength)
+    {
+        static const std::string characters =
+            "aAzZmM09-'-'  \n\r\t/:@[`{.,!\x80\xc3\xa9\xff";
+
+        std::uniform_int_distribution<unsigned int> lengths{0, maxLength};
+        std::uniform_int_distribution<std::size_t> indexes{0, characters.length() - 1};
+
+        std::string text(lengths(random), ' ');
+
+        for (char& c : text)
+        {
+            c = characters[indexes(random)];
+        }
+
+        return text;
+    }
+}
+
+
+TEST(WordTokenizer_Tests, findsWordsAndTrimsOneTrailingCharacter)
+{
+    std::vector<std::string> expected{
+        "DON'T", "DOGS", "WELL-KNOWN", "X-", "Y", "QUOTED", "A'-B", "4EVER"};
+
+    std::string_view text = "don't dogs' well-known x-- --y 'quoted' a'-b 4ever";
+
+    EXPECT_EQ(expected, tokenize(text, findNextWord, assignUppercaseWord));
+    EXPECT_EQ(expected, tokenize(text, findNextWordScalar, assignUppercaseWordScalar));
+}
+
+
+TEST(WordTokenizer_Tests, emptyAndWordlessTextsHaveNoWords)
+{
+    WordBounds bounds;
+
+    EXPECT_FALSE(findNextWord("", 0, bounds));
+    EXPECT_FALSE(findNextWord("  --  ''  ..  \n\n", 0, bounds));
+    EXPECT_FALSE(findNextWord(std::string(100, '-'), 0, bounds));
+    EXPECT_FALSE(findNextWord("hello", 5, bounds));
+    EXPECT_FALSE(findNextWord("hello", 6, bounds));
+}
+
+
+TEST(WordTokenizer_Tests, findsWordsThatCrossBlocks)
+{
+    // Words and gaps of every length up to twice the largest block size
+    // begin and end at every offset within a block.
+    for (unsigned int gap = 0; gap <= 70; ++gap)
+    {
+        for (unsigned int length = 1; length <= 70; ++length)
+        {
+            std::string text = std::string(gap, ' ') + std::string(length, 'a') + "-'";
+            WordBounds bounds;
+
+            ASSERT_TRUE(findNextWord(text, 0, bounds));
+            EXPECT_EQ(gap, bounds.begin);
+            EXPECT_EQ(gap + length + 1, bounds.end);
+            EXPECT_EQ(gap + length + 2, bounds.next);
+        }
+    }
+}
+
+
+TEST(WordTokenizer_Tests, blocksAgreeWithScalarsFromEveryPosition)
+{
+    std::mt19937 random{46};
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string text = randomText(random, 100);
+
+        for (std::size_t position = 0; position <= text.length(); ++position)
+        {
+            WordBounds bounds;
+            WordBounds scalarBounds;
+
+            bool found = findNextWord(text, position, bounds);
+            ASSERT_EQ(findNextWordScalar(text, position, scalarBounds), found);
+
+            if (found)
+            {
+                ASSERT_EQ(scalarBounds.begin, bounds.begin);
+                ASSERT_EQ(scalarBounds.end, bounds.end);
+                ASSERT_EQ(scalarBounds.next, bounds.next);
+            }
+        }
+    }
+}
+
+
+TEST(WordTokenizer_Tests, tokenizersAgreeWithTheOriginalRules)
+{
+    std::mt19937 random{47};
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string text = randomText(random, 200);
+        std::vector<std::string> expected = tokenizeOriginally(text);
+
+        ASSERT_EQ(expected, tokenize(text, findNextWord, assignUppercaseWord));
+        ASSERT_EQ(expected, tokenize(text, findNextWordScalar, assignUppercaseWordScalar));
+    }
+}
+
+
+TEST(WordTokenizer_Tests, uppercasesEveryCharacterLikeToupper)
+{
+    std::string text;
+
+    for (int c = 0; c < 256; ++c)
+    {
+        text.push_back(static_cast<char>(c));
+    }
+
+    // Words of every length, beginning at every offset within a block, and
+    // ending anywhere from well before the end of the text to right at it.
+    for (std::size_t begin = 0; begin < 64; ++begin)
+    {
+        for (std::size_t end = begin; end <= text.length(); ++end)
+        {
+            std::string expected;
+
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                expected.push_back(
+                    static_cast<char>(std::toupper(static_cast<unsigned char>(text[i]))));
+            }
+
+            // The targets start out longer than the results, to be sure
+            // that they're replaced rather than overwritten.
+            std::string target(300, '*');
+            std::string scalarTarget(300, '*');
+
+            assignUppercaseWord(target, text, WordBounds{begin, end, end});
+            assignUppercaseWordScalar(scalarTarget, text, WordBounds{begin, end, end});
+
+            ASSERT_EQ(expected, target);
+            ASSERT_EQ(expected, scalarTarget);
+        }
+    }
+}
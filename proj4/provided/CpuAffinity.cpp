@@ -0,0 +1,31 @@
+// CpuAffinity.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "CpuAffinity.hpp"
+
+
+
+bool pinToCpu(unsigned int cpu)
+{
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE)
+    {
+        return false;
+    }
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+
+    // A pid of zero means the calling thread.
+    return ::sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+    return false;
+#endif
+}
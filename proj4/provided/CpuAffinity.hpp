@@ -0,0 +1,23 @@
+// CpuAffinity.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// pinToCpu() restricts the calling thread to running on one CPU, so that
+// timings aren't disturbed by the operating system moving it from one CPU
+// to another (and leaving its caches behind).  Threads it starts later
+// inherit the restriction, so they all share that one CPU.
+//
+// Pinning is only supported on Linux; elsewhere, and when the CPU doesn't
+// exist or can't be used, pinToCpu() changes nothing and returns false.
+
+#ifndef CPUAFFINITY_HPP
+#define CPUAFFINITY_HPP
+
+
+
+bool pinToCpu(unsigned int cpu);
+
+
+
+#endif // CPUAFFINITY_HPP
@@ -22,6 +22,7 @@ public:
     bool isImplemented() const noexcept override;
     void add(const ElementType& element) override;
     bool contains(const ElementType& element) const override;
+    using Set<ElementType>::contains;
     unsigned int size() const noexcept override;
 };
 
@@ -18,6 +18,9 @@
 template <typename ElementType>
 class ListSet : public Set<ElementType>
 {
+public:
+    using ElementView = typename Set<ElementType>::ElementView;
+
 public:
     ListSet() noexcept;
     ~ListSet() noexcept override;
@@ -29,7 +32,10 @@ public:
     bool isImplemented() const noexcept override;
     void add(const ElementType& element) override;
     bool contains(const ElementType& element) const override;
+    bool contains(ElementView element) const override;
+    using Set<ElementType>::contains;
     unsigned int size() const noexcept override;
+    SetMemoryUsage memoryUsage() const override;
 
 private:
     struct Node
@@ -43,6 +49,9 @@ private:
 private:
     Node* copyAll(const ListSet& s);
     void destroyAll(Node* head) noexcept;
+
+    template <typename Key>
+    bool search(const Key& key) const;
 };
 
 
@@ -128,19 +137,21 @@ void ListSet<ElementType>::add(const ElementType& element)
 template <typename ElementType>
 bool ListSet<ElementType>::contains(const ElementType& element) const
 {
-    Node* curr = head;
+    return search(element);
+}
 
-    while (curr != nullptr)
-    {
-        if (curr->element == element)
-        {
-            return true;
-        }
 
-        curr = curr->next;
+template <typename ElementType>
+bool ListSet<ElementType>::contains(ElementView element) const
+{
+    if constexpr (Set<ElementType>::HAS_ELEMENT_VIEW)
+    {
+        return search(element);
+    }
+    else
+    {
+        return false;
     }
-
-    return false;
 }
 
 
@@ -160,6 +171,22 @@ unsigned int ListSet<ElementType>::size() const noexcept
 }
 
 
+template <typename ElementType>
+SetMemoryUsage ListSet<ElementType>::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+
+    for (Node* curr = head; curr != nullptr; curr = curr->next)
+    {
+        usage.nodeBytes += sizeof(Node);
+        usage.keyBytes += elementHeapBytes(curr->element);
+    }
+
+    return usage;
+}
+
+
 template <typename ElementType>
 typename ListSet<ElementType>::Node* ListSet<ElementType>::copyAll(const ListSet& s)
 {
@@ -198,6 +225,26 @@ void ListSet<ElementType>::destroyAll(Node* head) noexcept
 }
 
 
+template <typename ElementType>
+template <typename Key>
+bool ListSet<ElementType>::search(const Key& key) const
+{
+    Node* curr = head;
+
+    while (curr != nullptr)
+    {
+        if (curr->element == key)
+        {
+            return true;
+        }
+
+        curr = curr->next;
+    }
+
+    return false;
+}
+
+
 
 #endif // LISTSET_HPP
 
@@ -0,0 +1,102 @@
+// MappedFile.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include "MappedFile.hpp"
+
+
+
+MappedFile::OpenException::OpenException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+std::string MappedFile::OpenException::reason() const
+{
+    return reason_;
+}
+
+
+
+MappedFile::MappedFile(const std::string& filePath)
+    : data_{nullptr}, size_{0}
+{
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        throw OpenException{"Cannot open file: " + filePath};
+    }
+
+    struct stat status;
+
+    if (::fstat(fd, &status) != 0)
+    {
+        ::close(fd);
+        throw OpenException{"Cannot determine size of file: " + filePath};
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+
+    if (size_ > 0)
+    {
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (mapping == MAP_FAILED)
+        {
+            ::close(fd);
+            throw OpenException{"Cannot map file: " + filePath};
+        }
+
+        data_ = static_cast<const char*>(mapping);
+    }
+
+    // The mapping keeps its own reference to the file, so the descriptor
+    // isn't needed anymore.
+    ::close(fd);
+}
+
+
+MappedFile::~MappedFile() noexcept
+{
+    if (data_ != nullptr)
+    {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+
+MappedFile::MappedFile(MappedFile&& f) noexcept
+    : data_{nullptr}, size_{0}
+{
+    std::swap(data_, f.data_);
+    std::swap(size_, f.size_);
+}
+
+
+MappedFile& MappedFile::operator=(MappedFile&& f) noexcept
+{
+    std::swap(data_, f.data_);
+    std::swap(size_, f.size_);
+    return *this;
+}
+
+
+const char* MappedFile::data() const noexcept
+{
+    return data_;
+}
+
+
+std::size_t MappedFile::size() const noexcept
+{
+    return size_;
+}
+
@@ -0,0 +1,62 @@
+// MappedFile.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A MappedFile maps an entire file into memory, read-only, using mmap(),
+// so that its contents can be read in place through an ordinary pointer
+// without being copied into a buffer first.  Pages are only read from
+// disk when they're first touched, so mapping a file is nearly free no
+// matter how large it is.
+//
+// The mapping lasts as long as the MappedFile object does; MappedFiles
+// can be moved but not copied.
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+
+
+class MappedFile
+{
+public:
+    // Maps the file at the given path, throwing an OpenException if
+    // it can't be opened or mapped.  Empty files are allowed, in which
+    // case data() returns nullptr and size() returns 0.
+    explicit MappedFile(const std::string& filePath);
+
+    ~MappedFile() noexcept;
+
+    MappedFile(const MappedFile& f) = delete;
+    MappedFile(MappedFile&& f) noexcept;
+    MappedFile& operator=(const MappedFile& f) = delete;
+    MappedFile& operator=(MappedFile&& f) noexcept;
+
+    const char* data() const noexcept;
+    std::size_t size() const noexcept;
+
+
+    class OpenException
+    {
+    public:
+        OpenException(const std::string& reason);
+
+        std::string reason() const;
+
+    private:
+        std::string reason_;
+    };
+
+
+private:
+    const char* data_;
+    std::size_t size_;
+};
+
+
+
+#endif // MAPPEDFILE_HPP
+
@@ -0,0 +1,37 @@
+// MappedTextFileReader.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "MappedTextFileReader.hpp"
+
+
+
+MappedTextFileReader::MappedTextFileReader(const std::string& textFilePath)
+    : file{textFilePath}, reader{std::string_view{file.data(), file.size()}}
+{
+}
+
+
+bool MappedTextFileReader::noMoreWords() const noexcept
+{
+    return reader.noMoreWords();
+}
+
+
+void MappedTextFileReader::advanceToNextWord()
+{
+    reader.advanceToNextWord();
+}
+
+
+std::string_view MappedTextFileReader::currentLine() const noexcept
+{
+    return reader.currentLine();
+}
+
+
+std::string_view MappedTextFileReader::currentWord() const noexcept
+{
+    return reader.currentWord();
+}
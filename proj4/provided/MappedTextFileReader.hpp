@@ -0,0 +1,46 @@
+// MappedTextFileReader.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A MappedTextFileReader consumes an input file word by word, splitting it
+// into words by exactly the same rules as TextFileReader, but it maps the
+// file into memory (using a MappedFile) instead of reading it a line at a
+// time, then reads it with a TextViewReader, so it returns std::string_views
+// rather than std::strings: lines point directly into the mapped file, and
+// words into a buffer that's reused for every word.
+//
+// The views are only valid until the next call to advanceToNextWord(),
+// and for no longer than the MappedTextFileReader itself.
+
+#ifndef MAPPEDTEXTFILEREADER_HPP
+#define MAPPEDTEXTFILEREADER_HPP
+
+#include <string>
+#include <string_view>
+#include "MappedFile.hpp"
+#include "TextViewReader.hpp"
+
+
+
+class MappedTextFileReader
+{
+public:
+    // Maps the file at the given path, throwing a MappedFile::OpenException
+    // if it can't be opened or mapped.
+    explicit MappedTextFileReader(const std::string& textFilePath);
+
+    bool noMoreWords() const noexcept;
+    void advanceToNextWord();
+
+    std::string_view currentLine() const noexcept;
+    std::string_view currentWord() const noexcept;
+
+private:
+    MappedFile file;
+    TextViewReader reader;
+};
+
+
+
+#endif // MAPPEDTEXTFILEREADER_HPP
@@ -0,0 +1,226 @@
+// PerformanceCounters.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include "PerformanceCounters.hpp"
+
+
+
+namespace
+{
+#if defined(__linux__)
+    using CountMember = std::optional<std::uint64_t> PerformanceCounters::Counts::*;
+
+    constexpr CountMember COUNT_MEMBERS[] = {
+        &PerformanceCounters::Counts::cycles,
+        &PerformanceCounters::Counts::instructions,
+        &PerformanceCounters::Counts::l1DataMisses,
+        &PerformanceCounters::Counts::lastLevelCacheMisses,
+        &PerformanceCounters::Counts::branchMisses
+    };
+
+
+    struct EventType
+    {
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+
+    // In the same order as COUNT_MEMBERS.  The kernel's generic "cache
+    // misses" event is, on most processors, last-level cache misses.
+    constexpr EventType EVENT_TYPES[] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE,
+         PERF_COUNT_HW_CACHE_L1D
+         | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+         | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}
+    };
+
+
+    int openCounter(const EventType& eventType)
+    {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+
+        attributes.size = sizeof(attributes);
+        attributes.type = eventType.type;
+        attributes.config = eventType.config;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attributes.disabled = 1;
+        attributes.inherit = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+
+        // This process (0), on whichever CPU it runs (-1), in no group (-1).
+        return static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+#endif
+}
+
+
+
+PerformanceCounters::PerformanceCounters()
+    : descriptors{}, startReadings{}, unavailableReason_{}, lastCounts_{}
+{
+#if defined(__linux__)
+    for (unsigned int i = 0; i < EVENT_COUNT; ++i)
+    {
+        descriptors[i] = openCounter(EVENT_TYPES[i]);
+
+        if (descriptors[i] < 0 && unavailableReason_.empty())
+        {
+            unavailableReason_ = std::string{"perf_event_open: "} + std::strerror(errno);
+        }
+    }
+
+    if (available())
+    {
+        unavailableReason_.clear();
+    }
+#else
+    for (unsigned int i = 0; i < EVENT_COUNT; ++i)
+    {
+        descriptors[i] = -1;
+    }
+
+    unavailableReason_ = "Performance counters are only supported on Linux";
+#endif
+}
+
+
+PerformanceCounters::~PerformanceCounters() noexcept
+{
+#if defined(__linux__)
+    for (int descriptor : descriptors)
+    {
+        if (descriptor >= 0)
+        {
+            ::close(descriptor);
+        }
+    }
+#endif
+}
+
+
+bool PerformanceCounters::available() const noexcept
+{
+    for (int descriptor : descriptors)
+    {
+        if (descriptor >= 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+const std::string& PerformanceCounters::unavailableReason() const noexcept
+{
+    return unavailableReason_;
+}
+
+
+void PerformanceCounters::start()
+{
+#if defined(__linux__)
+    // The counters aren't reset, since resetting one zeroes its value but
+    // not its times; instead, they're read while they're still disabled,
+    // and stop() measures from there.
+    for (unsigned int i = 0; i < EVENT_COUNT; ++i)
+    {
+        Reading reading;
+
+        if (readCounter(descriptors[i], reading))
+        {
+            startReadings[i] = reading;
+        }
+        else
+        {
+            startReadings[i].reset();
+        }
+    }
+
+    for (int descriptor : descriptors)
+    {
+        if (descriptor >= 0)
+        {
+            ::ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+
+void PerformanceCounters::stop()
+{
+    lastCounts_ = Counts{};
+
+#if defined(__linux__)
+    for (int descriptor : descriptors)
+    {
+        if (descriptor >= 0)
+        {
+            ::ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (unsigned int i = 0; i < EVENT_COUNT; ++i)
+    {
+        Reading reading;
+
+        if (!startReadings[i] || !readCounter(descriptors[i], reading))
+        {
+            continue;
+        }
+
+        std::uint64_t value = reading.value - startReadings[i]->value;
+        std::uint64_t timeEnabled = reading.timeEnabled - startReadings[i]->timeEnabled;
+        std::uint64_t timeRunning = reading.timeRunning - startReadings[i]->timeRunning;
+
+        // A counter that was never actually counted during this phase
+        // (because others had the hardware the whole time) has no count
+        // to scale up.
+        if (timeRunning == 0)
+        {
+            continue;
+        }
+
+        double scale = static_cast<double>(timeEnabled) / timeRunning;
+        lastCounts_.*COUNT_MEMBERS[i] = static_cast<std::uint64_t>(value * scale + 0.5);
+    }
+#endif
+}
+
+
+const PerformanceCounters::Counts& PerformanceCounters::lastCounts() const noexcept
+{
+    return lastCounts_;
+}
+
+
+bool PerformanceCounters::readCounter(int descriptor, Reading& reading)
+{
+#if defined(__linux__)
+    return descriptor >= 0 && ::read(descriptor, &reading, sizeof(reading)) == sizeof(reading);
+#else
+    static_cast<void>(descriptor);
+    static_cast<void>(reading);
+    return false;
+#endif
+}
@@ -0,0 +1,98 @@
+// PerformanceCounters.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// PerformanceCounters counts hardware events -- CPU cycles, instructions,
+// L1 data cache misses, last-level cache misses, and branch misses --
+// between calls to its start() and stop() member functions, the way a
+// Stopwatch measures time, so that the reasons one set is slower than
+// another can be seen, and not just that it is.
+//
+// The counts come from Linux's perf_event_open system call.  Each event
+// is opened separately, so that one the machine can't count (as virtual
+// machines often can't count cache misses) doesn't prevent the others
+// from being counted; its count is simply missing.  When none can be
+// opened -- because it's not Linux, or the kernel doesn't allow it (see
+// /proc/sys/kernel/perf_event_paranoid) -- every count is missing, and
+// unavailableReason() says why.  Only the events in this process's own
+// code, not the kernel's, are counted, including those in any threads it
+// starts in the meantime.  When the kernel has to share the hardware
+// counters among more events than it has counters, each count is scaled
+// up from the fraction of the time between start() and stop() that the
+// event was actually being counted.
+
+#ifndef PERFORMANCECOUNTERS_HPP
+#define PERFORMANCECOUNTERS_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+
+
+class PerformanceCounters
+{
+public:
+    struct Counts
+    {
+        std::optional<std::uint64_t> cycles;
+        std::optional<std::uint64_t> instructions;
+        std::optional<std::uint64_t> l1DataMisses;
+        std::optional<std::uint64_t> lastLevelCacheMisses;
+        std::optional<std::uint64_t> branchMisses;
+    };
+
+
+public:
+    // Opens as many of the counters as can be opened.
+    PerformanceCounters();
+
+    ~PerformanceCounters() noexcept;
+
+    // Each PerformanceCounters owns its counters' file descriptors, so
+    // they can be neither copied nor moved.
+    PerformanceCounters(const PerformanceCounters& c) = delete;
+    PerformanceCounters& operator=(const PerformanceCounters& c) = delete;
+
+    // available() returns true if at least one of the counters could be
+    // opened; if not, unavailableReason() describes why the first one
+    // couldn't be.
+    bool available() const noexcept;
+    const std::string& unavailableReason() const noexcept;
+
+    void start();
+    void stop();
+
+    // lastCounts() returns the counts between the most recent calls to
+    // start() and stop(), all of which are missing before the first.
+    const Counts& lastCounts() const noexcept;
+
+
+private:
+    static constexpr unsigned int EVENT_COUNT = 5;
+
+    // The value of a counter, read along with how long it has been
+    // enabled and how long it has actually been counted (which is less
+    // when counters are being shared).  The kernel only ever adds to all
+    // three, so a phase's are the differences between the readings taken
+    // by start() and stop().
+    struct Reading
+    {
+        std::uint64_t value;
+        std::uint64_t timeEnabled;
+        std::uint64_t timeRunning;
+    };
+
+    int descriptors[EVENT_COUNT];
+    std::optional<Reading> startReadings[EVENT_COUNT];
+    std::string unavailableReason_;
+    Counts lastCounts_;
+
+private:
+    static bool readCounter(int descriptor, Reading& reading);
+};
+
+
+
+#endif // PERFORMANCECOUNTERS_HPP
@@ -7,15 +7,56 @@
 // template for implementations of a "set" (i.e., a collection of
 // unique elements that allows you to add, search, and determine
 // a size).
+//
+// Sets of strings can also be searched for a std::string_view, so that a
+// word that isn't already a std::string (e.g., one that's part of a larger
+// piece of text) needn't be copied into one just to be looked up.  A string
+// literal could be converted to either a std::string or a view, so there's
+// a contains() for those, too, which searches for it as a view.  Since
+// declaring a contains() in a derived class hides these, each derived
+// class brings them back with a using-declaration.
 
 #ifndef SET_HPP
 #define SET_HPP
 
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "SetMemoryUsage.hpp"
+
+
+
+// SetElementView<ElementType>::Type is the type that can be searched for
+// in place of an ElementType: std::string_view for sets of strings, and
+// NoElementView (which no element can be viewed as) for any other sets.
+struct NoElementView
+{
+};
+
+
+template <typename ElementType>
+struct SetElementView
+{
+    using Type = NoElementView;
+};
+
+
+template <>
+struct SetElementView<std::string>
+{
+    using Type = std::string_view;
+};
 
 
 template <typename ElementType>
 class Set
 {
+public:
+    using ElementView = typename SetElementView<ElementType>::Type;
+
+    static constexpr bool HAS_ELEMENT_VIEW = !std::is_same_v<ElementView, NoElementView>;
+
+
 public:
     // The destructor is declared here mainly so we can assure that it will
     // be virtual.  This is important because we'll be deriving from this class
@@ -39,11 +80,68 @@ public:
     virtual bool contains(const ElementType& element) const = 0;
 
 
+    // This contains() returns true if the element the given view is
+    // equivalent to is already in the set, false otherwise.  Implementations
+    // that don't search for views directly copy the view into an element
+    // and search for that instead.
+    virtual bool contains(ElementView element) const;
+
+
+    // This contains() searches for a string literal (or any other C-style
+    // string) as a view, in sets of strings, rather than leaving the call
+    // ambiguous between the two above.
+    bool contains(const char* element) const;
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const noexcept = 0;
+
+
+    // memoryUsage() returns a breakdown of the memory that the set is
+    // using.  Implementations that don't keep track of this report only
+    // the size of the set object itself.
+    virtual SetMemoryUsage memoryUsage() const;
 };
 
 
 
+template <typename ElementType>
+bool Set<ElementType>::contains(ElementView element) const
+{
+    if constexpr (HAS_ELEMENT_VIEW)
+    {
+        return contains(ElementType{element});
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+template <typename ElementType>
+bool Set<ElementType>::contains(const char* element) const
+{
+    if constexpr (HAS_ELEMENT_VIEW)
+    {
+        return contains(ElementView{element});
+    }
+    else
+    {
+        return contains(ElementType{element});
+    }
+}
+
+
+template <typename ElementType>
+SetMemoryUsage Set<ElementType>::memoryUsage() const
+{
+    SetMemoryUsage usage;
+    usage.objectBytes = sizeof(*this);
+    return usage;
+}
+
+
+
 #endif // SET_HPP
 
@@ -0,0 +1,83 @@
+// SetMemoryUsage.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SetMemoryUsage describes how much memory a Set implementation is
+// using, broken down by what it's being used for, so that the memory
+// cost of each kind of set can be compared alongside its running time.
+// Only the bytes actually asked of the allocator are counted; the
+// allocator's own bookkeeping overhead isn't.
+//
+// elementHeapBytes() returns the memory that an element has allocated
+// for itself beyond its own size -- e.g., the character buffer of a long
+// std::string -- and is used by the sets when counting keyBytes.
+
+#ifndef SETMEMORYUSAGE_HPP
+#define SETMEMORYUSAGE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+
+struct SetMemoryUsage
+{
+    // The size of the set object itself.
+    std::size_t objectBytes = 0;
+
+    // Dynamically-allocated nodes (list nodes, tree nodes, skip list
+    // towers, and so on), including the elements stored inside them.
+    std::size_t nodeBytes = 0;
+
+    // Dynamically-allocated arrays that aren't nodes, such as the bucket
+    // array of a hash table.
+    std::size_t bucketBytes = 0;
+
+    // Memory that the elements have allocated for themselves, such as
+    // the character buffers of long strings.
+    std::size_t keyBytes = 0;
+
+    // For structures with levels (e.g., skip lists), the number of nodes
+    // on each level, starting with level 0; empty otherwise.
+    std::vector<unsigned int> nodesPerLevel;
+
+
+    std::size_t totalBytes() const noexcept
+    {
+        return objectBytes + nodeBytes + bucketBytes + keyBytes;
+    }
+};
+
+
+
+template <typename ElementType>
+std::size_t elementHeapBytes(const ElementType& element) noexcept
+{
+    return 0;
+}
+
+
+inline std::size_t elementHeapBytes(const std::string& element) noexcept
+{
+    // Short strings keep their characters inside the std::string object
+    // (the "small string optimization") and allocate nothing; otherwise,
+    // the buffer holds capacity() characters plus a terminating '\0'.
+    const char* characters = element.data();
+    const char* object = reinterpret_cast<const char*>(&element);
+
+    if (characters >= object && characters < object + sizeof(element))
+    {
+        return 0;
+    }
+    else
+    {
+        return element.capacity() + 1;
+    }
+}
+
+
+
+#endif // SETMEMORYUSAGE_HPP
+
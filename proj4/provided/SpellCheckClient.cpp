@@ -0,0 +1,188 @@
+// SpellCheckClient.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include "SpellCheckClient.hpp"
+
+
+
+SpellCheckClient::ConnectionException::ConnectionException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+std::string SpellCheckClient::ConnectionException::reason() const
+{
+    return reason_;
+}
+
+
+
+namespace
+{
+    constexpr std::size_t RECEIVE_BUFFER_SIZE = 64 * 1024;
+}
+
+
+
+SpellCheckClient::SpellCheckClient(const std::string& socketPath)
+    : descriptor{-1}, buffer{}, position{0}
+{
+#if defined(__linux__)
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (socketPath.empty() || socketPath.length() >= sizeof(address.sun_path))
+    {
+        throw ConnectionException{"Invalid socket path: " + socketPath};
+    }
+
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.length());
+
+    descriptor = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (descriptor < 0)
+    {
+        throw ConnectionException{std::string{"socket: "} + std::strerror(errno)};
+    }
+
+    if (::connect(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        std::string reason = "Cannot connect to " + socketPath + ": " + std::strerror(errno);
+        ::close(descriptor);
+        throw ConnectionException{reason};
+    }
+#else
+    throw ConnectionException{"The spell-check client is only supported on Linux"};
+#endif
+}
+
+
+SpellCheckClient::~SpellCheckClient() noexcept
+{
+#if defined(__linux__)
+    if (descriptor >= 0)
+    {
+        ::close(descriptor);
+    }
+#endif
+}
+
+
+void SpellCheckClient::send(std::string_view requests)
+{
+#if defined(__linux__)
+    while (!requests.empty())
+    {
+        ssize_t bytesSent =
+            ::send(descriptor, requests.data(), requests.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (bytesSent >= 0)
+        {
+            requests.remove_prefix(static_cast<std::size_t>(bytesSent));
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            // The server stops reading from a connection whose responses
+            // aren't being read, so while there's no room to send, any
+            // responses that arrive are read and kept for receive().
+            pollfd events{descriptor, POLLIN | POLLOUT, 0};
+
+            if (::poll(&events, 1, -1) < 0)
+            {
+                if (errno != EINTR)
+                {
+                    throw ConnectionException{
+                        std::string{"Cannot send request: "} + std::strerror(errno)};
+                }
+            }
+            else if ((events.revents & POLLOUT) == 0)
+            {
+                receiveMore();
+            }
+        }
+        else if (errno != EINTR)
+        {
+            throw ConnectionException{std::string{"Cannot send request: "} + std::strerror(errno)};
+        }
+    }
+#else
+    static_cast<void>(requests);
+#endif
+}
+
+
+std::string SpellCheckClient::receive()
+{
+#if defined(__linux__)
+    std::size_t searchFrom = position;
+
+    while (true)
+    {
+        std::size_t newline = buffer.find('\n', searchFrom);
+
+        if (newline != std::string::npos)
+        {
+            std::string response = buffer.substr(position, newline - position);
+            position = newline + 1;
+            return response;
+        }
+
+        // What's already been returned is discarded before the buffer
+        // grows, so it only ever holds about one read's worth (plus
+        // whatever send() read while it was waiting to send).
+        buffer.erase(0, position);
+        position = 0;
+        searchFrom = buffer.size();
+
+        receiveMore();
+    }
+#else
+    return "";
+#endif
+}
+
+
+void SpellCheckClient::receiveMore()
+{
+#if defined(__linux__)
+    char received[RECEIVE_BUFFER_SIZE];
+    ssize_t bytesReceived = ::read(descriptor, received, sizeof(received));
+
+    if (bytesReceived > 0)
+    {
+        buffer.append(received, static_cast<std::size_t>(bytesReceived));
+    }
+    else if (bytesReceived == 0)
+    {
+        throw ConnectionException{"Connection closed by server"};
+    }
+    else if (errno != EINTR)
+    {
+        throw ConnectionException{
+            std::string{"Cannot receive response: "} + std::strerror(errno)};
+    }
+#endif
+}
+
+
+std::string SpellCheckClient::request(std::string_view request)
+{
+    std::string line{request};
+    line += '\n';
+
+    send(line);
+    return receive();
+}
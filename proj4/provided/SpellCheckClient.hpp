@@ -0,0 +1,80 @@
+// SpellCheckClient.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SpellCheckClient is one connection to a SpellCheckServer (see
+// SpellCheckServer.hpp for the requests it understands).  Requests can be
+// sent one at a time with request(), which waits for the response, or
+// several at a time with send(), after which receive() returns each of
+// their responses in turn.
+//
+// Its socket is blocking, so a SpellCheckClient is meant to be used by
+// one thread at a time; a client that wants to keep several requests in
+// flight sends them all before receiving any of their responses.  The
+// server stops reading from a connection whose responses pile up unread,
+// so while send() is waiting for room to send, it reads whatever
+// responses arrive and keeps them for receive(); that way, any number of
+// requests can be sent at once without the two waiting on each other.
+// Any failure to connect, send, or receive throws a ConnectionException.
+
+#ifndef SPELLCHECKCLIENT_HPP
+#define SPELLCHECKCLIENT_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+
+class SpellCheckClient
+{
+public:
+    explicit SpellCheckClient(const std::string& socketPath);
+
+    ~SpellCheckClient() noexcept;
+
+    SpellCheckClient(const SpellCheckClient& c) = delete;
+    SpellCheckClient& operator=(const SpellCheckClient& c) = delete;
+
+    // send() sends one or more requests, each of which has to end in a
+    // newline, reading any responses that arrive in the meantime.
+    void send(std::string_view requests);
+
+    // receive() returns the next response, without its newline.
+    std::string receive();
+
+    // request() sends one request, which doesn't end in a newline, and
+    // returns its response.
+    std::string request(std::string_view request);
+
+
+    class ConnectionException
+    {
+    public:
+        ConnectionException(const std::string& reason);
+
+        std::string reason() const;
+
+    private:
+        std::string reason_;
+    };
+
+
+private:
+    int descriptor;
+
+    // Whatever has been received but not yet returned by receive() is
+    // the part of the buffer from position onward.
+    std::string buffer;
+    std::size_t position;
+
+private:
+    // receiveMore() waits for more of the responses and appends them to
+    // the buffer.
+    void receiveMore();
+};
+
+
+
+#endif // SPELLCHECKCLIENT_HPP
@@ -0,0 +1,567 @@
+// SpellCheckServer.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "SpellCheckServer.hpp"
+
+
+
+SpellCheckServer::ServerException::ServerException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+std::string SpellCheckServer::ServerException::reason() const
+{
+    return reason_;
+}
+
+
+
+namespace
+{
+    // A request longer than this is more likely to be a client that isn't
+    // speaking the protocol than a real batch of words, so its connection
+    // is closed rather than buffered any further.
+    constexpr std::size_t MAX_REQUEST_LENGTH = 1 << 20;
+
+    // A connection stops being read from while it has at least this much
+    // output that it hasn't read.
+    constexpr std::size_t MAX_PENDING_OUTPUT = 1 << 20;
+
+    constexpr std::size_t READ_BUFFER_SIZE = 64 * 1024;
+
+    constexpr unsigned int MAX_EVENTS = 64;
+
+
+    // Splits a request into its words, which are separated by spaces or
+    // tabs, uppercasing each of them.
+    std::vector<std::string> splitWords(std::string_view text)
+    {
+        std::vector<std::string> words;
+        std::size_t position = 0;
+
+        while (position < text.length())
+        {
+            if (text[position] == ' ' || text[position] == '\t')
+            {
+                ++position;
+                continue;
+            }
+
+            std::size_t end = position;
+
+            while (end < text.length() && text[end] != ' ' && text[end] != '\t')
+            {
+                ++end;
+            }
+
+            std::string word{text.substr(position, end - position)};
+
+            for (char& c : word)
+            {
+                if (c >= 'a' && c <= 'z')
+                {
+                    c = static_cast<char>(c - 'a' + 'A');
+                }
+            }
+
+            words.push_back(std::move(word));
+            position = end;
+        }
+
+        return words;
+    }
+
+
+    void appendSuggestionList(std::string& response, const std::vector<std::string>& suggestions)
+    {
+        if (suggestions.empty())
+        {
+            response += '-';
+            return;
+        }
+
+        for (std::size_t i = 0; i < suggestions.size(); ++i)
+        {
+            if (i > 0)
+            {
+                response += ',';
+            }
+
+            response += suggestions[i];
+        }
+    }
+
+
+#if defined(__linux__)
+    std::string systemError(const std::string& operation)
+    {
+        return operation + ": " + std::strerror(errno);
+    }
+#endif
+}
+
+
+
+SpellCheckServer::SpellCheckServer(
+    const WordChecker& wordChecker, const std::string& socketPath, unsigned int cacheCapacity)
+    : wordChecker{wordChecker}, socketPath{socketPath}, cache{cacheCapacity},
+      statistics_{}, listener{-1}, epoll{-1}, stopEvent{-1}, connections{}
+{
+#if defined(__linux__)
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (socketPath.empty() || socketPath.length() >= sizeof(address.sun_path))
+    {
+        throw ServerException{"Invalid socket path: " + socketPath};
+    }
+
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.length());
+
+    // Everything opened so far is closed if any of the rest fails, since
+    // the destructor won't run when the constructor throws.
+    auto fail =
+        [this](const std::string& reason)
+        {
+            for (int descriptor : {listener, epoll, stopEvent})
+            {
+                if (descriptor >= 0)
+                {
+                    ::close(descriptor);
+                }
+            }
+
+            return ServerException{reason};
+        };
+
+    listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (listener < 0)
+    {
+        throw fail(systemError("socket"));
+    }
+
+    ::unlink(socketPath.c_str());
+
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        throw fail(systemError("Cannot bind " + socketPath));
+    }
+
+    if (::listen(listener, SOMAXCONN) != 0)
+    {
+        std::string reason = systemError("Cannot listen on " + socketPath);
+        ::unlink(socketPath.c_str());
+        throw fail(reason);
+    }
+
+    epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    stopEvent = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (epoll < 0 || stopEvent < 0)
+    {
+        std::string reason = systemError(epoll < 0 ? "epoll_create1" : "eventfd");
+        ::unlink(socketPath.c_str());
+        throw fail(reason);
+    }
+
+    for (int descriptor : {listener, stopEvent})
+    {
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = descriptor;
+        ::epoll_ctl(epoll, EPOLL_CTL_ADD, descriptor, &event);
+    }
+#else
+    throw ServerException{"The spell-check server is only supported on Linux"};
+#endif
+}
+
+
+SpellCheckServer::~SpellCheckServer() noexcept
+{
+#if defined(__linux__)
+    for (const auto& [descriptor, connection] : connections)
+    {
+        ::close(descriptor);
+    }
+
+    for (int descriptor : {listener, epoll, stopEvent})
+    {
+        if (descriptor >= 0)
+        {
+            ::close(descriptor);
+        }
+    }
+
+    ::unlink(socketPath.c_str());
+#endif
+}
+
+
+void SpellCheckServer::run()
+{
+#if defined(__linux__)
+    epoll_event events[MAX_EVENTS];
+
+    while (true)
+    {
+        int eventCount = ::epoll_wait(epoll, events, MAX_EVENTS, -1);
+
+        if (eventCount < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw ServerException{systemError("epoll_wait")};
+        }
+
+        bool stopping = false;
+
+        for (int i = 0; i < eventCount; ++i)
+        {
+            int descriptor = events[i].data.fd;
+
+            if (descriptor == stopEvent)
+            {
+                std::uint64_t value;
+                ssize_t ignored = ::read(stopEvent, &value, sizeof(value));
+                static_cast<void>(ignored);
+
+                stopping = true;
+            }
+            else if (descriptor == listener)
+            {
+                acceptConnections();
+            }
+            else
+            {
+                auto found = connections.find(descriptor);
+
+                // An earlier event in the same batch may have closed it.
+                if (found == connections.end())
+                {
+                    continue;
+                }
+
+                Connection& connection = found->second;
+                bool open = true;
+
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                {
+                    open = readRequests(descriptor, connection);
+                }
+
+                if (open && !connection.output.empty())
+                {
+                    open = writeResponses(descriptor, connection);
+                }
+
+                if (open)
+                {
+                    watch(descriptor, connection);
+                }
+                else
+                {
+                    closeConnection(descriptor);
+                }
+            }
+        }
+
+        if (stopping)
+        {
+            return;
+        }
+    }
+#endif
+}
+
+
+void SpellCheckServer::stop() noexcept
+{
+#if defined(__linux__)
+    std::uint64_t value = 1;
+    ssize_t ignored = ::write(stopEvent, &value, sizeof(value));
+    static_cast<void>(ignored);
+#endif
+}
+
+
+std::string SpellCheckServer::respond(std::string_view request)
+{
+    std::size_t commandEnd = request.find(' ');
+    std::string_view command = request.substr(0, commandEnd);
+
+    std::vector<std::string> words =
+        commandEnd == std::string_view::npos
+            ? std::vector<std::string>{}
+            : splitWords(request.substr(commandEnd + 1));
+
+    std::string response;
+
+    if (command == "CHECK")
+    {
+        response.reserve(2 + 2 * words.size());
+        response = "OK";
+
+        for (const std::string& word : words)
+        {
+            response += wordChecker.wordExists(word) ? " 1" : " 0";
+        }
+    }
+    else if (command == "SUGGEST")
+    {
+        response = "OK";
+
+        for (const std::string& word : words)
+        {
+            response += ' ';
+            appendSuggestions(response, word);
+        }
+    }
+    else
+    {
+        return "ERROR Unknown request: " + std::string{command};
+    }
+
+    ++statistics_.requests;
+    statistics_.words += words.size();
+
+    return response;
+}
+
+
+const SpellCheckServer::Statistics& SpellCheckServer::statistics() const noexcept
+{
+    return statistics_;
+}
+
+
+void SpellCheckServer::acceptConnections()
+{
+#if defined(__linux__)
+    while (true)
+    {
+        int descriptor = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        // Anything other than running out of connections to accept (like
+        // the client giving up in the meantime) only affects the one
+        // connection, so the server carries on.
+        if (descriptor < 0)
+        {
+            return;
+        }
+
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = descriptor;
+
+        if (::epoll_ctl(epoll, EPOLL_CTL_ADD, descriptor, &event) != 0)
+        {
+            ::close(descriptor);
+            continue;
+        }
+
+        connections.emplace(descriptor, Connection{"", "", true});
+        ++statistics_.connections;
+    }
+#endif
+}
+
+
+// Reads everything that's arrived on the connection and answers every
+// complete request in it, returning false if the connection should be
+// closed: the client closed its end, or sent a request that's too long.
+bool SpellCheckServer::readRequests(int descriptor, Connection& connection)
+{
+#if defined(__linux__)
+    char buffer[READ_BUFFER_SIZE];
+    bool clientClosed = false;
+
+    while (connection.output.size() < MAX_PENDING_OUTPUT)
+    {
+        ssize_t bytesRead = ::read(descriptor, buffer, sizeof(buffer));
+
+        if (bytesRead > 0)
+        {
+            connection.input.append(buffer, static_cast<std::size_t>(bytesRead));
+        }
+        else if (bytesRead == 0)
+        {
+            clientClosed = true;
+            break;
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+        else
+        {
+            return false;
+        }
+
+        // Requests are answered as each buffer arrives, rather than after
+        // all of them, so that the input only ever holds a partial one.
+        std::size_t lineBegin = 0;
+        std::size_t lineEnd;
+
+        while ((lineEnd = connection.input.find('\n', lineBegin)) != std::string::npos)
+        {
+            std::string_view request{connection.input.data() + lineBegin, lineEnd - lineBegin};
+
+            if (!request.empty() && request.back() == '\r')
+            {
+                request.remove_suffix(1);
+            }
+
+            connection.output += respond(request);
+            connection.output += '\n';
+
+            lineBegin = lineEnd + 1;
+        }
+
+        connection.input.erase(0, lineBegin);
+
+        if (connection.input.size() > MAX_REQUEST_LENGTH)
+        {
+            return false;
+        }
+    }
+
+    // A client that's closed its end may still be reading, so whatever
+    // it's owed is sent before the connection is closed.
+    if (clientClosed)
+    {
+        connection.reading = false;
+        return writeResponses(descriptor, connection);
+    }
+
+    return true;
+#else
+    static_cast<void>(descriptor);
+    static_cast<void>(connection);
+    return false;
+#endif
+}
+
+
+// Writes as much of the connection's output as it will take, returning
+// false if the connection should be closed: the client can't be written
+// to anymore, or it's been sent everything after closing its end.
+bool SpellCheckServer::writeResponses(int descriptor, Connection& connection)
+{
+#if defined(__linux__)
+    std::size_t written = 0;
+
+    while (written < connection.output.size())
+    {
+        ssize_t bytesWritten =
+            ::send(
+                descriptor, connection.output.data() + written,
+                connection.output.size() - written, MSG_NOSIGNAL);
+
+        if (bytesWritten >= 0)
+        {
+            written += static_cast<std::size_t>(bytesWritten);
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    connection.output.erase(0, written);
+
+    return connection.reading || !connection.output.empty();
+#else
+    static_cast<void>(descriptor);
+    static_cast<void>(connection);
+    return false;
+#endif
+}
+
+
+// Watches the connection for whatever it's waiting for: more requests,
+// unless it has too much unread output, and a chance to write whatever
+// output it has.
+void SpellCheckServer::watch(int descriptor, const Connection& connection)
+{
+#if defined(__linux__)
+    epoll_event event;
+    event.events = 0;
+    event.data.fd = descriptor;
+
+    if (connection.reading && connection.output.size() < MAX_PENDING_OUTPUT)
+    {
+        event.events |= EPOLLIN;
+    }
+
+    if (!connection.output.empty())
+    {
+        event.events |= EPOLLOUT;
+    }
+
+    ::epoll_ctl(epoll, EPOLL_CTL_MOD, descriptor, &event);
+#else
+    static_cast<void>(descriptor);
+    static_cast<void>(connection);
+#endif
+}
+
+
+void SpellCheckServer::closeConnection(int descriptor)
+{
+#if defined(__linux__)
+    // Closing the descriptor removes it from the epoll set.
+    ::close(descriptor);
+#endif
+
+    connections.erase(descriptor);
+}
+
+
+void SpellCheckServer::appendSuggestions(std::string& response, const std::string& word)
+{
+    if (const std::vector<std::string>* cached = cache.find(word))
+    {
+        appendSuggestionList(response, *cached);
+    }
+    else
+    {
+        std::vector<std::string> suggestions = wordChecker.findSuggestions(word);
+        appendSuggestionList(response, suggestions);
+        cache.add(word, std::move(suggestions));
+    }
+}
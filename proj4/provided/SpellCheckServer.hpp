@@ -0,0 +1,139 @@
+// SpellCheckServer.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SpellCheckServer answers spelling requests from other processes on
+// the same machine, over a Unix domain socket, so that a set of words can
+// be built once and then searched for as long as the server runs, rather
+// than once per text file the way the shell otherwise does.
+//
+// Requests and responses are lines of text.  Each request is a batch of
+// words, so that checking many words costs one round trip rather than
+// one per word:
+//
+// * "CHECK W1 W2 ..." is answered by "OK" followed by a 1 for each word
+//   that's spelled correctly and a 0 for each that isn't, in order.
+// * "SUGGEST W1 W2 ..." is answered by "OK" followed by the suggestions
+//   for each word, separated by commas, or a "-" if there aren't any.
+//   (A correctly spelled word has suggestions, too, if it's close to
+//   others.)
+// * Anything else is answered by "ERROR" followed by a reason.
+//
+// Words are uppercased before they're looked up, as they are when they're
+// read from a word or text file.  A client can send any number of
+// requests without waiting for their responses, which are sent in the
+// same order.
+//
+// The server runs on one thread, with an epoll loop watching the socket
+// and every connection.  Whenever a connection has data, everything that
+// has arrived is read at once, every complete request in it is answered,
+// and the responses are written together, so that a client that sends
+// many requests at a time is answered with as few system calls as
+// possible.  A connection whose responses aren't being read stops being
+// read from until they are, so that it can't make the server buffer an
+// unlimited amount.  Suggestions are cached in a SuggestionCache, as they
+// are when checking a text file.
+//
+// The server is only supported on Linux; elsewhere, the constructor
+// throws a ServerException.
+
+#ifndef SPELLCHECKSERVER_HPP
+#define SPELLCHECKSERVER_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "SuggestionCache.hpp"
+#include "WordChecker.hpp"
+
+
+
+class SpellCheckServer
+{
+public:
+    struct Statistics
+    {
+        unsigned long connections = 0;
+        unsigned long requests = 0;
+        unsigned long words = 0;
+    };
+
+
+public:
+    // Creates the socket at the given path, replacing any socket that's
+    // already there (left behind by a server that didn't stop cleanly),
+    // and begins listening on it.  The WordChecker is used by reference,
+    // so it has to outlive the server.
+    SpellCheckServer(
+        const WordChecker& wordChecker, const std::string& socketPath,
+        unsigned int cacheCapacity = SuggestionCache::DEFAULT_CAPACITY);
+
+    // Closes every connection and removes the socket.
+    ~SpellCheckServer() noexcept;
+
+    // A SpellCheckServer owns its socket and connections, so it can be
+    // neither copied nor moved.
+    SpellCheckServer(const SpellCheckServer& s) = delete;
+    SpellCheckServer& operator=(const SpellCheckServer& s) = delete;
+
+    // run() serves requests until stop() is called.
+    void run();
+
+    // stop() makes run() return once it's done with the requests it's
+    // already read.  It can be called from any thread, and (since all it
+    // does is write to a file descriptor) from a signal handler.
+    void stop() noexcept;
+
+    // respond() returns the response to one request, without its newline.
+    // It's what run() uses to answer each request, and can be called
+    // directly without any connection.
+    std::string respond(std::string_view request);
+
+    const Statistics& statistics() const noexcept;
+
+
+    class ServerException
+    {
+    public:
+        ServerException(const std::string& reason);
+
+        std::string reason() const;
+
+    private:
+        std::string reason_;
+    };
+
+
+private:
+    struct Connection
+    {
+        std::string input;
+        std::string output;
+        bool reading;
+    };
+
+    const WordChecker& wordChecker;
+    std::string socketPath;
+    SuggestionCache cache;
+    Statistics statistics_;
+
+    int listener;
+    int epoll;
+    int stopEvent;
+
+    std::unordered_map<int, Connection> connections;
+
+private:
+    void acceptConnections();
+    bool readRequests(int descriptor, Connection& connection);
+    bool writeResponses(int descriptor, Connection& connection);
+    void watch(int descriptor, const Connection& connection);
+    void closeConnection(int descriptor);
+
+    void appendSuggestions(std::string& response, const std::string& word);
+};
+
+
+
+#endif // SPELLCHECKSERVER_HPP
@@ -3,23 +3,51 @@
 // ICS 46 Spring 2020
 // Project #4: Set the Controls for the Heart of the Sun
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <thread>
 #include <vector>
 #include "SpellCheckShell.hpp"
 #include "AVLSet.hpp"
+#include "BTreeSet.hpp"
+#include "CpuAffinity.hpp"
 #include "EmptySet.hpp"
+#include "EytzingerSet.hpp"
+#include "FrozenHashSet.hpp"
 #include "HashSet.hpp"
 #include "ListSet.hpp"
+#include "MappedFile.hpp"
+#include "MappedTextFileReader.hpp"
 #include "OutputSpellCheckerListener.hpp"
+#include "PerformanceCounters.hpp"
+#include "RadixTreeSet.hpp"
+#include "RobinHoodHashSet.hpp"
 #include "Set.hpp"
 #include "SkipListSet.hpp"
 #include "SpellChecker.hpp"
+#include "SpellCheckClient.hpp"
+#include "SpellCheckServer.hpp"
 #include "Stopwatch.hpp"
 #include "StringHashing.hpp"
-#include "TextFileReader.hpp"
+#include "SuggestionCache.hpp"
+#include "SuggestionIndex.hpp"
+#include "SyntheticWorkload.hpp"
+#include "TextViewReader.hpp"
+#include "TimingStatistics.hpp"
 #include "WordChecker.hpp"
 #include "WordSetLoader.hpp"
 
@@ -48,35 +76,125 @@ namespace
     }
 
 
-    std::unique_ptr<Set<std::string>> makeWordSet(const std::string& setType)
+    // A WordSetType describes how to build one kind of set from a word
+    // file.  Most kinds of sets are created empty and then have the words
+    // added to them one at a time, but some (like FrozenHashSet) have to
+    // be built all at once from the whole list of words, and some are read
+    // directly from a compiled word file instead of a list of words.
+    // Exactly one of the three functions is non-empty.
+
+    struct WordSetType
+    {
+        std::function<std::unique_ptr<Set<std::string>>()> makeEmpty;
+
+        std::function<std::unique_ptr<Set<std::string>>(
+            const std::vector<std::string>& words)> makeFromWords;
+
+        std::function<std::unique_ptr<Set<std::string>>(
+            const std::string& compiledFilePath)> makeFromCompiledFile;
+    };
+
+
+    template <typename SetType, typename... Args>
+    WordSetType emptyWordSetType(Args... args)
+    {
+        return WordSetType{
+            [=]() { return std::make_unique<SetType>(args...); },
+            nullptr, nullptr};
+    }
+
+
+    std::unique_ptr<Set<std::string>> mapCompiledWordFile(const std::string& compiledFilePath)
+    {
+        try
+        {
+            return std::make_unique<FrozenHashSet>(FrozenHashSet::map(compiledFilePath));
+        }
+        catch (MappedFile::OpenException& e)
+        {
+            throw SpellCheckShell::ShellException{e.reason()};
+        }
+        catch (FrozenHashSet::FileFormatException&)
+        {
+            throw SpellCheckShell::ShellException{
+                "Not a compiled word file: " + compiledFilePath};
+        }
+    }
+
+
+    // Every type of set that makeWordSetType() knows how to make.
+    const std::vector<std::string> SET_TYPES = {
+        "AVL", "BTREE", "EMPTY", "EYTZINGER", "FROZEN", "FROZEN MAPPED",
+        "HASH ZERO", "HASH SUM", "HASH PRODUCT", "LIST", "RADIX TREE",
+        "ROBIN HOOD", "SKIPLIST"
+    };
+
+
+    WordSetType makeWordSetType(const std::string& setType)
     {
         if (setType == "AVL")
         {
-            return std::make_unique<AVLSet<std::string>>();
+            return emptyWordSetType<AVLSet<std::string>>();
+        }
+        else if (setType == "BTREE")
+        {
+            return emptyWordSetType<BTreeSet<std::string>>();
         }
         else if (setType == "EMPTY")
         {
-            return std::make_unique<EmptySet<std::string>>();
+            return emptyWordSetType<EmptySet<std::string>>();
+        }
+        else if (setType == "EYTZINGER")
+        {
+            return WordSetType{
+                nullptr,
+                [](const std::vector<std::string>& words)
+                {
+                    return std::make_unique<EytzingerSet>(words);
+                },
+                nullptr};
+        }
+        else if (setType == "FROZEN")
+        {
+            return WordSetType{
+                nullptr,
+                [](const std::vector<std::string>& words)
+                {
+                    return std::make_unique<FrozenHashSet>(words);
+                },
+                nullptr};
+        }
+        else if (setType == "FROZEN MAPPED")
+        {
+            return WordSetType{nullptr, nullptr, mapCompiledWordFile};
         }
         else if (setType == "HASH ZERO")
         {
-            return std::make_unique<HashSet<std::string>>(hashStringAsZero);
+            return emptyWordSetType<HashSet<std::string>>(hashStringAsZero, hashStringAsZero);
         }
         else if (setType == "HASH SUM")
         {
-            return std::make_unique<HashSet<std::string>>(hashStringAsSum);
+            return emptyWordSetType<HashSet<std::string>>(hashStringAsSum, hashStringAsSum);
         }
         else if (setType == "HASH PRODUCT")
         {
-            return std::make_unique<HashSet<std::string>>(hashStringAsProduct);
+            return emptyWordSetType<HashSet<std::string>>(hashStringAsProduct, hashStringAsProduct);
         }
         else if (setType == "LIST")
         {
-            return std::make_unique<ListSet<std::string>>();
+            return emptyWordSetType<ListSet<std::string>>();
+        }
+        else if (setType == "RADIX TREE")
+        {
+            return emptyWordSetType<RadixTreeSet>();
+        }
+        else if (setType == "ROBIN HOOD")
+        {
+            return emptyWordSetType<RobinHoodHashSet<std::string>>(hashStringAsProduct);
         }
         else if (setType == "SKIPLIST")
         {
-            return std::make_unique<SkipListSet<std::string>>();
+            return emptyWordSetType<SkipListSet<std::string>>();
         }
         else
         {
@@ -84,7 +202,106 @@ namespace
         }
     }
 
-    
+
+    bool isImplemented(const WordSetType& wordSetType)
+    {
+        return !wordSetType.makeEmpty || wordSetType.makeEmpty()->isImplemented();
+    }
+
+
+    // loadWords() loads the list of words from a word file, unless the
+    // given type of set is read directly from a compiled word file, in
+    // which case there's no list of words to load.
+    std::vector<std::string> loadWords(
+        const WordSetType& wordSetType, const std::string& wordFilePath)
+    {
+        if (wordSetType.makeFromCompiledFile)
+        {
+            return std::vector<std::string>{};
+        }
+        else
+        {
+            return WordSetLoader{}.load(wordFilePath);
+        }
+    }
+
+
+    std::unique_ptr<Set<std::string>> buildWordSet(
+        const WordSetType& wordSetType,
+        const std::string& wordFilePath, const std::vector<std::string>& words)
+    {
+        if (wordSetType.makeFromCompiledFile)
+        {
+            return wordSetType.makeFromCompiledFile(wordFilePath);
+        }
+        else if (wordSetType.makeFromWords)
+        {
+            try
+            {
+                return wordSetType.makeFromWords(words);
+            }
+            catch (FrozenHashSet::TooLargeException&)
+            {
+                throw SpellCheckShell::ShellException{"Word file is too large: " + wordFilePath};
+            }
+            catch (EytzingerSet::TooLargeException&)
+            {
+                throw SpellCheckShell::ShellException{"Word file is too large: " + wordFilePath};
+            }
+        }
+        else
+        {
+            std::unique_ptr<Set<std::string>> wordSet = wordSetType.makeEmpty();
+
+            for (const std::string& word : words)
+            {
+                wordSet->add(word);
+            }
+
+            return wordSet;
+        }
+    }
+
+
+    // The SuggestionIndex is built from the same words as the set.  When
+    // the set was mapped from a compiled word file, there are no words to
+    // build it from, so there's no index, and the WordChecker generates
+    // its suggestions instead.
+    std::unique_ptr<SuggestionIndex> buildSuggestionIndex(const std::vector<std::string>& words)
+    {
+        if (words.empty())
+        {
+            return nullptr;
+        }
+        else
+        {
+            try
+            {
+                return std::make_unique<SuggestionIndex>(words);
+            }
+            catch (SuggestionIndex::TooLargeException&)
+            {
+                throw SpellCheckShell::ShellException{
+                    "Too many words to build a suggestion index from"};
+            }
+        }
+    }
+
+
+    WordChecker makeWordChecker(
+        const Set<std::string>& wordSet, const std::unique_ptr<SuggestionIndex>& suggestionIndex)
+    {
+        if (suggestionIndex)
+        {
+            return WordChecker{wordSet, *suggestionIndex};
+        }
+        else
+        {
+            return WordChecker{wordSet};
+        }
+    }
+
+
     void requireNonEmptyFileExists(const std::string& filePath)
     {
         std::ifstream file{filePath};
@@ -112,10 +329,31 @@ namespace
     enum class OutputType
     {
         Display,
-        TimeOnly
+        TimeOnly,
+        Benchmark
     };
 
 
+    // An output type can be preceded by "PARALLEL", in which case the text
+    // file is checked on as many threads as the machine can run at once,
+    // with the same output as when it's checked on one.
+    const std::string PARALLEL_PREFIX = "PARALLEL ";
+
+
+    unsigned int readThreadCount(std::string& outputType)
+    {
+        if (outputType.compare(0, PARALLEL_PREFIX.length(), PARALLEL_PREFIX) == 0)
+        {
+            outputType.erase(0, PARALLEL_PREFIX.length());
+            return std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+
     OutputType makeOutputType(const std::string& outputType)
     {
         if (outputType == "DISPLAY")
@@ -126,6 +364,10 @@ namespace
         {
             return OutputType::TimeOnly;
         }
+        else if (outputType == "BENCHMARK")
+        {
+            return OutputType::Benchmark;
+        }
         else
         {
             throw SpellCheckShell::ShellException{"Invalid output type: " + outputType};
@@ -133,9 +375,31 @@ namespace
     }
 
 
+    // Checks the spelling in the text file on the given number of threads,
+    // or a line at a time with a MappedTextFileReader if it's zero.
+    void checkSpelling(
+        SpellChecker& spellChecker, const WordChecker& wordChecker,
+        const std::string& textFilePath, unsigned int threadCount)
+    {
+        if (threadCount == 0)
+        {
+            MappedTextFileReader reader{textFilePath};
+            spellChecker.run(wordChecker, reader);
+        }
+        else
+        {
+            MappedFile textFile{textFilePath};
+
+            spellChecker.runParallel(
+                wordChecker, std::string_view{textFile.data(), textFile.size()}, threadCount);
+        }
+    }
+
+
     void runWithDisplay(
-        Set<std::string>& wordSet,
-        const std::string& wordFilePath, const std::string& textFilePath)
+        const WordSetType& wordSetType,
+        const std::string& wordFilePath, const std::string& textFilePath,
+        unsigned int threadCount)
     {
         SpellChecker spellChecker;
 
@@ -147,88 +411,357 @@ namespace
         std::cout << std::endl;
         std::cout << "Loading word set from " << wordFilePath << " ..." << std::endl;
 
-        for (const std::string& word : WordSetLoader{}.load(wordFilePath))
-        {
-            wordSet.add(word);
-        }
+        std::vector<std::string> words = loadWords(wordSetType, wordFilePath);
+        std::unique_ptr<Set<std::string>> wordSet = buildWordSet(wordSetType, wordFilePath, words);
+        std::unique_ptr<SuggestionIndex> suggestionIndex = buildSuggestionIndex(words);
 
         std::cout << "Checking spelling in " << textFilePath << " ..." << std::endl;
 
-        WordChecker wordChecker{wordSet};
-        TextFileReader reader{textFilePath};
+        WordChecker wordChecker = makeWordChecker(*wordSet, suggestionIndex);
+        checkSpelling(spellChecker, wordChecker, textFilePath, threadCount);
+    }
+
+
+    void printMemoryRow(const std::string& label, std::size_t bytes, unsigned int elementCount)
+    {
+        std::cout << std::left << std::setw(12) << label;
 
-        spellChecker.run(wordChecker, reader);
+        std::cout << std::right << std::setw(12) << bytes << "bytes";
+
+        std::cout << std::right << std::fixed << std::setprecision(1) << std::setw(15)
+                  << (elementCount > 0 ? static_cast<double>(bytes) / elementCount : 0.0)
+                  << "bytes/element";
+
+        std::cout << std::endl;
     }
 
 
-    void runTimingTest(
-        Set<std::string>& wordSet,
-        const std::string& wordFilePath, const std::string& textFilePath)
+    void printMemoryUsage(const SetMemoryUsage& usage, unsigned int elementCount)
     {
         std::cout << std::endl;
-        std::cout << "Loading words from " << wordFilePath << " ..." << std::endl;
+        std::cout << "MEMORY (" << elementCount << " elements)" << std::endl;
+
+        printMemoryRow("Total", usage.totalBytes(), elementCount);
+        printMemoryRow("Object", usage.objectBytes, elementCount);
+        printMemoryRow("Nodes", usage.nodeBytes, elementCount);
+        printMemoryRow("Buckets", usage.bucketBytes, elementCount);
+        printMemoryRow("Keys", usage.keyBytes, elementCount);
+
+        for (unsigned int level = 0; level < usage.nodesPerLevel.size(); ++level)
+        {
+            std::cout << std::left << std::setw(12) << ("Level " + std::to_string(level))
+                      << std::right << std::setw(12) << usage.nodesPerLevel[level]
+                      << "nodes" << std::endl;
+        }
+    }
+
+
+    // The suggestion cache's statistics are from checking the spelling
+    // using the search structure, not the empty set.
+    void printCacheStatistics(const SuggestionCache::Statistics& statistics)
+    {
+        std::cout << std::endl;
+        std::cout << "SUGGESTION CACHE" << std::endl;
+
+        std::cout << std::left << std::setw(12) << "Hits"
+                  << std::right << std::setw(12) << statistics.hits << std::endl;
+
+        std::cout << std::left << std::setw(12) << "Misses"
+                  << std::right << std::setw(12) << statistics.misses << std::endl;
+
+        std::cout << std::left << std::setw(12) << "Hit Rate"
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(12)
+                  << statistics.hitRate() << "%" << std::endl;
+    }
+
+
+    // RunTimings are the durations of one run of a timing test: building
+    // the set from the words and then checking the spelling with it, and
+    // doing the same with an EmptySet, whose durations are an estimate of
+    // everything but the set.  The suggestion index is built once, in a
+    // phase of its own, and both checks use it, so that the differences
+    // between them are the set's alone.  The hardware events during each
+    // of those phases are counted, too, when that's possible.  The set
+    // that was built, and the suggestion cache's statistics from checking
+    // the spelling with it, are kept, so that they can be reported along
+    // with the durations.
+    struct RunTimings
+    {
+        double wordSetLoad;
+        double suggestionIndexBuild;
+        double wordSetSpellCheck;
+        double emptySetLoad;
+        double emptySetSpellCheck;
+
+        PerformanceCounters::Counts wordSetLoadCounts;
+        PerformanceCounters::Counts suggestionIndexBuildCounts;
+        PerformanceCounters::Counts wordSetSpellCheckCounts;
+        PerformanceCounters::Counts emptySetLoadCounts;
+        PerformanceCounters::Counts emptySetSpellCheckCounts;
+        std::string countersUnavailableReason;
+
+        std::unique_ptr<Set<std::string>> wordSet;
+        SuggestionCache::Statistics cacheStatistics;
+    };
 
-        std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+
+    RunTimings timeRun(
+        const WordSetType& wordSetType,
+        const std::string& wordFilePath, const std::string& textFilePath,
+        const std::vector<std::string>& words, unsigned int threadCount, bool showProgress)
+    {
+        RunTimings timings;
 
         SpellChecker spellChecker;
         Stopwatch stopwatch;
+        PerformanceCounters counters;
 
-        std::cout << "Storing words into search structure ..." << std::endl;
+        timings.countersUnavailableReason = counters.unavailableReason();
+
+        if (showProgress)
+        {
+            std::cout << "Storing words into search structure ..." << std::endl;
+        }
 
         {
             stopwatch.start();
+            counters.start();
+            timings.wordSet = buildWordSet(wordSetType, wordFilePath, words);
+            counters.stop();
+            stopwatch.stop();
+        }
 
-            for (const std::string& word : words)
-            {
-                wordSet.add(word);
-            }
+        timings.wordSetLoad = stopwatch.lastDuration();
+        timings.wordSetLoadCounts = counters.lastCounts();
+
+        if (showProgress)
+        {
+            std::cout << "Building suggestion index ..." << std::endl;
+        }
+
+        std::unique_ptr<SuggestionIndex> suggestionIndex;
 
+        {
+            stopwatch.start();
+            counters.start();
+            suggestionIndex = buildSuggestionIndex(words);
+            counters.stop();
             stopwatch.stop();
         }
 
-        double wordSetLoadDuration = stopwatch.lastDuration();
+        timings.suggestionIndexBuild = stopwatch.lastDuration();
+        timings.suggestionIndexBuildCounts = counters.lastCounts();
 
-        std::cout << "Checking spelling of words in " << textFilePath
-                  << " using search structure ..." << std::endl;
+        if (showProgress)
+        {
+            std::cout << "Checking spelling of words in " << textFilePath
+                      << " using search structure ..." << std::endl;
+        }
 
         {
             stopwatch.start();
-            WordChecker wordChecker{wordSet};
-            TextFileReader reader{textFilePath};
-            spellChecker.run(wordChecker, reader);
+            counters.start();
+            WordChecker wordChecker = makeWordChecker(*timings.wordSet, suggestionIndex);
+            checkSpelling(spellChecker, wordChecker, textFilePath, threadCount);
+            counters.stop();
             stopwatch.stop();
         }
 
-        double wordSetSpellCheckDuration = stopwatch.lastDuration();
+        timings.wordSetSpellCheck = stopwatch.lastDuration();
+        timings.wordSetSpellCheckCounts = counters.lastCounts();
+        timings.cacheStatistics = spellChecker.cacheStatistics();
 
         EmptySet<std::string> emptySet;
-        
-        std::cout << "Storing words into empty set ..." << std::endl;
+
+        if (showProgress)
+        {
+            std::cout << "Storing words into empty set ..." << std::endl;
+        }
+
         {
             stopwatch.start();
+            counters.start();
 
             for (const std::string& word : words)
             {
                 emptySet.add(word);
             }
 
+            counters.stop();
             stopwatch.stop();
         }
 
-        double emptySetLoadDuration = stopwatch.lastDuration();
+        timings.emptySetLoad = stopwatch.lastDuration();
+        timings.emptySetLoadCounts = counters.lastCounts();
 
-        std::cout << "Checking spelling of words in " << textFilePath
-                  << " using empty set ..." << std::endl;
+        if (showProgress)
+        {
+            std::cout << "Checking spelling of words in " << textFilePath
+                      << " using empty set ..." << std::endl;
+        }
 
         {
             stopwatch.start();
-            WordChecker wordChecker{emptySet};
-            TextFileReader reader{textFilePath};
-            spellChecker.run(wordChecker, reader);
+            counters.start();
+            WordChecker wordChecker = makeWordChecker(emptySet, suggestionIndex);
+            checkSpelling(spellChecker, wordChecker, textFilePath, threadCount);
+            counters.stop();
             stopwatch.stop();
         }
 
-        double emptySetSpellCheckDuration = stopwatch.lastDuration();
+        timings.emptySetSpellCheck = stopwatch.lastDuration();
+        timings.emptySetSpellCheckCounts = counters.lastCounts();
+
+        return timings;
+    }
+
+
+    // The counts for the set alone are the differences between the set's
+    // and the EmptySet's, like the durations, and are missing if either
+    // of them is.  Instructions per cycle are shown along with the counts.
+    std::optional<double> countDifference(
+        const std::optional<std::uint64_t>& count, const std::optional<std::uint64_t>& baseline)
+    {
+        if (count && baseline)
+        {
+            return static_cast<double>(*count) - static_cast<double>(*baseline);
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+
+    std::optional<double> optionalCount(const std::optional<std::uint64_t>& count)
+    {
+        if (count)
+        {
+            return static_cast<double>(*count);
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+
+    void printCounterRow(
+        const std::string& label,
+        std::optional<double> cycles, std::optional<double> instructions,
+        std::optional<double> l1DataMisses, std::optional<double> lastLevelCacheMisses,
+        std::optional<double> branchMisses)
+    {
+        std::optional<double> instructionsPerCycle;
+
+        if (cycles && instructions && *cycles > 0)
+        {
+            instructionsPerCycle = *instructions / *cycles;
+        }
+
+        auto printValue =
+            [](const std::optional<double>& value, int precision)
+            {
+                std::cout << std::right << std::setw(14);
+
+                if (value)
+                {
+                    std::cout << std::fixed << std::setprecision(precision) << *value;
+                }
+                else
+                {
+                    std::cout << "-";
+                }
+            };
+
+        std::cout << std::left << std::setw(24) << label;
+
+        printValue(cycles, 0);
+        printValue(instructions, 0);
+        printValue(instructionsPerCycle, 2);
+        printValue(l1DataMisses, 0);
+        printValue(lastLevelCacheMisses, 0);
+        printValue(branchMisses, 0);
+
+        std::cout << std::endl;
+    }
+
+
+    void printCounterRow(const std::string& label, const PerformanceCounters::Counts& counts)
+    {
+        printCounterRow(
+            label,
+            optionalCount(counts.cycles), optionalCount(counts.instructions),
+            optionalCount(counts.l1DataMisses), optionalCount(counts.lastLevelCacheMisses),
+            optionalCount(counts.branchMisses));
+    }
+
+
+    void printCounterRow(
+        const std::string& label,
+        const PerformanceCounters::Counts& counts, const PerformanceCounters::Counts& baseline)
+    {
+        printCounterRow(
+            label,
+            countDifference(counts.cycles, baseline.cycles),
+            countDifference(counts.instructions, baseline.instructions),
+            countDifference(counts.l1DataMisses, baseline.l1DataMisses),
+            countDifference(counts.lastLevelCacheMisses, baseline.lastLevelCacheMisses),
+            countDifference(counts.branchMisses, baseline.branchMisses));
+    }
+
+
+    void printCounters(const RunTimings& timings)
+    {
+        std::cout << std::endl;
+
+        if (!timings.countersUnavailableReason.empty())
+        {
+            std::cout << "Hardware counters unavailable ("
+                      << timings.countersUnavailableReason << ")" << std::endl;
+            return;
+        }
+
+        std::cout << std::left << std::setw(24) << "";
+
+        for (const char* column :
+                 {"Cycles", "Instructions", "IPC", "L1D Misses", "LLC Misses", "Branch Misses"})
+        {
+            std::cout << std::right << std::setw(14) << column;
+        }
+
+        std::cout << std::endl;
+
+        printCounterRow("Everything Load", timings.wordSetLoadCounts);
+        printCounterRow("Index Build", timings.suggestionIndexBuildCounts);
+        printCounterRow("Everything SpellCheck", timings.wordSetSpellCheckCounts);
+        printCounterRow("Empty Set Load", timings.emptySetLoadCounts);
+        printCounterRow("Empty Set SpellCheck", timings.emptySetSpellCheckCounts);
+        printCounterRow("Set Only Load", timings.wordSetLoadCounts, timings.emptySetLoadCounts);
+
+        printCounterRow(
+            "Set Only SpellCheck",
+            timings.wordSetSpellCheckCounts, timings.emptySetSpellCheckCounts);
+    }
+
+
+    void runTimingTest(
+        const WordSetType& wordSetType,
+        const std::string& wordFilePath, const std::string& textFilePath,
+        unsigned int threadCount)
+    {
+        std::cout << std::endl;
+        std::cout << "Loading words from " << wordFilePath << " ..." << std::endl;
+
+        std::vector<std::string> words = loadWords(wordSetType, wordFilePath);
+
+        RunTimings timings =
+            timeRun(wordSetType, wordFilePath, textFilePath, words, threadCount, true);
+
+        double wordSetLoadDuration = timings.wordSetLoad;
+        double wordSetSpellCheckDuration = timings.wordSetSpellCheck;
+        double emptySetLoadDuration = timings.emptySetLoad;
+        double emptySetSpellCheckDuration = timings.emptySetSpellCheck;
 
         std::cout << std::endl;
         std::cout << std::endl;
@@ -275,37 +808,1081 @@ namespace
                      - (emptySetLoadDuration + emptySetSpellCheckDuration) << "usec";
 
         std::cout << std::endl;
-    }
-}
 
+        // The suggestion index is used by both spelling checks, so its
+        // build time is part of neither row above.
+        std::cout << std::endl;
+        std::cout << std::left << std::setw(12) << "Index Build";
 
+        std::cout << std::right << std::fixed << std::setprecision(0) << std::setw(12)
+                  << timings.suggestionIndexBuild << "usec";
 
-void SpellCheckShell::run()
-{
-    std::unique_ptr<Set<std::string>> wordSet = makeWordSet(readString());
+        std::cout << std::endl;
 
-    if (!wordSet->isImplemented())
-    {
-        throw SpellCheckShell::ShellException{
-            "Search structure type not implemented (did you change isImplemented() to return true?)"};
+        printCounters(timings);
+        printCacheStatistics(timings.cacheStatistics);
+        printMemoryUsage(timings.wordSet->memoryUsage(), timings.wordSet->size());
     }
 
-    std::string wordFilePath = readString();
-    requireNonEmptyFileExists(wordFilePath);
 
-    std::string textFilePath = readString();
-    requireNonEmptyFileExists(textFilePath);
+    // A benchmark is a timing test that's run many times over, so that
+    // set types can be compared by statistics of their durations, rather
+    // than by one run of each.  It's configured by four more lines of
+    // input, each of which can be left blank to accept its default: the
+    // number of timed runs (10), the number of untimed warmup runs before
+    // them (1), a CPU to pin the shell to (none), and a file to which the
+    // results are also written as JSON (none).
+    struct BenchmarkOptions
+    {
+        unsigned int runCount = 10;
+        unsigned int warmupRunCount = 1;
+        std::optional<unsigned int> cpu;
+        std::string jsonFilePath;
+    };
 
-    OutputType outputType = makeOutputType(readString());
 
-    switch (outputType)
+    std::optional<unsigned int> readOptionalUnsigned(const std::string& description)
     {
-    case OutputType::Display:
-        runWithDisplay(*wordSet, wordFilePath, textFilePath);
-        break;
+        std::string line = readString();
+
+        if (line.empty())
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            std::size_t length;
+            unsigned long value = std::stoul(line, &length);
+
+            if (length == line.length() && line[0] != '-'
+                && value <= std::numeric_limits<unsigned int>::max())
+            {
+                return static_cast<unsigned int>(value);
+            }
+        }
+        catch (...)
+        {
+        }
+
+        throw SpellCheckShell::ShellException{"Invalid " + description + ": " + line};
+    }
+
+
+    BenchmarkOptions readBenchmarkOptions()
+    {
+        BenchmarkOptions options;
+
+        options.runCount = readOptionalUnsigned("number of runs").value_or(options.runCount);
+
+        if (options.runCount == 0)
+        {
+            throw SpellCheckShell::ShellException{"Invalid number of runs: 0"};
+        }
+
+        options.warmupRunCount =
+            readOptionalUnsigned("number of warmup runs").value_or(options.warmupRunCount);
+
+        options.cpu = readOptionalUnsigned("CPU");
+        options.jsonFilePath = readString();
+
+        return options;
+    }
+
+
+    // Each kind of duration in a benchmark is kept from every timed run.
+    // The "set only" durations are the differences between the set's and
+    // the EmptySet's in each run, rather than the difference between their
+    // statistics afterward.
+    struct BenchmarkDurations
+    {
+        std::vector<double> everythingLoad;
+        std::vector<double> suggestionIndexBuild;
+        std::vector<double> everythingSpellCheck;
+        std::vector<double> emptySetLoad;
+        std::vector<double> emptySetSpellCheck;
+        std::vector<double> setOnlyLoad;
+        std::vector<double> setOnlySpellCheck;
+
+        void add(const RunTimings& timings);
+    };
+
+
+    void BenchmarkDurations::add(const RunTimings& timings)
+    {
+        everythingLoad.push_back(timings.wordSetLoad);
+        suggestionIndexBuild.push_back(timings.suggestionIndexBuild);
+        everythingSpellCheck.push_back(timings.wordSetSpellCheck);
+        emptySetLoad.push_back(timings.emptySetLoad);
+        emptySetSpellCheck.push_back(timings.emptySetSpellCheck);
+        setOnlyLoad.push_back(timings.wordSetLoad - timings.emptySetLoad);
+        setOnlySpellCheck.push_back(timings.wordSetSpellCheck - timings.emptySetSpellCheck);
+    }
+
+
+    void printStatisticsRow(const std::string& label, const std::vector<double>& durations)
+    {
+        TimingStatistics statistics = summarizeTimings(durations);
+
+        std::cout << std::left << std::setw(24) << label;
+
+        for (double value :
+                 {statistics.median, statistics.p95, statistics.standardDeviation,
+                  statistics.mean, statistics.minimum})
+        {
+            std::cout << std::right << std::fixed << std::setprecision(0) << std::setw(12)
+                      << value;
+        }
+
+        std::cout << std::endl;
+    }
+
+
+    void writeJsonString(std::ostream& out, const std::string& s)
+    {
+        out << '"';
+
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                    << static_cast<int>(c) << std::dec << std::setfill(' ');
+            }
+            else
+            {
+                out << c;
+            }
+        }
+
+        out << '"';
+    }
+
+
+    void writeJsonStatistics(
+        std::ostream& out, const std::string& name, const std::vector<double>& durations)
+    {
+        TimingStatistics statistics = summarizeTimings(durations);
+
+        out << "      \"" << name << "\": {"
+            << "\"median\": " << statistics.median
+            << ", \"p95\": " << statistics.p95
+            << ", \"p99\": " << statistics.p99
+            << ", \"stddev\": " << statistics.standardDeviation
+            << ", \"mean\": " << statistics.mean
+            << ", \"min\": " << statistics.minimum
+            << ", \"max\": " << statistics.maximum
+            << ", \"samples\": [";
+
+        for (std::size_t i = 0; i < durations.size(); ++i)
+        {
+            out << (i > 0 ? ", " : "") << durations[i];
+        }
+
+        out << "]}";
+    }
+
+
+    void writeBenchmarkJson(
+        std::ostream& out, const std::string& setType,
+        const std::string& wordFilePath, const std::string& textFilePath,
+        unsigned int threadCount, const BenchmarkOptions& options,
+        const BenchmarkDurations& durations)
+    {
+        out << std::fixed << std::setprecision(3);
+
+        out << "{" << std::endl;
+        out << "  \"setType\": ";
+        writeJsonString(out, setType);
+        out << "," << std::endl;
+        out << "  \"wordFile\": ";
+        writeJsonString(out, wordFilePath);
+        out << "," << std::endl;
+        out << "  \"textFile\": ";
+        writeJsonString(out, textFilePath);
+        out << "," << std::endl;
+        out << "  \"threads\": " << threadCount << "," << std::endl;
+        out << "  \"cpu\": ";
+
+        if (options.cpu)
+        {
+            out << *options.cpu;
+        }
+        else
+        {
+            out << "null";
+        }
+
+        out << "," << std::endl;
+        out << "  \"warmupRuns\": " << options.warmupRunCount << "," << std::endl;
+        out << "  \"runs\": " << options.runCount << "," << std::endl;
+        out << "  \"unit\": \"usec\"," << std::endl;
+        out << "  \"timings\": {" << std::endl;
+
+        auto writePhases =
+            [&](const std::string& name,
+                const std::vector<double>& load, const std::vector<double>& spellCheck)
+            {
+                out << "    \"" << name << "\": {" << std::endl;
+                writeJsonStatistics(out, "load", load);
+                out << "," << std::endl;
+                writeJsonStatistics(out, "spellCheck", spellCheck);
+                out << std::endl;
+                out << "    }," << std::endl;
+            };
+
+        writePhases("everything", durations.everythingLoad, durations.everythingSpellCheck);
+        writePhases("emptySet", durations.emptySetLoad, durations.emptySetSpellCheck);
+        writePhases("setOnly", durations.setOnlyLoad, durations.setOnlySpellCheck);
+
+        out << "    \"suggestionIndex\": {" << std::endl;
+        writeJsonStatistics(out, "build", durations.suggestionIndexBuild);
+        out << std::endl;
+        out << "    }" << std::endl;
+
+        out << "  }" << std::endl;
+        out << "}" << std::endl;
+    }
+
+
+    void runBenchmark(
+        const std::string& setType, const WordSetType& wordSetType,
+        const std::string& wordFilePath, const std::string& textFilePath,
+        unsigned int threadCount, const BenchmarkOptions& options)
+    {
+        if (options.cpu && !pinToCpu(*options.cpu))
+        {
+            throw SpellCheckShell::ShellException{
+                "Cannot pin to CPU: " + std::to_string(*options.cpu)};
+        }
+
+        std::cout << std::endl;
+        std::cout << "Loading words from " << wordFilePath << " ..." << std::endl;
+
+        std::vector<std::string> words = loadWords(wordSetType, wordFilePath);
+
+        std::cout << "Running " << options.warmupRunCount << " warmup and "
+                  << options.runCount << " timed runs";
+
+        if (options.cpu)
+        {
+            std::cout << " on CPU " << *options.cpu;
+        }
+
+        std::cout << " ..." << std::endl;
+
+        for (unsigned int i = 0; i < options.warmupRunCount; ++i)
+        {
+            timeRun(wordSetType, wordFilePath, textFilePath, words, threadCount, false);
+        }
+
+        BenchmarkDurations durations;
+
+        for (unsigned int i = 0; i < options.runCount; ++i)
+        {
+            durations.add(
+                timeRun(wordSetType, wordFilePath, textFilePath, words, threadCount, false));
+        }
+
+        std::cout << std::endl;
+        std::cout << std::endl;
+        std::cout << "RESULTS (usec, " << options.runCount << " runs)" << std::endl;
+
+        std::cout << std::left << std::setw(24) << "";
+
+        for (const char* column : {"Median", "p95", "Stddev", "Mean", "Min"})
+        {
+            std::cout << std::right << std::setw(12) << column;
+        }
+
+        std::cout << std::endl;
+
+        printStatisticsRow("Everything Load", durations.everythingLoad);
+        printStatisticsRow("Everything SpellCheck", durations.everythingSpellCheck);
+        printStatisticsRow("Empty Set Load", durations.emptySetLoad);
+        printStatisticsRow("Empty Set SpellCheck", durations.emptySetSpellCheck);
+        printStatisticsRow("Set Only Load", durations.setOnlyLoad);
+        printStatisticsRow("Set Only SpellCheck", durations.setOnlySpellCheck);
+        printStatisticsRow("Index Build", durations.suggestionIndexBuild);
+
+        if (!options.jsonFilePath.empty())
+        {
+            std::ofstream jsonFile{options.jsonFilePath};
+
+            if (!jsonFile)
+            {
+                throw SpellCheckShell::ShellException{
+                    "Cannot write file: " + options.jsonFilePath};
+            }
+
+            writeBenchmarkJson(
+                jsonFile, setType, wordFilePath, textFilePath, threadCount, options, durations);
+
+            std::cout << std::endl;
+            std::cout << "Wrote results to " << options.jsonFilePath << std::endl;
+        }
+    }
+
+
+    // runWorkloads() adds and looks up synthetic keys (see
+    // SyntheticWorkload.hpp) in each of a list of types of sets, at each of
+    // a list of sizes, so that the way they scale can be compared without
+    // any word or text files.  It's configured by these lines of input,
+    // each of which can be left blank to accept its default:
+    //
+    // * the types of sets, separated by commas (every type)
+    // * the numbers of keys, separated by spaces (1000 up to 10000000)
+    // * the number of lookups at each size (1000000)
+    // * the order in which keys are added: RANDOM, SORTED, or ADVERSARIAL
+    //   (RANDOM)
+    // * the distribution of lookups: UNIFORM or ZIPF (UNIFORM)
+    // * the percentage of lookups that are of keys in the set (50)
+    // * the seed for the random number generator (46)
+    // * a time limit, in seconds (10)
+    //
+    // A type is no longer run once adding and looking up the keys would
+    // take longer than the time limit at the next size, judging by how
+    // its time grew between the last two sizes (and assuming it grows at
+    // least linearly), so that sets that don't scale (like LIST) drop out
+    // before they take forever.  The types that can only
+    // be read from a compiled word file are skipped.
+    std::vector<std::string> readSetTypes()
+    {
+        std::string line = readString();
+
+        if (line.empty())
+        {
+            return SET_TYPES;
+        }
+
+        std::vector<std::string> setTypes;
+        std::istringstream in{line};
+        std::string setType;
+
+        while (std::getline(in, setType, ','))
+        {
+            setType.erase(0, setType.find_first_not_of(' '));
+            setType.erase(setType.find_last_not_of(' ') + 1);
+
+            if (!setType.empty())
+            {
+                makeWordSetType(setType);
+                setTypes.push_back(setType);
+            }
+        }
+
+        return setTypes;
+    }
+
+
+    std::vector<unsigned int> readKeyCounts()
+    {
+        std::string line = readString();
+
+        if (line.empty())
+        {
+            return std::vector<unsigned int>{1000, 10000, 100000, 1000000, 10000000};
+        }
+
+        std::vector<unsigned int> keyCounts;
+        std::istringstream in{line};
+        std::string count;
+
+        while (in >> count)
+        {
+            try
+            {
+                std::size_t length;
+                unsigned long value = std::stoul(count, &length);
+
+                if (length == count.length() && count[0] != '-'
+                    && value <= std::numeric_limits<unsigned int>::max())
+                {
+                    keyCounts.push_back(static_cast<unsigned int>(value));
+                    continue;
+                }
+            }
+            catch (...)
+            {
+            }
+
+            throw SpellCheckShell::ShellException{"Invalid number of keys: " + count};
+        }
+
+        return keyCounts;
+    }
+
+
+    KeyOrder readKeyOrder()
+    {
+        std::string line = readString();
+
+        if (line.empty() || line == "RANDOM")
+        {
+            return KeyOrder::Random;
+        }
+        else if (line == "SORTED")
+        {
+            return KeyOrder::Sorted;
+        }
+        else if (line == "ADVERSARIAL")
+        {
+            return KeyOrder::Adversarial;
+        }
+        else
+        {
+            throw SpellCheckShell::ShellException{"Invalid key order: " + line};
+        }
+    }
+
+
+    LookupDistribution readLookupDistribution()
+    {
+        std::string line = readString();
+
+        if (line.empty() || line == "UNIFORM")
+        {
+            return LookupDistribution::Uniform;
+        }
+        else if (line == "ZIPF")
+        {
+            return LookupDistribution::Zipfian;
+        }
+        else
+        {
+            throw SpellCheckShell::ShellException{"Invalid lookup distribution: " + line};
+        }
+    }
+
+
+    // A RunHistory remembers the durations of a set type's last two runs,
+    // and the numbers of keys they had, from which it estimates how long
+    // a run with more keys will take.
+    class RunHistory
+    {
+    public:
+        void add(unsigned int keyCount, double duration);
+        double estimateDuration(unsigned int keyCount) const;
+
+    private:
+        unsigned int keyCounts[2] = {0, 0};
+        double durations[2] = {0.0, 0.0};
+    };
+
+
+    void RunHistory::add(unsigned int keyCount, double duration)
+    {
+        keyCounts[0] = keyCounts[1];
+        durations[0] = durations[1];
+        keyCounts[1] = std::max(keyCount, 1u);
+        durations[1] = std::max(duration, 1.0);
+    }
+
+
+    double RunHistory::estimateDuration(unsigned int keyCount) const
+    {
+        if (keyCounts[1] == 0 || keyCount <= keyCounts[1])
+        {
+            return 0.0;
+        }
+
+        double exponent = 1.0;
+
+        if (keyCounts[0] > 0 && keyCounts[0] < keyCounts[1])
+        {
+            exponent = std::max(
+                exponent,
+                std::log(durations[1] / durations[0])
+                / std::log(static_cast<double>(keyCounts[1]) / keyCounts[0]));
+        }
+
+        return durations[1] * std::pow(static_cast<double>(keyCount) / keyCounts[1], exponent);
+    }
+
+
+    void runWorkloads()
+    {
+        std::vector<std::string> setTypes = readSetTypes();
+        std::vector<unsigned int> keyCounts = readKeyCounts();
+
+        WorkloadOptions options;
+        options.lookupCount = readOptionalUnsigned("number of lookups").value_or(1000000);
+        options.keyOrder = readKeyOrder();
+        options.lookupDistribution = readLookupDistribution();
+
+        unsigned int hitPercentage = readOptionalUnsigned("hit percentage").value_or(50);
+
+        if (hitPercentage > 100)
+        {
+            throw SpellCheckShell::ShellException{
+                "Invalid hit percentage: " + std::to_string(hitPercentage)};
+        }
+
+        options.hitRatio = hitPercentage / 100.0;
+        options.seed = readOptionalUnsigned("seed").value_or(46);
+
+        double timeLimit = readOptionalUnsigned("time limit").value_or(10) * 1000000.0;
+
+        std::vector<RunHistory> histories(setTypes.size());
+
+        std::cout << std::endl;
+        std::cout << std::left << std::setw(16) << "Type";
+
+        for (const char* column : {"Keys", "Build (usec)", "Lookup (usec)", "ns/lookup", "Hits"})
+        {
+            std::cout << std::right << std::setw(14) << column;
+        }
+
+        std::cout << std::endl;
+
+        for (unsigned int keyCount : keyCounts)
+        {
+            options.keyCount = keyCount;
+            Workload workload = generateWorkload(options);
+
+            for (std::size_t i = 0; i < setTypes.size(); ++i)
+            {
+                WordSetType wordSetType = makeWordSetType(setTypes[i]);
+
+                if (wordSetType.makeFromCompiledFile || !isImplemented(wordSetType))
+                {
+                    continue;
+                }
+
+                if (histories[i].estimateDuration(keyCount) > timeLimit)
+                {
+                    continue;
+                }
+
+                Stopwatch stopwatch;
+
+                stopwatch.start();
+                std::unique_ptr<Set<std::string>> set =
+                    buildWordSet(wordSetType, "", workload.keys);
+                stopwatch.stop();
+
+                double buildDuration = stopwatch.lastDuration();
+                unsigned int hitCount = 0;
+
+                stopwatch.start();
+
+                for (const std::string& key : workload.lookups)
+                {
+                    if (set->contains(key))
+                    {
+                        ++hitCount;
+                    }
+                }
+
+                stopwatch.stop();
+
+                double lookupDuration = stopwatch.lastDuration();
+
+                histories[i].add(keyCount, buildDuration + lookupDuration);
+
+                std::cout << std::left << std::setw(16) << setTypes[i]
+                          << std::right << std::setw(14) << keyCount
+                          << std::fixed << std::setprecision(0)
+                          << std::setw(14) << buildDuration
+                          << std::setw(14) << lookupDuration
+                          << std::setprecision(1) << std::setw(14)
+                          << (workload.lookups.empty()
+                                  ? 0.0 : lookupDuration * 1000.0 / workload.lookups.size())
+                          << std::setw(14) << hitCount;
+
+                // The EMPTY set is only a baseline; every other set should
+                // find exactly the keys that were added.
+                if (hitCount != workload.hitCount && setTypes[i] != "EMPTY")
+                {
+                    std::cout << "  (expected " << workload.hitCount << ")";
+                }
+
+                std::cout << std::endl;
+            }
+        }
+    }
+
+
+    // The server that serveWordSet() is running, if any, so that it can
+    // be stopped when the shell is interrupted or terminated.  It's read
+    // by the signal handler, which may only use atomics that are lock-free.
+    std::atomic<SpellCheckServer*> runningServer{nullptr};
+
+    static_assert(std::atomic<SpellCheckServer*>::is_always_lock_free);
+
+
+    void stopRunningServer(int)
+    {
+        if (SpellCheckServer* server = runningServer.load())
+        {
+            server->stop();
+        }
+    }
+
+
+    // A RunningServerGuard makes the given server the running one, and
+    // has interrupting or terminating the shell stop it, for as long as
+    // the guard exists.  The previous signal handlers are restored when
+    // it's destroyed, however the server stopped, even if run() threw.
+    // The server is made the running one before the handlers are
+    // installed, and stops being the running one only after they're
+    // restored.
+    class RunningServerGuard
+    {
+    public:
+        explicit RunningServerGuard(SpellCheckServer& server);
+        ~RunningServerGuard() noexcept;
+
+        RunningServerGuard(const RunningServerGuard& g) = delete;
+        RunningServerGuard& operator=(const RunningServerGuard& g) = delete;
+
+    private:
+        using SignalHandler = void (*)(int);
+
+        SignalHandler previousInterruptHandler;
+        SignalHandler previousTerminateHandler;
+    };
+
+
+    RunningServerGuard::RunningServerGuard(SpellCheckServer& server)
+    {
+        runningServer.store(&server);
+        previousInterruptHandler = std::signal(SIGINT, stopRunningServer);
+        previousTerminateHandler = std::signal(SIGTERM, stopRunningServer);
+    }
+
+
+    RunningServerGuard::~RunningServerGuard() noexcept
+    {
+        std::signal(SIGINT, previousInterruptHandler);
+        std::signal(SIGTERM, previousTerminateHandler);
+        runningServer.store(nullptr);
+    }
+
+
+    // serveWordSet() builds a set from a word file, as the other output
+    // types do, and then answers spelling requests with it over a Unix
+    // domain socket (see SpellCheckServer.hpp) until the shell is
+    // interrupted or terminated.  It's configured by three lines of
+    // input: the type of set, the word file, and the path of the socket.
+    void serveWordSet()
+    {
+        std::string setType = readString();
+        WordSetType wordSetType = makeWordSetType(setType);
+
+        if (!isImplemented(wordSetType))
+        {
+            throw SpellCheckShell::ShellException{
+                "Search structure type not implemented: " + setType};
+        }
+
+        std::string wordFilePath = readString();
+        requireNonEmptyFileExists(wordFilePath);
+
+        std::string socketPath = readString();
+
+        std::cout << "Loading word set from " << wordFilePath << " ..." << std::endl;
+
+        std::vector<std::string> words = loadWords(wordSetType, wordFilePath);
+        std::unique_ptr<Set<std::string>> wordSet = buildWordSet(wordSetType, wordFilePath, words);
+        std::unique_ptr<SuggestionIndex> suggestionIndex = buildSuggestionIndex(words);
+        WordChecker wordChecker = makeWordChecker(*wordSet, suggestionIndex);
+
+        try
+        {
+            SpellCheckServer server{wordChecker, socketPath};
+
+            std::cout << "Serving " << wordSet->size() << " words on " << socketPath
+                      << " (interrupt to stop) ..." << std::endl;
+
+            {
+                RunningServerGuard guard{server};
+                server.run();
+            }
+
+            const SpellCheckServer::Statistics& statistics = server.statistics();
+
+            std::cout << "Stopped after " << statistics.connections << " connections, "
+                      << statistics.requests << " requests, and "
+                      << statistics.words << " words" << std::endl;
+        }
+        catch (SpellCheckServer::ServerException& e)
+        {
+            throw SpellCheckShell::ShellException{e.reason()};
+        }
+    }
+
+
+    // generateLoad() sends requests to a SpellCheckServer from several
+    // connections at once, each on its own thread, and reports how many
+    // it answered per second and how long it took to answer them.  It's
+    // configured by these lines of input, each of which after the first
+    // two can be left blank to accept its default:
+    //
+    // * the path of the server's socket
+    // * a text file, whose words are checked in the order they appear,
+    //   starting at a different place for each connection
+    // * the number of connections (4)
+    // * the number of requests sent on each connection (10000)
+    // * the number of words in each request (16)
+    // * the number of requests each connection keeps in flight, sending
+    //   another each time one is answered (1)
+    // * the percentage of requests that ask for suggestions rather than
+    //   only checking the words, spread evenly among the rest (0)
+    //
+    // The latency of a request is the time from sending it to receiving
+    // its response, so it includes the time spent waiting behind the
+    // requests in flight ahead of it.
+    struct LoadOptions
+    {
+        unsigned int connectionCount = 4;
+        unsigned int requestCount = 10000;
+        unsigned int wordsPerRequest = 16;
+        unsigned int requestsInFlight = 1;
+        unsigned int suggestPercentage = 0;
+    };
+
+
+    LoadOptions readLoadOptions()
+    {
+        LoadOptions options;
+
+        options.connectionCount =
+            readOptionalUnsigned("number of connections").value_or(options.connectionCount);
+        options.requestCount =
+            readOptionalUnsigned("number of requests").value_or(options.requestCount);
+        options.wordsPerRequest =
+            readOptionalUnsigned("number of words per request").value_or(options.wordsPerRequest);
+        options.requestsInFlight =
+            readOptionalUnsigned("number of requests in flight").value_or(options.requestsInFlight);
+        options.suggestPercentage =
+            readOptionalUnsigned("suggestion percentage").value_or(options.suggestPercentage);
+
+        if (options.connectionCount == 0 || options.wordsPerRequest == 0
+            || options.requestsInFlight == 0 || options.suggestPercentage > 100)
+        {
+            throw SpellCheckShell::ShellException{"Invalid load generator options"};
+        }
+
+        return options;
+    }
+
+
+    std::vector<std::string> readTextWords(const std::string& textFilePath)
+    {
+        MappedFile textFile{textFilePath};
+        TextViewReader reader{std::string_view{textFile.data(), textFile.size()}};
+
+        std::vector<std::string> words;
+
+        while (!reader.noMoreWords())
+        {
+            words.emplace_back(reader.currentWord());
+            reader.advanceToNextWord();
+        }
+
+        return words;
+    }
+
+
+    struct ConnectionLoad
+    {
+        std::vector<double> latencies;
+        unsigned long wordCount = 0;
+        unsigned long errorCount = 0;
+        std::string failure;
+    };
+
+
+    void generateConnectionLoad(
+        SpellCheckClient& client, const std::vector<std::string>& words, std::size_t firstWord,
+        const LoadOptions& options, ConnectionLoad& load)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::deque<Clock::time_point> sendTimes;
+        std::size_t nextWord = firstWord;
+        unsigned int sentCount = 0;
+        std::string requests;
+
+        auto appendRequest =
+            [&]()
+            {
+                // Request i asks for suggestions when the running total of
+                // the percentage crosses a multiple of 100 at it.
+                bool suggest =
+                    sentCount * options.suggestPercentage / 100
+                    != (sentCount + 1) * options.suggestPercentage / 100;
+
+                requests += suggest ? "SUGGEST" : "CHECK";
+
+                for (unsigned int i = 0; i < options.wordsPerRequest; ++i)
+                {
+                    requests += ' ';
+                    requests += words[nextWord];
+                    nextWord = (nextWord + 1) % words.size();
+                }
+
+                requests += '\n';
+                sendTimes.push_back(Clock::now());
+                ++sentCount;
+            };
+
+        try
+        {
+            while (sentCount < std::min(options.requestsInFlight, options.requestCount))
+            {
+                appendRequest();
+            }
+
+            client.send(requests);
+
+            for (unsigned int i = 0; i < options.requestCount; ++i)
+            {
+                std::string response = client.receive();
+
+                load.latencies.push_back(
+                    std::chrono::duration<double, std::micro>(
+                        Clock::now() - sendTimes.front()).count());
+
+                sendTimes.pop_front();
+
+                if (response.compare(0, 2, "OK") != 0)
+                {
+                    ++load.errorCount;
+                }
+
+                if (sentCount < options.requestCount)
+                {
+                    requests.clear();
+                    appendRequest();
+                    client.send(requests);
+                }
+            }
+        }
+        catch (SpellCheckClient::ConnectionException& e)
+        {
+            load.failure = e.reason();
+        }
+
+        load.wordCount =
+            static_cast<unsigned long>(load.latencies.size()) * options.wordsPerRequest;
+    }
+
+
+    void printLoadRow(const std::string& label, double value)
+    {
+        std::cout << std::left << std::setw(24) << label
+                  << std::right << std::fixed << std::setprecision(0) << std::setw(12) << value
+                  << std::endl;
+    }
+
+
+    void generateLoad()
+    {
+        std::string socketPath = readString();
+
+        std::string textFilePath = readString();
+        requireNonEmptyFileExists(textFilePath);
+
+        LoadOptions options = readLoadOptions();
+        std::vector<std::string> words = readTextWords(textFilePath);
+
+        if (words.empty())
+        {
+            throw SpellCheckShell::ShellException{"No words in text file: " + textFilePath};
+        }
+
+        // Every connection is made before any are timed, so that a server
+        // that isn't running is reported as such, rather than as a run
+        // with nothing answered.
+        std::vector<std::unique_ptr<SpellCheckClient>> clients;
+
+        try
+        {
+            for (unsigned int i = 0; i < options.connectionCount; ++i)
+            {
+                clients.push_back(std::make_unique<SpellCheckClient>(socketPath));
+            }
+        }
+        catch (SpellCheckClient::ConnectionException& e)
+        {
+            throw SpellCheckShell::ShellException{e.reason()};
+        }
+
+        std::vector<ConnectionLoad> loads(options.connectionCount);
+        std::vector<std::thread> threads;
+
+        Stopwatch stopwatch;
+        stopwatch.start();
+
+        for (unsigned int i = 0; i < options.connectionCount; ++i)
+        {
+            std::size_t firstWord = words.size() * i / options.connectionCount;
+
+            threads.emplace_back(
+                generateConnectionLoad, std::ref(*clients[i]), std::cref(words), firstWord,
+                std::cref(options), std::ref(loads[i]));
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        stopwatch.stop();
+
+        std::vector<double> latencies;
+        unsigned long wordCount = 0;
+        unsigned long errorCount = 0;
+
+        for (unsigned int i = 0; i < options.connectionCount; ++i)
+        {
+            latencies.insert(latencies.end(), loads[i].latencies.begin(), loads[i].latencies.end());
+            wordCount += loads[i].wordCount;
+            errorCount += loads[i].errorCount;
+
+            if (!loads[i].failure.empty())
+            {
+                std::cout << "Connection " << (i + 1) << " failed: " << loads[i].failure
+                          << std::endl;
+            }
+        }
+
+        double seconds = stopwatch.lastDuration() / 1000000.0;
+
+        std::cout << std::endl;
+        printLoadRow("Connections", options.connectionCount);
+        printLoadRow("Requests", latencies.size());
+        printLoadRow("Words", wordCount);
+        printLoadRow("Errors", errorCount);
+        printLoadRow("Elapsed (usec)", stopwatch.lastDuration());
+        printLoadRow("Requests/sec", seconds > 0.0 ? latencies.size() / seconds : 0.0);
+        printLoadRow("Words/sec", seconds > 0.0 ? wordCount / seconds : 0.0);
+
+        TimingStatistics statistics = summarizeTimings(std::move(latencies));
+
+        std::cout << std::endl;
+        std::cout << std::left << std::setw(24) << "Latency (usec)";
+
+        for (const char* column : {"Median", "95th %", "99th %", "Mean", "Minimum", "Maximum"})
+        {
+            std::cout << std::right << std::setw(12) << column;
+        }
+
+        std::cout << std::endl;
+        std::cout << std::setw(24) << "";
+
+        for (double value :
+                 {statistics.median, statistics.p95, statistics.p99,
+                  statistics.mean, statistics.minimum, statistics.maximum})
+        {
+            std::cout << std::right << std::fixed << std::setprecision(1) << std::setw(12)
+                      << value;
+        }
+
+        std::cout << std::endl;
+    }
+
+
+    // compileWordFile() builds a FrozenHashSet from a word file and saves
+    // it, so that the "FROZEN MAPPED" search structure can later be used
+    // with the compiled file in place of the word file.
+    void compileWordFile()
+    {
+        std::string wordFilePath = readString();
+        requireNonEmptyFileExists(wordFilePath);
+
+        std::string compiledFilePath = readString();
+
+        try
+        {
+            FrozenHashSet wordSet{WordSetLoader{}.load(wordFilePath)};
+            wordSet.save(compiledFilePath);
+
+            std::cout << "Compiled " << wordSet.size() << " words from " << wordFilePath
+                      << " into " << compiledFilePath << std::endl;
+        }
+        catch (FrozenHashSet::TooLargeException&)
+        {
+            throw SpellCheckShell::ShellException{"Word file is too large: " + wordFilePath};
+        }
+        catch (FrozenHashSet::FileFormatException&)
+        {
+            throw SpellCheckShell::ShellException{"Cannot write file: " + compiledFilePath};
+        }
+    }
+}
+
+
+
+void SpellCheckShell::run()
+{
+    std::string setType = readString();
+
+    if (setType == "COMPILE")
+    {
+        compileWordFile();
+        return;
+    }
+    else if (setType == "WORKLOAD")
+    {
+        runWorkloads();
+        return;
+    }
+    else if (setType == "SERVE")
+    {
+        serveWordSet();
+        return;
+    }
+    else if (setType == "LOAD")
+    {
+        generateLoad();
+        return;
+    }
+
+    WordSetType wordSetType = makeWordSetType(setType);
+
+    if (!isImplemented(wordSetType))
+    {
+        throw SpellCheckShell::ShellException{
+            "Search structure type not implemented (did you change isImplemented() to return true?)"};
+    }
+
+    std::string wordFilePath = readString();
+    requireNonEmptyFileExists(wordFilePath);
+
+    std::string textFilePath = readString();
+    requireNonEmptyFileExists(textFilePath);
+
+    std::string outputTypeName = readString();
+    unsigned int threadCount = readThreadCount(outputTypeName);
+    OutputType outputType = makeOutputType(outputTypeName);
+
+    BenchmarkOptions benchmarkOptions;
+
+    if (outputType == OutputType::Benchmark)
+    {
+        benchmarkOptions = readBenchmarkOptions();
+    }
+
+    switch (outputType)
+    {
+    case OutputType::Display:
+        runWithDisplay(wordSetType, wordFilePath, textFilePath, threadCount);
+        break;
 
     case OutputType::TimeOnly:
-        runTimingTest(*wordSet, wordFilePath, textFilePath);
+        runTimingTest(wordSetType, wordFilePath, textFilePath, threadCount);
+        break;
+
+    case OutputType::Benchmark:
+        runBenchmark(
+            setType, wordSetType, wordFilePath, textFilePath, threadCount, benchmarkOptions);
         break;
     }
 }
@@ -3,26 +3,260 @@
 // ICS 46 Spring 2020
 // Project #4: Set the Controls for the Heart of the Sun
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
 #include "SpellChecker.hpp"
+#include "TextViewReader.hpp"
 
 
 
+namespace
+{
+    // Chunks are never smaller than this, so that there are only enough of
+    // them to keep the threads busy.
+    constexpr std::size_t MINIMUM_CHUNK_BYTES = 1024;
+    constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
+
+    struct Misspelling
+    {
+        std::string word;
+        std::string line;
+        std::vector<std::string> suggestions;
+    };
+
+
+    // Calls foundMisspelling(word, line, suggestions) for each misspelled
+    // word that a reader finds.  Each word is checked as the reader gives
+    // it (a view, from the readers that have one), so correctly spelled
+    // words are never copied.  A misspelled word is copied into a string
+    // that's reused throughout, which stops allocating once it's as long
+    // as the longest word, since the cache and findSuggestions() take
+    // std::strings; lines are only copied when there's a misspelling to
+    // report, too.  A word's suggestions are only found the first time
+    // it's misspelled, as long as it's still in the cache when it's
+    // misspelled again.
+    template <typename Reader, typename FoundMisspelling>
+    void forEachMisspelling(
+        const WordChecker& wordChecker, Reader& reader, SuggestionCache& cache,
+        FoundMisspelling foundMisspelling)
+    {
+        std::string word;
+
+        while (!reader.noMoreWords())
+        {
+            auto&& currentWord = reader.currentWord();
+
+            if (!wordChecker.wordExists(currentWord))
+            {
+                word.assign(currentWord);
+                std::string line{reader.currentLine()};
+
+                if (const std::vector<std::string>* cached = cache.find(word))
+                {
+                    foundMisspelling(word, line, *cached);
+                }
+                else
+                {
+                    std::vector<std::string> suggestions = wordChecker.findSuggestions(word);
+                    foundMisspelling(word, line, suggestions);
+                    cache.add(word, std::move(suggestions));
+                }
+            }
+
+            reader.advanceToNextWord();
+        }
+    }
+
+
+    std::vector<Misspelling> findMisspellings(
+        const WordChecker& wordChecker, std::string_view chunk, SuggestionCache& cache)
+    {
+        std::vector<Misspelling> misspellings;
+        TextViewReader reader{chunk};
+
+        forEachMisspelling(
+            wordChecker, reader, cache,
+            [&](const std::string& word, const std::string& line,
+                const std::vector<std::string>& suggestions)
+            {
+                misspellings.push_back(Misspelling{word, line, suggestions});
+            });
+
+        return misspellings;
+    }
+
+
+    // Splits text into chunks of about chunkBytes each, extending each one
+    // through the end of the line it would otherwise end in, so that every
+    // line (and so every word) is entirely within one chunk.
+    std::vector<std::string_view> splitIntoChunks(std::string_view text, std::size_t chunkBytes)
+    {
+        std::vector<std::string_view> chunks;
+        std::size_t begin = 0;
+
+        chunkBytes = std::max<std::size_t>(chunkBytes, 1);
+
+        while (begin < text.size())
+        {
+            std::size_t end = begin + std::min(chunkBytes, text.size() - begin);
+
+            if (end < text.size())
+            {
+                const void* newline =
+                    std::memchr(text.data() + end - 1, '\n', text.size() - end + 1);
+
+                end = newline != nullptr
+                    ? static_cast<const char*>(newline) - text.data() + 1
+                    : text.size();
+            }
+
+            chunks.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+
+        return chunks;
+    }
+}
+
+
+
+SpellChecker::SpellChecker(unsigned int cacheCapacity)
+    : cacheCapacity{cacheCapacity}, cacheStatistics_{}
+{
+}
+
+
+template <typename Reader>
+void SpellChecker::runWith(const WordChecker& wordChecker, Reader& reader)
+{
+    SuggestionCache cache{cacheCapacity};
+
+    forEachMisspelling(
+        wordChecker, reader, cache,
+        [&](const std::string& word, const std::string& line,
+            const std::vector<std::string>& suggestions)
+        {
+            notifyMisspellingFound(word, line, suggestions);
+        });
+
+    cacheStatistics_ = cache.statistics();
+}
+
+
 void SpellChecker::run(const WordChecker& wordChecker, TextFileReader& reader)
 {
-    while (!reader.noMoreWords())
+    runWith(wordChecker, reader);
+}
+
+
+void SpellChecker::run(const WordChecker& wordChecker, MappedTextFileReader& reader)
+{
+    runWith(wordChecker, reader);
+}
+
+
+void SpellChecker::runParallel(
+    const WordChecker& wordChecker, std::string_view text, unsigned int threadCount)
+{
+    std::size_t chunkCount = std::max(threadCount, 1u) * CHUNKS_PER_THREAD;
+
+    runParallel(
+        wordChecker, text, threadCount,
+        std::max(MINIMUM_CHUNK_BYTES, (text.size() + chunkCount - 1) / chunkCount));
+}
+
+
+void SpellChecker::runParallel(
+    const WordChecker& wordChecker, std::string_view text, unsigned int threadCount,
+    std::size_t chunkBytes)
+{
+    std::vector<std::string_view> chunks = splitIntoChunks(text, chunkBytes);
+    std::vector<std::promise<std::vector<Misspelling>>> results(chunks.size());
+
+    std::atomic<std::size_t> nextChunk{0};
+    std::atomic<bool> stopping{false};
+
+    // Each thread has a cache of its own, so that the threads never have
+    // to wait for one another; each one's statistics are added up after
+    // all of the threads are finished.
+    std::vector<std::unique_ptr<SuggestionCache>> caches;
+
+    // An exception thrown while checking a chunk is passed along with its
+    // results, and rethrown when this thread gets to that chunk.
+    auto checkChunks =
+        [&](SuggestionCache& cache)
+        {
+            for (std::size_t i = nextChunk++; i < chunks.size() && !stopping; i = nextChunk++)
+            {
+                try
+                {
+                    results[i].set_value(findMisspellings(wordChecker, chunks[i], cache));
+                }
+                catch (...)
+                {
+                    results[i].set_exception(std::current_exception());
+                }
+            }
+        };
+
+    std::vector<std::thread> threads;
+
+    auto joinThreads =
+        [&]()
+        {
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        };
+
+    try
     {
-        if (!wordChecker.wordExists(reader.currentWord()))
+        for (unsigned int t = 0; t < std::max(threadCount, 1u) && t < chunks.size(); ++t)
         {
-            notifyMisspellingFound(
-                reader.currentWord(), reader.currentLine(),
-                wordChecker.findSuggestions(reader.currentWord()));
+            caches.push_back(std::make_unique<SuggestionCache>(cacheCapacity));
+            threads.emplace_back(checkChunks, std::ref(*caches.back()));
         }
 
-        reader.advanceToNextWord();
+        for (std::promise<std::vector<Misspelling>>& result : results)
+        {
+            for (const Misspelling& misspelling : result.get_future().get())
+            {
+                notifyMisspellingFound(misspelling.word, misspelling.line, misspelling.suggestions);
+            }
+        }
+    }
+    catch (...)
+    {
+        stopping = true;
+        joinThreads();
+        throw;
+    }
+
+    joinThreads();
+
+    cacheStatistics_ = SuggestionCache::Statistics{};
+
+    for (const std::unique_ptr<SuggestionCache>& cache : caches)
+    {
+        cacheStatistics_ += cache->statistics();
     }
 }
 
 
+const SuggestionCache::Statistics& SpellChecker::cacheStatistics() const noexcept
+{
+    return cacheStatistics_;
+}
+
+
 void SpellChecker::notifyMisspellingFound(
     const std::string& word, const std::string& line,
     const std::vector<std::string>& suggestions)
@@ -33,4 +267,3 @@ void SpellChecker::notifyMisspellingFound(
             listener->misspellingFound(word, line, suggestions);
         });
 }
-
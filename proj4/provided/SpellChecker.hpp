@@ -5,14 +5,39 @@
 //
 // This class implements a basic spell checker.  It uses the given
 // WordChecker to determine whether words are spelled correctly,
-// the given TextFileReader to determine which words to check,
-// and notifies any observers whenever misspellings are found.
+// the given TextFileReader (or MappedTextFileReader) to determine which
+// words to check, and notifies any observers whenever misspellings are
+// found.
+//
+// runParallel() checks text that's already in memory (such as a mapped
+// file) on more than one thread.  It splits the text into chunks at line
+// boundaries, and a fixed number of threads check one chunk at a time,
+// taking the next unchecked chunk whenever they finish one, while the
+// calling thread waits for the chunks to be finished in order and notifies
+// the observers of each chunk's misspellings.  So the observers are only
+// ever notified on the calling thread, and in the same order as run()
+// would notify them.  The WordChecker's set has to be safe to search from
+// more than one thread at a time, which every set is, since searching one
+// doesn't change it.
+//
+// Either way, a SuggestionCache remembers the suggestions for recently
+// misspelled words, so that they're only found once no matter how many
+// times a word is misspelled; each run uses a new one (or, in parallel,
+// one per thread), since the suggestions depend on the WordChecker.  The
+// cache's hits and misses from the most recent run can be retrieved
+// afterward.
 
 #ifndef SPELLCHECKER_HPP
 #define SPELLCHECKER_HPP
 
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
 #include <ics46/observable/Observable.hpp>
+#include "MappedTextFileReader.hpp"
 #include "SpellCheckerListener.hpp"
+#include "SuggestionCache.hpp"
 #include "TextFileReader.hpp"
 #include "WordChecker.hpp"
 
@@ -21,9 +46,34 @@
 class SpellChecker : public ics46::observable::Observable<SpellCheckerListener>
 {
 public:
+    // The cache holds the suggestions for up to cacheCapacity words; a
+    // capacity of zero turns it off.
+    explicit SpellChecker(unsigned int cacheCapacity = SuggestionCache::DEFAULT_CAPACITY);
+
     void run(const WordChecker& wordChecker, TextFileReader& reader);
+    void run(const WordChecker& wordChecker, MappedTextFileReader& reader);
+
+    // The first version of runParallel() sizes the chunks so that there
+    // are several for each thread, to even out the differences between
+    // them; the second version uses the given size instead (though every
+    // chunk is extended to the end of the line it ends in).
+    void runParallel(
+        const WordChecker& wordChecker, std::string_view text, unsigned int threadCount);
+
+    void runParallel(
+        const WordChecker& wordChecker, std::string_view text, unsigned int threadCount,
+        std::size_t chunkBytes);
+
+    const SuggestionCache::Statistics& cacheStatistics() const noexcept;
+
+private:
+    unsigned int cacheCapacity;
+    SuggestionCache::Statistics cacheStatistics_;
 
 private:
+    template <typename Reader>
+    void runWith(const WordChecker& wordChecker, Reader& reader);
+
     void notifyMisspellingFound(
         const std::string& word, const std::string& line,
         const std::vector<std::string>& suggestions);
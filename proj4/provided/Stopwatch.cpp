@@ -17,7 +17,7 @@ void Stopwatch::start()
 {
     if (!running)
     {
-        startTime = std::chrono::high_resolution_clock::now();
+        startTime = std::chrono::steady_clock::now();
         running = true;
     }
     else
@@ -31,11 +31,9 @@ void Stopwatch::stop()
 {
     if (running)
     {
-        stopTime = std::chrono::high_resolution_clock::now();
+        stopTime = std::chrono::steady_clock::now();
 
-        duration = 
-            std::chrono::duration_cast<std::chrono::microseconds>(stopTime - startTime)
-            .count();
+        duration = std::chrono::duration<double, std::micro>(stopTime - startTime).count();
 
         running = false;
     }
@@ -5,6 +5,9 @@
 //
 // The Stopwatch class is used to measure CPU time consumption between
 // the time that its start() and stop() member functions are called.
+// Durations are in microseconds, including any fraction of one, and are
+// measured with a steady clock, so that they're never thrown off by the
+// system's clock being adjusted in the meantime.
 
 #ifndef STOPWATCH_HPP
 #define STOPWATCH_HPP
@@ -29,8 +32,8 @@ public:
 
 private:
     bool running;
-    std::chrono::high_resolution_clock::time_point startTime;
-    std::chrono::high_resolution_clock::time_point stopTime;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point stopTime;
     double duration;
 };
 
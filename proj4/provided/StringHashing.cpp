@@ -10,7 +10,7 @@
 // This hash function returns zero for all strings.  As you might imagine,
 // this isn't a very good choice in practice; try it and see what happens.
 
-unsigned int hashStringAsZero(const std::string& word)
+unsigned int hashStringAsZero(std::string_view word)
 {
     return 0;
 }
@@ -20,7 +20,7 @@ unsigned int hashStringAsZero(const std::string& word)
 // character codes of each character in the string.  Consider whether
 // this is a good approach, and compare it to the hash function below.
 
-unsigned int hashStringAsSum(const std::string& word)
+unsigned int hashStringAsSum(std::string_view word)
 {
     unsigned int hash = 0;
 
@@ -37,7 +37,7 @@ unsigned int hashStringAsSum(const std::string& word)
 // includes multiplication by the prime number 37 repeatedly.  Consider
 // why this approach might be better or worse than the one above.
 
-unsigned int hashStringAsProduct(const std::string& word)
+unsigned int hashStringAsProduct(std::string_view word)
 {
     unsigned int hash = 0;
 
@@ -4,17 +4,19 @@
 // Project #4: Set the Controls for the Heart of the Sun
 //
 // A collection of hash functions that are capable of hashing strings.
+// They take std::string_views, so that they can hash a std::string or a
+// view of one alike, with the same result either way.
 
 #ifndef STRINGHASHING_HPP
 #define STRINGHASHING_HPP
 
-#include <string>
+#include <string_view>
 
 
 
-unsigned int hashStringAsZero(const std::string& word);
-unsigned int hashStringAsSum(const std::string& word);
-unsigned int hashStringAsProduct(const std::string& word);
+unsigned int hashStringAsZero(std::string_view word);
+unsigned int hashStringAsSum(std::string_view word);
+unsigned int hashStringAsProduct(std::string_view word);
 
 
 
@@ -0,0 +1,98 @@
+// SuggestionCache.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <utility>
+#include "SuggestionCache.hpp"
+
+
+
+double SuggestionCache::Statistics::hitRate() const noexcept
+{
+    unsigned long lookups = hits + misses;
+    return lookups > 0 ? 100.0 * hits / lookups : 0.0;
+}
+
+
+SuggestionCache::Statistics& SuggestionCache::Statistics::operator+=(
+    const Statistics& s) noexcept
+{
+    hits += s.hits;
+    misses += s.misses;
+    return *this;
+}
+
+
+
+SuggestionCache::SuggestionCache(unsigned int capacity)
+    : capacity{capacity}, entries{}, indexes{}, hand{0}, statistics_{}
+{
+    entries.reserve(capacity);
+    indexes.reserve(capacity);
+}
+
+
+const std::vector<std::string>* SuggestionCache::find(const std::string& word)
+{
+    auto found = indexes.find(word);
+
+    if (found == indexes.end())
+    {
+        ++statistics_.misses;
+        return nullptr;
+    }
+
+    ++statistics_.hits;
+
+    Entry& entry = entries[found->second];
+    entry.referenced = true;
+    return &entry.suggestions;
+}
+
+
+void SuggestionCache::add(const std::string& word, std::vector<std::string> suggestions)
+{
+    if (capacity == 0)
+    {
+        return;
+    }
+
+    if (entries.size() < capacity)
+    {
+        entries.push_back(Entry{word, std::move(suggestions), false});
+        indexes.emplace(entries.back().word, entries.size() - 1);
+        return;
+    }
+
+    // Every word the hand passes over gets a second chance, so it goes
+    // around at most once before finding one to evict.
+    while (entries[hand].referenced)
+    {
+        entries[hand].referenced = false;
+        hand = (hand + 1) % capacity;
+    }
+
+    Entry& entry = entries[hand];
+
+    indexes.erase(entry.word);
+
+    entry.word = word;
+    entry.suggestions = std::move(suggestions);
+    entry.referenced = false;
+
+    indexes.emplace(entry.word, hand);
+    hand = (hand + 1) % capacity;
+}
+
+
+unsigned int SuggestionCache::size() const noexcept
+{
+    return static_cast<unsigned int>(entries.size());
+}
+
+
+const SuggestionCache::Statistics& SuggestionCache::statistics() const noexcept
+{
+    return statistics_;
+}
@@ -0,0 +1,97 @@
+// SuggestionCache.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SuggestionCache remembers the suggestions that were found for the most
+// recently misspelled words, so that a word misspelled many times over
+// (as real documents tend to do) only has its suggestions found once, and
+// after that costs one hash table lookup.
+//
+// It holds at most a fixed number of words, evicting them with the CLOCK
+// algorithm: every word has a "referenced" bit, which is set whenever it's
+// found in the cache, and a "hand" sweeps around the words when one has to
+// be evicted, clearing the bits that are set and evicting the first word
+// whose bit is already clear.  That approximates evicting the least
+// recently used word, without having to reorder anything on a hit.  Words
+// start out with their bits clear, so that a word misspelled only once is
+// evicted before any that have been misspelled again.
+//
+// The suggestions depend on the WordChecker that found them, so a cache
+// must only be used with one WordChecker.  It counts its hits and misses,
+// so that its effectiveness can be measured.
+
+#ifndef SUGGESTIONCACHE_HPP
+#define SUGGESTIONCACHE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+
+class SuggestionCache
+{
+public:
+    static constexpr unsigned int DEFAULT_CAPACITY = 4096;
+
+
+    struct Statistics
+    {
+        unsigned long hits = 0;
+        unsigned long misses = 0;
+
+        // The hits, as a percentage of all lookups (or zero if there
+        // haven't been any).
+        double hitRate() const noexcept;
+
+        Statistics& operator+=(const Statistics& s) noexcept;
+    };
+
+
+public:
+    // A cache with a capacity of zero never holds any words.
+    explicit SuggestionCache(unsigned int capacity = DEFAULT_CAPACITY);
+
+    // Copying would leave the table's keys pointing into the original's
+    // words, so SuggestionCaches can be neither copied nor moved.
+    SuggestionCache(const SuggestionCache& c) = delete;
+    SuggestionCache& operator=(const SuggestionCache& c) = delete;
+
+    // Returns the suggestions cached for the given word, or nullptr if
+    // there aren't any.  The pointer is valid until the next call to add().
+    const std::vector<std::string>* find(const std::string& word);
+
+    // Caches the suggestions for a word that isn't already cached,
+    // evicting another word if the cache is full.
+    void add(const std::string& word, std::vector<std::string> suggestions);
+
+    unsigned int size() const noexcept;
+    const Statistics& statistics() const noexcept;
+
+
+private:
+    struct Entry
+    {
+        std::string word;
+        std::vector<std::string> suggestions;
+        bool referenced;
+    };
+
+    unsigned int capacity;
+
+    // Entries are added until there are capacity of them, and are never
+    // moved after that (only overwritten in place), so the table's keys
+    // can be views of the entries' words.
+    std::vector<Entry> entries;
+    std::unordered_map<std::string_view, std::size_t> indexes;
+    std::size_t hand;
+
+    Statistics statistics_;
+};
+
+
+
+#endif // SUGGESTIONCACHE_HPP
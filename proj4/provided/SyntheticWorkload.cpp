@@ -0,0 +1,256 @@
+// SyntheticWorkload.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <utility>
+#include "SyntheticWorkload.hpp"
+
+
+
+namespace
+{
+    // SplitMix64 (Steele, Lea, and Flood): small, fast, and good enough
+    // for choosing keys, with every step fully specified, so that it
+    // gives the same numbers everywhere.
+    class RandomGenerator
+    {
+    public:
+        explicit RandomGenerator(std::uint64_t seed)
+            : state{seed}
+        {
+        }
+
+
+        std::uint64_t next() noexcept
+        {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+
+        // Returns a number from 0 up to (but not including) the bound,
+        // which must be positive.  The bounds are small enough, compared
+        // to 2^64, that the bias of taking a remainder doesn't matter.
+        std::uint64_t below(std::uint64_t bound) noexcept
+        {
+            return next() % bound;
+        }
+
+
+        // Returns a number from 0.0 up to (but not including) 1.0.
+        double uniform() noexcept
+        {
+            return (next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+
+    private:
+        std::uint64_t state;
+    };
+
+
+
+    constexpr unsigned int MAX_RANDOM_PREFIX_LENGTH = 7;
+    constexpr unsigned int ADVERSARIAL_PREFIX_LENGTH = 32;
+
+
+    // A KeyMaker makes the key for each of a range of indexes.  The part
+    // of a key that's unique to it is its index, scrambled by a random
+    // affine permutation of the numbers with as many base-26 digits as
+    // the largest index, and written in that many letters; a multiplier
+    // that's relatively prime to 26 makes the permutation one-to-one.
+    class KeyMaker
+    {
+    public:
+        KeyMaker(std::uint64_t indexCount, bool sharedPrefix, RandomGenerator& random)
+            : sharedPrefix{sharedPrefix}, width{1}, modulus{26}
+        {
+            while (modulus < indexCount)
+            {
+                ++width;
+                modulus *= 26;
+            }
+
+            multiplier = random.below(std::uint64_t{1} << 23) * 2 + 1;
+
+            if (multiplier % 13 == 0)
+            {
+                multiplier += 2;
+            }
+
+            offset = random.below(modulus);
+        }
+
+
+        std::string make(std::uint64_t index, RandomGenerator& random) const
+        {
+            std::string key;
+
+            if (sharedPrefix)
+            {
+                key.assign(ADVERSARIAL_PREFIX_LENGTH, 'Q');
+            }
+            else
+            {
+                std::uint64_t prefixLength = random.below(MAX_RANDOM_PREFIX_LENGTH + 1);
+
+                for (std::uint64_t i = 0; i < prefixLength; ++i)
+                {
+                    key += static_cast<char>('A' + random.below(26));
+                }
+            }
+
+            // The multiplier is less than 2^24 and the indexes less than
+            // 2^33, so the product can't overflow.
+            std::uint64_t scrambled = (multiplier * index + offset) % modulus;
+
+            std::size_t uniqueStart = key.length();
+            key.resize(uniqueStart + width);
+
+            for (unsigned int i = width; i > 0; --i)
+            {
+                key[uniqueStart + i - 1] = static_cast<char>('A' + scrambled % 26);
+                scrambled /= 26;
+            }
+
+            return key;
+        }
+
+
+    private:
+        bool sharedPrefix;
+        unsigned int width;
+        std::uint64_t modulus;
+        std::uint64_t multiplier;
+        std::uint64_t offset;
+    };
+
+
+
+    // A ZipfianGenerator chooses ranks from 0 up to (but not including)
+    // n, where rank i is chosen in proportion to 1 / (i + 1)^theta.
+    class ZipfianGenerator
+    {
+    public:
+        ZipfianGenerator(std::uint64_t n, double theta)
+            : n{n}, theta{theta}, alpha{1.0 / (1.0 - theta)}, zetaN{zeta(n, theta)},
+              eta{(1.0 - std::pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta(2, theta) / zetaN)}
+        {
+        }
+
+
+        std::uint64_t next(RandomGenerator& random) const
+        {
+            double u = random.uniform();
+            double uz = u * zetaN;
+
+            if (uz < 1.0)
+            {
+                return 0;
+            }
+            else if (uz < 1.0 + std::pow(0.5, theta))
+            {
+                return 1;
+            }
+            else
+            {
+                std::uint64_t rank =
+                    static_cast<std::uint64_t>(n * std::pow(eta * u - eta + 1.0, alpha));
+
+                return std::min(rank, n - 1);
+            }
+        }
+
+
+    private:
+        static double zeta(std::uint64_t n, double theta)
+        {
+            double sum = 0.0;
+
+            for (std::uint64_t i = 1; i <= n; ++i)
+            {
+                sum += 1.0 / std::pow(static_cast<double>(i), theta);
+            }
+
+            return sum;
+        }
+
+
+    private:
+        std::uint64_t n;
+        double theta;
+        double alpha;
+        double zetaN;
+        double eta;
+    };
+}
+
+
+
+Workload generateWorkload(const WorkloadOptions& options)
+{
+    RandomGenerator random{options.seed};
+
+    // The keys that are added have the first keyCount indexes, and the
+    // ones that miss have the next keyCount (or, if no keys are added,
+    // the first one).
+    std::uint64_t keyCount = options.keyCount;
+    std::uint64_t missCount = std::max(keyCount, std::uint64_t{1});
+
+    KeyMaker keyMaker{
+        keyCount + missCount, options.keyOrder == KeyOrder::Adversarial, random};
+
+    Workload workload;
+    workload.keys.reserve(keyCount);
+
+    for (std::uint64_t i = 0; i < keyCount; ++i)
+    {
+        workload.keys.push_back(keyMaker.make(i, random));
+    }
+
+    // The lookups are chosen while the keys are still in index order, in
+    // which the most frequently chosen ones are scattered throughout the
+    // order in which they'll be added.
+    std::optional<ZipfianGenerator> zipfian;
+
+    if (options.lookupDistribution == LookupDistribution::Zipfian && keyCount > 0)
+    {
+        zipfian.emplace(keyCount, options.zipfExponent);
+    }
+
+    workload.lookups.reserve(options.lookupCount);
+
+    for (unsigned int i = 0; i < options.lookupCount; ++i)
+    {
+        if (keyCount > 0 && random.uniform() < options.hitRatio)
+        {
+            std::uint64_t index = zipfian ? zipfian->next(random) : random.below(keyCount);
+            workload.lookups.push_back(workload.keys[index]);
+            ++workload.hitCount;
+        }
+        else
+        {
+            workload.lookups.push_back(keyMaker.make(keyCount + random.below(missCount), random));
+        }
+    }
+
+    if (options.keyOrder == KeyOrder::Random)
+    {
+        for (std::size_t i = workload.keys.size(); i > 1; --i)
+        {
+            std::swap(workload.keys[i - 1], workload.keys[random.below(i)]);
+        }
+    }
+    else
+    {
+        std::sort(workload.keys.begin(), workload.keys.end());
+    }
+
+    return workload;
+}
@@ -0,0 +1,92 @@
+// SyntheticWorkload.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// generateWorkload() makes up a workload for a Set<std::string>: a list
+// of distinct keys to add to it, in a chosen order, and a stream of keys
+// to look up in it afterward, some of which were added and the rest of
+// which weren't.  It needs no word or text files, so sets can be compared
+// at any size, and it's reproducible: the same options (including the
+// seed) always give the same workload, on any platform, since it uses its
+// own random number generator rather than the standard library's
+// distributions, whose results vary from one implementation to another.
+//
+// The keys are strings of uppercase letters, each a random prefix of up
+// to seven letters followed by a fixed number of letters that are unique
+// to it, so that no two are the same.  They can be added
+//
+// * in a random order;
+// * in sorted order, which is the worst case for a binary search tree
+//   without balancing, and a different pattern of work for the others;
+// * in "adversarial" order: sorted, and all beginning with the same long
+//   prefix in place of the random one, so that every comparison has to
+//   look past it before finding a difference.
+//
+// The lookups choose among the added keys either uniformly or with a
+// Zipfian distribution, where a few keys are looked up far more often
+// than the rest, the way common words are in real text.  It's the
+// approximation described by Gray et al. ("Quickly Generating
+// Billion-Record Synthetic Databases," SIGMOD 1994), which takes constant
+// time per lookup after a linear-time setup; its exponent must be between
+// 0 and 1, exclusive.  The keys that are looked up most often are spread
+// throughout the order in which keys are added.  Lookups that miss are
+// drawn from keys generated in the same way that weren't added.
+
+#ifndef SYNTHETICWORKLOAD_HPP
+#define SYNTHETICWORKLOAD_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+enum class KeyOrder
+{
+    Random,
+    Sorted,
+    Adversarial
+};
+
+
+enum class LookupDistribution
+{
+    Uniform,
+    Zipfian
+};
+
+
+struct WorkloadOptions
+{
+    unsigned int keyCount = 1000;
+    unsigned int lookupCount = 1000000;
+    KeyOrder keyOrder = KeyOrder::Random;
+    LookupDistribution lookupDistribution = LookupDistribution::Uniform;
+
+    // The probability of each lookup being of a key that was added.  When
+    // no keys are added, every lookup misses.
+    double hitRatio = 0.5;
+
+    double zipfExponent = 0.99;
+    std::uint64_t seed = 46;
+};
+
+
+struct Workload
+{
+    // The keys, in the order in which they're to be added.
+    std::vector<std::string> keys;
+
+    std::vector<std::string> lookups;
+
+    // The number of lookups that are of keys that were added.
+    unsigned int hitCount = 0;
+};
+
+
+Workload generateWorkload(const WorkloadOptions& options);
+
+
+
+#endif // SYNTHETICWORKLOAD_HPP
@@ -3,8 +3,8 @@
 // ICS 46 Spring 2020
 // Project #4: Set the Controls for the Heart of the Sun
 
-#include <cctype>
 #include "TextFileReader.hpp"
+#include "WordTokenizer.hpp"
 
 
 TextFileReader::TextFileReader(const std::string& textFilePath)
@@ -26,32 +26,16 @@ void TextFileReader::advanceToNextWord()
 
     while (!eof)
     {
-        while (lineIndex < line.length() && !std::isalnum(line[lineIndex]))
-        {
-            ++lineIndex;                
-        }
-
-        if (lineIndex >= line.length())
-        {
-            advanceToNextLine();
-            continue;
-        }
-
-        while (lineIndex < line.length() &&
-            (std::isalnum(line[lineIndex]) || line[lineIndex] == '-' || line[lineIndex] == '\''))
-        {
-            word.push_back(std::toupper(line[lineIndex++]));
-        }
-
-        if (!std::isalnum(word[word.length() - 1]))
-        {
-            word.pop_back();
-        }
+        WordBounds bounds;
 
-        if (word.length() > 0)
+        if (findNextWord(line, lineIndex, bounds))
         {
+            assignUppercaseWord(word, line, bounds);
+            lineIndex = bounds.next;
             return;
         }
+
+        advanceToNextLine();
     }
 }
 
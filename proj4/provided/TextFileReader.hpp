@@ -5,11 +5,12 @@
 //
 // Reads an input file and makes it possible to consume it word by word,
 // with spaces and punctuation skipped (except for hyphens or apostrophes
-// within words).
+// within words).  The rules for what makes a word are in WordTokenizer.hpp.
 
 #ifndef TEXTFILEREADER_HPP
 #define TEXTFILEREADER_HPP
 
+#include <cstddef>
 #include <fstream>
 #include <string>
 
@@ -32,7 +33,7 @@ private:
     bool eof;
 
     std::string line;
-    int lineIndex;
+    std::size_t lineIndex;
 
     std::string word;
 
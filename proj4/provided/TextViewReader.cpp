@@ -0,0 +1,75 @@
+// TextViewReader.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <cstring>
+#include "TextViewReader.hpp"
+#include "WordTokenizer.hpp"
+
+
+
+TextViewReader::TextViewReader(std::string_view text)
+    : text{text}, eof{false},
+      lineBegin{0}, lineEnd{0}, nextLine{0}, position{0}, word{}
+{
+    advanceToNextWord();
+}
+
+
+bool TextViewReader::noMoreWords() const noexcept
+{
+    return eof;
+}
+
+
+void TextViewReader::advanceToNextWord()
+{
+    WordBounds bounds;
+
+    if (eof || !findNextWord(text, position, bounds))
+    {
+        eof = true;
+        lineBegin = text.size();
+        lineEnd = text.size();
+        position = text.size();
+        word.clear();
+        return;
+    }
+
+    // Newlines aren't word characters, so a word never spans lines, and
+    // the line it's on is the first one that ends after it begins.
+    while (bounds.begin >= lineEnd)
+    {
+        advanceToNextLine();
+    }
+
+    assignUppercaseWord(word, text, bounds);
+    position = bounds.next;
+}
+
+
+std::string_view TextViewReader::currentLine() const noexcept
+{
+    return text.substr(lineBegin, lineEnd - lineBegin);
+}
+
+
+std::string_view TextViewReader::currentWord() const noexcept
+{
+    return word;
+}
+
+
+void TextViewReader::advanceToNextLine() noexcept
+{
+    // As with std::getline, the last line counts even if it doesn't end
+    // with a newline.  This is only called when there's a word somewhere
+    // past the current line, so there's always another line to find.
+    const char* newline = static_cast<const char*>(
+        std::memchr(text.data() + nextLine, '\n', text.size() - nextLine));
+
+    lineBegin = nextLine;
+    lineEnd = newline != nullptr ? static_cast<std::size_t>(newline - text.data()) : text.size();
+    nextLine = lineEnd + 1;
+}
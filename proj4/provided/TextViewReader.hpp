@@ -0,0 +1,64 @@
+// TextViewReader.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A TextViewReader consumes text that's already in memory word by word,
+// splitting it into words and lines by exactly the same rules as
+// TextFileReader, but without owning or copying the text:
+//
+// * currentLine() is a view of the current line, pointing directly into
+//   the text, so lines are never copied at all.
+// * currentWord() is a view of the current word, uppercased.  The text
+//   isn't modified, so the word is copied into a buffer that's reused for
+//   every word, so there are no allocations once the buffer is as long as
+//   the longest word.
+//
+// It looks for words across the whole text rather than a line at a time,
+// so that runs of blank lines and punctuation are skipped a block at a
+// time, and only then works out which line the next word is on.
+//
+// The text has to outlive the TextViewReader, and the views are only
+// valid until the next call to advanceToNextWord().
+
+#ifndef TEXTVIEWREADER_HPP
+#define TEXTVIEWREADER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+
+class TextViewReader
+{
+public:
+    explicit TextViewReader(std::string_view text);
+
+    bool noMoreWords() const noexcept;
+    void advanceToNextWord();
+
+    std::string_view currentLine() const noexcept;
+    std::string_view currentWord() const noexcept;
+
+private:
+    std::string_view text;
+    bool eof;
+
+    // The current line is [lineBegin, lineEnd), not including its newline;
+    // the part of the text not yet split into lines begins at nextLine.
+    // Words have been consumed up to position.
+    std::size_t lineBegin;
+    std::size_t lineEnd;
+    std::size_t nextLine;
+    std::size_t position;
+
+    std::string word;
+
+private:
+    void advanceToNextLine() noexcept;
+};
+
+
+
+#endif // TEXTVIEWREADER_HPP
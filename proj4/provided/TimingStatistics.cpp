@@ -0,0 +1,69 @@
+// TimingStatistics.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cmath>
+#include "TimingStatistics.hpp"
+
+
+
+TimingStatistics summarizeTimings(std::vector<double> durations)
+{
+    TimingStatistics statistics;
+
+    if (durations.empty())
+    {
+        return statistics;
+    }
+
+    std::sort(durations.begin(), durations.end());
+
+    std::size_t count = durations.size();
+
+    statistics.count = static_cast<unsigned int>(count);
+    statistics.minimum = durations.front();
+    statistics.maximum = durations.back();
+
+    double sum = 0.0;
+
+    for (double duration : durations)
+    {
+        sum += duration;
+    }
+
+    statistics.mean = sum / count;
+
+    statistics.median =
+        count % 2 == 1
+            ? durations[count / 2]
+            : (durations[count / 2 - 1] + durations[count / 2]) / 2.0;
+
+    // The nearest rank is ceil(0.95 * count), counting from one; it's
+    // worked out in integers so that, e.g., 20 durations give a rank of
+    // exactly 19 rather than whatever 0.95 * 20 rounds up to.
+    auto percentile =
+        [&](std::size_t percent)
+        {
+            std::size_t rank = (percent * count + 99) / 100;
+            return durations[rank - 1];
+        };
+
+    statistics.p95 = percentile(95);
+    statistics.p99 = percentile(99);
+
+    if (count > 1)
+    {
+        double squaredDeviations = 0.0;
+
+        for (double duration : durations)
+        {
+            squaredDeviations += (duration - statistics.mean) * (duration - statistics.mean);
+        }
+
+        statistics.standardDeviation = std::sqrt(squaredDeviations / (count - 1));
+    }
+
+    return statistics;
+}
@@ -0,0 +1,44 @@
+// TimingStatistics.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// TimingStatistics summarizes the durations of repeated runs of the same
+// thing, so that two things can be compared by more than a single run of
+// each, which any noise on the machine can easily throw off.  The median
+// is the usual basis for a comparison, since it's not moved by a few
+// unusually slow runs; the 95th and 99th percentiles and the standard
+// deviation show how much the runs varied.
+//
+// The percentiles are found by the "nearest rank" method: e.g., the 95th
+// is the smallest duration that's at least as long as 95% of them, so
+// it's always one of the durations.  The standard deviation is the sample
+// standard deviation, which is zero when there's only one duration.
+
+#ifndef TIMINGSTATISTICS_HPP
+#define TIMINGSTATISTICS_HPP
+
+#include <vector>
+
+
+
+struct TimingStatistics
+{
+    unsigned int count = 0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+    double mean = 0.0;
+    double median = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double standardDeviation = 0.0;
+};
+
+
+// summarizeTimings() returns the statistics of the given durations, all
+// of which are zero if there aren't any durations.
+TimingStatistics summarizeTimings(std::vector<double> durations);
+
+
+
+#endif // TIMINGSTATISTICS_HPP
@@ -0,0 +1,103 @@
+// WordList.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "WordList.hpp"
+
+
+
+namespace
+{
+    // WordSetLoader uppercased words with std::toupper in the "C" locale,
+    // where only the ASCII letters have uppercase versions.
+    char toUpper(char c) noexcept
+    {
+        return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+}
+
+
+
+WordList::WordList()
+    : characters{}, wordStarts{0}
+{
+}
+
+
+WordList::WordList(std::string characters, std::vector<std::size_t> wordStarts)
+    : characters{std::move(characters)}, wordStarts{std::move(wordStarts)}
+{
+}
+
+
+WordList WordList::parse(std::string text)
+{
+    // Counting the newlines first means that the offsets are allocated
+    // exactly once.  As with std::getline, the last line counts even if
+    // it doesn't end with a newline, but there's no empty line after a
+    // final newline.
+    std::vector<std::size_t> wordStarts;
+    wordStarts.reserve(std::count(text.begin(), text.end(), '\n') + 2);
+
+    std::size_t read = 0;
+    std::size_t write = 0;
+
+    while (read < text.size())
+    {
+        wordStarts.push_back(write);
+
+        const void* newline = std::memchr(text.data() + read, '\n', text.size() - read);
+
+        std::size_t lineEnd = newline != nullptr
+            ? static_cast<const char*>(newline) - text.data()
+            : text.size();
+
+        // Nothing is ever written ahead of where it's read from, so the
+        // line can be moved down as it's normalized.
+        for (; read < lineEnd; ++read)
+        {
+            if (text[read] != '\r')
+            {
+                text[write++] = toUpper(text[read]);
+            }
+        }
+
+        read = lineEnd + 1;
+    }
+
+    wordStarts.push_back(write);
+    text.resize(write);
+
+    return WordList{std::move(text), std::move(wordStarts)};
+}
+
+
+std::size_t WordList::size() const noexcept
+{
+    return wordStarts.size() - 1;
+}
+
+
+std::string_view WordList::operator[](std::size_t index) const noexcept
+{
+    return std::string_view{characters}.substr(
+        wordStarts[index], wordStarts[index + 1] - wordStarts[index]);
+}
+
+
+std::vector<std::string> WordList::toStrings() const
+{
+    std::vector<std::string> words;
+    words.reserve(size());
+
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        words.emplace_back((*this)[i]);
+    }
+
+    return words;
+}
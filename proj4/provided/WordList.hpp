@@ -0,0 +1,55 @@
+// WordList.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A WordList is a list of words stored back-to-back in one string (an
+// "arena"), along with the offset where each word begins, so that however
+// many words there are, they take only two allocations: one for the
+// characters and one for the offsets.  The words are std::string_views
+// into the arena, valid for as long as the WordList is.
+//
+// WordLists are made by parse(), which takes the text of a word file (one
+// word on each line) and turns it into a WordList in place, without
+// copying it: each line is uppercased and has its carriage returns
+// removed, and is moved down to just after the previous one.  The words
+// are exactly the ones WordSetLoader::load() has always returned.
+
+#ifndef WORDLIST_HPP
+#define WORDLIST_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class WordList
+{
+public:
+    // Initializes an empty WordList.
+    WordList();
+
+    static WordList parse(std::string text);
+
+    std::size_t size() const noexcept;
+    std::string_view operator[](std::size_t index) const noexcept;
+
+    // Copies the words into separate std::strings, for the sets and other
+    // structures that are built from a std::vector of them.
+    std::vector<std::string> toStrings() const;
+
+private:
+    // Word i begins at wordStarts[i] and ends where word i + 1 begins;
+    // there's one more start than there are words.
+    std::string characters;
+    std::vector<std::size_t> wordStarts;
+
+private:
+    WordList(std::string characters, std::vector<std::size_t> wordStarts);
+};
+
+
+
+#endif // WORDLIST_HPP
@@ -3,35 +3,43 @@
 // ICS 46 Spring 2020
 // Project #4: Set the Controls for the Heart of the Sun
 
-#include <algorithm>
-#include <cctype>
 #include <fstream>
+#include <utility>
 #include "WordSetLoader.hpp"
 
 
 
-std::vector<std::string> WordSetLoader::load(const std::string& wordFilePath)
+namespace
 {
-    std::ifstream wordFile{wordFilePath};
-    std::vector<std::string> words;
+    constexpr std::size_t READ_CHUNK_SIZE = 64 * 1024;
+}
 
-    std::string word;
 
-    while (std::getline(wordFile, word))
-    {
-        std::transform(
-            word.begin(), word.end(), word.begin(),
-            [](auto c) { return std::toupper(c); });
 
-        word.erase(
-            std::remove_if(
-                word.begin(), word.end(),
-                [](auto c) { return c == '\r' || c == '\n'; }),
-            word.end());
+std::vector<std::string> WordSetLoader::load(const std::string& wordFilePath)
+{
+    return loadWordList(wordFilePath).toStrings();
+}
+
 
-        words.push_back(word);
+WordList WordSetLoader::loadWordList(const std::string& wordFilePath)
+{
+    // A file that can't be opened (or read, like a directory) has no
+    // words in it, as far as the loader is concerned.  The file is read a
+    // chunk at a time until it ends, rather than all at once at the size
+    // it reports, since a pipe doesn't report one and a directory reports
+    // one that means nothing; the string grows geometrically, so a large
+    // file is still only copied a few times.
+    std::ifstream wordFile{wordFilePath, std::ios::binary};
+    std::string text;
+
+    while (wordFile)
+    {
+        std::size_t length = text.size();
+        text.resize(length + READ_CHUNK_SIZE);
+        wordFile.read(text.data() + length, static_cast<std::streamsize>(READ_CHUNK_SIZE));
+        text.resize(length + static_cast<std::size_t>(wordFile.gcount()));
     }
 
-    return words;
+    return WordList::parse(std::move(text));
 }
-
@@ -5,12 +5,20 @@
 //
 // A class that loads a word set from a file containing one word on
 // each line.
+//
+// loadWordList() reads the whole file into one block and turns it into a
+// WordList in place, so it takes only a few allocations no matter how
+// many words there are; load() returns the same words as separate
+// std::strings, for anything that needs them that way.  The file needn't
+// be a regular file; anything that can be read until it ends, such as a
+// named pipe, will do.
 
 #ifndef WORDSETLOADER_HPP
 #define WORDSETLOADER_HPP
 
 #include <string>
 #include <vector>
+#include "WordList.hpp"
 
 
 
@@ -18,9 +26,9 @@ class WordSetLoader
 {
 public:
     std::vector<std::string> load(const std::string& wordFilePath);
+    WordList loadWordList(const std::string& wordFilePath);
 };
 
 
 
 #endif // WORDSETLOADER_HPP
-
@@ -0,0 +1,303 @@
+// WordTokenizer.cpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <cstdint>
+#include <cstring>
+#include "WordTokenizer.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+
+namespace
+{
+    bool isAlphanumeric(char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+    }
+
+
+    bool isWordCharacter(char c) noexcept
+    {
+        return isAlphanumeric(c) || c == '-' || c == '\'';
+    }
+
+
+    char toUpper(char c) noexcept
+    {
+        return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+
+    // Given a word's first character and the first character after it
+    // that isn't a word character, trims a trailing hyphen or apostrophe.
+    void trimWord(std::string_view text, std::size_t begin, std::size_t end, WordBounds& bounds)
+        noexcept
+    {
+        bounds.begin = begin;
+        bounds.end = isAlphanumeric(text[end - 1]) ? end : end - 1;
+        bounds.next = end;
+    }
+
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+    // One bit per byte of a block, set if that byte is a letter or digit,
+    // or a word character, respectively.
+    struct BlockMasks
+    {
+        std::uint32_t alphanumeric;
+        std::uint32_t wordCharacters;
+    };
+
+
+#if defined(__AVX2__)
+
+    constexpr std::size_t BLOCK_SIZE = 32;
+    constexpr std::uint32_t ALL_BYTES = 0xffffffffu;
+
+
+    // Compares as signed bytes, so anything outside of ASCII (which is
+    // negative) is never in range.
+    __m256i inRange(__m256i c, char low, char high) noexcept
+    {
+        return _mm256_and_si256(
+            _mm256_cmpgt_epi8(c, _mm256_set1_epi8(static_cast<char>(low - 1))),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(high + 1)), c));
+    }
+
+
+    BlockMasks classifyBlock(const char* block) noexcept
+    {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+
+        // Setting the 0x20 bit lowercases the uppercase letters without
+        // making anything else a lowercase letter.
+        __m256i letters = inRange(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), 'a', 'z');
+        __m256i alphanumeric = _mm256_or_si256(letters, inRange(c, '0', '9'));
+
+        __m256i wordCharacters = _mm256_or_si256(
+            alphanumeric,
+            _mm256_or_si256(
+                _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-')),
+                _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\''))));
+
+        return BlockMasks{
+            static_cast<std::uint32_t>(_mm256_movemask_epi8(alphanumeric)),
+            static_cast<std::uint32_t>(_mm256_movemask_epi8(wordCharacters))};
+    }
+
+
+    void uppercaseBlock(const char* from, char* to) noexcept
+    {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from));
+        __m256i lowercase = inRange(c, 'a', 'z');
+        c = _mm256_sub_epi8(c, _mm256_and_si256(lowercase, _mm256_set1_epi8(0x20)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(to), c);
+    }
+
+#else
+
+    constexpr std::size_t BLOCK_SIZE = 16;
+    constexpr std::uint32_t ALL_BYTES = 0xffffu;
+
+
+    // Compares as signed bytes, so anything outside of ASCII (which is
+    // negative) is never in range.
+    __m128i inRange(__m128i c, char low, char high) noexcept
+    {
+        return _mm_and_si128(
+            _mm_cmpgt_epi8(c, _mm_set1_epi8(static_cast<char>(low - 1))),
+            _mm_cmplt_epi8(c, _mm_set1_epi8(static_cast<char>(high + 1))));
+    }
+
+
+    BlockMasks classifyBlock(const char* block) noexcept
+    {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+
+        // Setting the 0x20 bit lowercases the uppercase letters without
+        // making anything else a lowercase letter.
+        __m128i letters = inRange(_mm_or_si128(c, _mm_set1_epi8(0x20)), 'a', 'z');
+        __m128i alphanumeric = _mm_or_si128(letters, inRange(c, '0', '9'));
+
+        __m128i wordCharacters = _mm_or_si128(
+            alphanumeric,
+            _mm_or_si128(
+                _mm_cmpeq_epi8(c, _mm_set1_epi8('-')),
+                _mm_cmpeq_epi8(c, _mm_set1_epi8('\''))));
+
+        return BlockMasks{
+            static_cast<std::uint32_t>(_mm_movemask_epi8(alphanumeric)),
+            static_cast<std::uint32_t>(_mm_movemask_epi8(wordCharacters))};
+    }
+
+
+    void uppercaseBlock(const char* from, char* to) noexcept
+    {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+        __m128i lowercase = inRange(c, 'a', 'z');
+        c = _mm_sub_epi8(c, _mm_and_si128(lowercase, _mm_set1_epi8(0x20)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(to), c);
+    }
+
+#endif
+
+
+    unsigned int lowestBit(std::uint32_t mask) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#else
+        unsigned int index = 0;
+
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            ++index;
+        }
+
+        return index;
+#endif
+    }
+
+
+    // Classifies the block of text beginning at position.  Blocks that
+    // would run past the end of the text are copied into a buffer padded
+    // with zeroes -- which are neither letters, digits, nor word characters
+    // -- so nothing past the end is ever read.
+    BlockMasks classifyAt(std::string_view text, std::size_t position) noexcept
+    {
+        std::size_t remaining = text.size() - position;
+
+        if (remaining >= BLOCK_SIZE)
+        {
+            return classifyBlock(text.data() + position);
+        }
+
+        char block[BLOCK_SIZE] = {};
+        std::memcpy(block, text.data() + position, remaining);
+        return classifyBlock(block);
+    }
+
+#endif
+}
+
+
+
+bool findNextWord(std::string_view text, std::size_t position, WordBounds& bounds) noexcept
+{
+#if defined(__AVX2__) || defined(__SSE2__)
+    if (position >= text.size())
+    {
+        return false;
+    }
+
+    std::size_t block = position;
+    BlockMasks masks = classifyAt(text, block);
+
+    while (masks.alphanumeric == 0)
+    {
+        block += BLOCK_SIZE;
+
+        if (block >= text.size())
+        {
+            return false;
+        }
+
+        masks = classifyAt(text, block);
+    }
+
+    // The word may end in the same block it begins in, so only the bits
+    // from its first character onward are considered.
+    unsigned int offset = lowestBit(masks.alphanumeric);
+    std::size_t begin = block + offset;
+    std::uint32_t nonWordCharacters = ~masks.wordCharacters & (ALL_BYTES << offset) & ALL_BYTES;
+
+    while (nonWordCharacters == 0)
+    {
+        block += BLOCK_SIZE;
+        nonWordCharacters = ~classifyAt(text, block).wordCharacters & ALL_BYTES;
+    }
+
+    trimWord(text, begin, block + lowestBit(nonWordCharacters), bounds);
+    return true;
+#else
+    return findNextWordScalar(text, position, bounds);
+#endif
+}
+
+
+bool findNextWordScalar(std::string_view text, std::size_t position, WordBounds& bounds) noexcept
+{
+    while (position < text.size() && !isAlphanumeric(text[position]))
+    {
+        ++position;
+    }
+
+    if (position >= text.size())
+    {
+        return false;
+    }
+
+    std::size_t begin = position;
+
+    while (position < text.size() && isWordCharacter(text[position]))
+    {
+        ++position;
+    }
+
+    trimWord(text, begin, position, bounds);
+    return true;
+}
+
+
+void assignUppercaseWord(std::string& target, std::string_view text, const WordBounds& bounds)
+{
+#if defined(__AVX2__) || defined(__SSE2__)
+    // The target is lengthened to a whole number of blocks, so that every
+    // block can be stored into it whole, then shortened to fit the word.
+    // Blocks are read from the text past the end of the word, as long as
+    // they're still within the text; only a block that would run past its
+    // end is read by way of a buffer instead.
+    std::size_t length = bounds.end - bounds.begin;
+    target.resize((length + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE);
+
+    for (std::size_t i = 0; i < length; i += BLOCK_SIZE)
+    {
+        std::size_t remaining = text.size() - (bounds.begin + i);
+
+        if (remaining >= BLOCK_SIZE)
+        {
+            uppercaseBlock(text.data() + bounds.begin + i, target.data() + i);
+        }
+        else
+        {
+            char block[BLOCK_SIZE] = {};
+            std::memcpy(block, text.data() + bounds.begin + i, remaining);
+            uppercaseBlock(block, target.data() + i);
+        }
+    }
+
+    target.resize(length);
+#else
+    assignUppercaseWordScalar(target, text, bounds);
+#endif
+}
+
+
+void assignUppercaseWordScalar(std::string& target, std::string_view text, const WordBounds& bounds)
+{
+    target.assign(text.substr(bounds.begin, bounds.end - bounds.begin));
+
+    for (char& c : target)
+    {
+        c = toUpper(c);
+    }
+}
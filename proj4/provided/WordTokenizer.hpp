@@ -0,0 +1,58 @@
+// WordTokenizer.hpp
+//
+// ICS 46 Spring 2020
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// These functions split text into the words that the spell checker checks,
+// which TextFileReader and MappedTextFileReader both use, so that they
+// always agree on what a word is:
+//
+// * A word begins with a letter or a digit.
+// * It continues through any letters, digits, hyphens, and apostrophes.
+// * If it ends with a hyphen or an apostrophe, that one character isn't
+//   part of it (but any before it are).
+//
+// Only the ASCII letters and digits count, as with std::isalnum in the
+// "C" locale.
+//
+// findNextWord() and assignUppercaseWord() classify and uppercase
+// characters a block at a time -- 32 bytes with AVX2, 16 with SSE2 -- and
+// never read outside of the text they're given.  The Scalar versions work
+// a character at a time; they're used on machines with neither
+// instruction set, and are available everywhere so that the two can be
+// compared.
+
+#ifndef WORDTOKENIZER_HPP
+#define WORDTOKENIZER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+
+// Where a word was found: it occupies [begin, end), and the search for the
+// next one should start at next, which is past any trimmed character.
+
+struct WordBounds
+{
+    std::size_t begin;
+    std::size_t end;
+    std::size_t next;
+};
+
+
+// Finds the first word in text that begins at or after position, returning
+// true and filling in bounds if there is one, or returning false if not.
+bool findNextWord(std::string_view text, std::size_t position, WordBounds& bounds) noexcept;
+bool findNextWordScalar(std::string_view text, std::size_t position, WordBounds& bounds) noexcept;
+
+
+// Replaces the contents of target with the word in text with the given
+// bounds, uppercased.
+void assignUppercaseWord(std::string& target, std::string_view text, const WordBounds& bounds);
+void assignUppercaseWordScalar(std::string& target, std::string_view text, const WordBounds& bounds);
+
+
+
+#endif // WORDTOKENIZER_HPP